@@ -10,14 +10,22 @@
 #include "examples/common/Log.h"
 
 #include "ADS1115/ADS1115.h"
+#include "ADS1115/Characterize.h"
+#include "ADS1115/JitterStats.h"
+#include "ADS1115/LatestSamples.h"
 
 // ============================================================================
 // Globals
 // ============================================================================
 
 ADS1115::ADS1115 device;
+ADS1115::JitterMonitor<> jitter;
+ADS1115::LatestSamples latest;
 bool verboseMode = false;
 
+static constexpr size_t BURST_MAX = 512;
+int16_t burstBuffer[BURST_MAX];
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
@@ -73,6 +81,66 @@ void printDriverHealth() {
   }
 }
 
+void printEnergy() {
+  ADS1115::EnergyStats stats = device.energyStats();
+  Serial.println("=== Energy Estimate ===");
+  Serial.printf("  Elapsed: %llu us\n", static_cast<unsigned long long>(stats.elapsedUs));
+  Serial.printf("  Converting: %llu us\n", static_cast<unsigned long long>(stats.convertingUs));
+  Serial.printf("  Power-down: %llu us\n", static_cast<unsigned long long>(stats.powerDownUs));
+  Serial.printf("  I2C active: %llu us\n", static_cast<unsigned long long>(stats.i2cUs));
+  Serial.printf("  Conversions: %lu\n", static_cast<unsigned long>(stats.conversions));
+  Serial.printf("  Energy: %.3f uJ\n", stats.energyUj);
+  Serial.printf("  Average current: %.3f uA\n", stats.averageCurrentUa);
+}
+
+const char* muxToStr(ADS1115::Mux mux);
+
+void printJitter() {
+  Serial.println("=== Inter-sample Jitter ===");
+  bool any = false;
+  for (uint8_t i = 0; i < ADS1115::JitterMonitor<>::kChannels; ++i) {
+    ADS1115::Mux mux = static_cast<ADS1115::Mux>(i);
+    ADS1115::JitterSummary js = jitter.summary(mux);
+    if (js.count == 0) {
+      continue;
+    }
+    any = true;
+    Serial.printf("  %-9s n=%lu mean=%.1f us sd=%.1f us min=%lu p99=%lu max=%lu us\n",
+                  muxToStr(mux), static_cast<unsigned long>(js.count), js.meanUs, js.stddevUs,
+                  static_cast<unsigned long>(js.minUs), static_cast<unsigned long>(js.p99Us),
+                  static_cast<unsigned long>(js.maxUs));
+  }
+  if (!any) {
+    Serial.println("  No intervals recorded (need two samples per channel)");
+  }
+}
+
+void printLatest() {
+  Serial.println("=== Latest Samples ===");
+  uint32_t now = micros();
+  bool any = false;
+  for (uint8_t i = 0; i < ADS1115::LatestSamples::kChannels; ++i) {
+    ADS1115::Mux mux = static_cast<ADS1115::Mux>(i);
+    ADS1115::Sample s;
+    if (!latest.read(mux, s)) {
+      continue;
+    }
+    any = true;
+    Serial.printf("  %-9s raw=%6d  %.6f V  seq=%lu  age=%lu us\n", muxToStr(mux), s.raw,
+                  s.volts(), static_cast<unsigned long>(s.seq),
+                  static_cast<unsigned long>(now - s.timestampUs));
+  }
+  if (!any) {
+    Serial.println("  No samples published yet");
+  }
+}
+
+/// Fan the driver's single sample hook out to the CLI consumers
+void onSample(const ADS1115::Sample& sample, void*) {
+  latest.publish(sample);
+  jitter.record(sample);
+}
+
 void printHelp() {
   Serial.println("Commands:");
   Serial.println("  help              - Show this help");
@@ -92,10 +160,15 @@ void printHelp() {
   Serial.println();
   Serial.println("Driver Debugging:");
   Serial.println("  drv               - Show driver state and health");
+  Serial.println("  energy [reset]    - Show (or reset) the energy estimate");
+  Serial.println("  jitter [reset]    - Show (or reset) inter-sample interval stats");
+  Serial.println("  latest            - Show latest published sample per channel");
   Serial.println("  probe             - Probe device (no health tracking)");
   Serial.println("  recover           - Manual recovery attempt");
   Serial.println("  verbose [0|1]     - Enable/disable verbose output");
   Serial.println("  stress [N]        - Run N conversion cycles");
+  Serial.println("  burst [N]         - Capture N samples at 860 SPS (max 512)");
+  Serial.println("  noise [N]         - Noise/ENOB sweep, all gains at 128/860 SPS");
   Serial.println("  config            - Dump config register");
   Serial.println("  scan              - Scan I2C bus");
 }
@@ -172,6 +245,27 @@ const char* modeToStr(ADS1115::Mode mode) {
   }
 }
 
+void runNoiseSweep(uint32_t samples) {
+  static constexpr uint8_t RATE_MASK =
+      (1u << static_cast<uint8_t>(ADS1115::DataRate::SPS_128)) |
+      (1u << static_cast<uint8_t>(ADS1115::DataRate::SPS_860));
+  static ADS1115::NoiseStats table[12];
+  size_t written = 0;
+  auto st = ADS1115::characterizeNoise(device, ADS1115::kAllGains, RATE_MASK, samples,
+                                       table, 12, written);
+  Serial.println("=== Noise (current mux, fixed input) ===");
+  Serial.println("  gain        rate     rms(LSB)  rms(uV)   p-p(uV)   ENOB   NFB");
+  for (size_t i = 0; i < written; ++i) {
+    const ADS1115::NoiseStats& n = table[i];
+    Serial.printf("  %-10s  %-7s  %8.2f  %8.2f  %8.2f  %5.2f  %5.2f\n", gainToStr(n.gain),
+                  rateToStr(n.dataRate), n.rmsCodes, n.rmsUv, n.peakToPeakUv, n.enob,
+                  n.noiseFreeBits);
+  }
+  if (!st.ok()) {
+    printStatus(st);
+  }
+}
+
 bool readConfigFromDevice(uint16_t& config);
 
 bool muxToChannel(ADS1115::Mux mux, int& channel) {
@@ -283,6 +377,18 @@ void processCommand(const String& cmdLine) {
     printStatus(st);
   } else if (cmd == "drv") {
     printDriverHealth();
+  } else if (cmd == "energy") {
+    printEnergy();
+  } else if (cmd == "energy reset") {
+    device.resetEnergyStats();
+    LOGI("Energy estimate reset");
+  } else if (cmd == "latest") {
+    printLatest();
+  } else if (cmd == "jitter") {
+    printJitter();
+  } else if (cmd == "jitter reset") {
+    jitter.reset();
+    LOGI("Jitter statistics reset");
   } else if (cmd == "recover") {
     LOGI("Attempting recovery...");
     auto st = device.recover();
@@ -420,6 +526,55 @@ void processCommand(const String& cmdLine) {
       }
     }
     Serial.printf("  Stress results: %d ok, %d failed\n", ok, fail);
+  } else if (cmd.startsWith("noise")) {
+    int count = 64;
+    if (cmd.length() > 6) {
+      count = cmd.substring(6).toInt();
+    }
+    if (count < 2) {
+      LOGW("Invalid count");
+      return;
+    }
+    runNoiseSweep(static_cast<uint32_t>(count));
+  } else if (cmd.startsWith("burst")) {
+    int count = 64;
+    if (cmd.length() > 6) {
+      count = cmd.substring(6).toInt();
+    }
+    if (count <= 0 || count > static_cast<int>(BURST_MAX)) {
+      LOGW("Invalid count (1-%u)", static_cast<unsigned>(BURST_MAX));
+      return;
+    }
+    ADS1115::BurstStats stats;
+    auto st = device.readBurst(burstBuffer, static_cast<size_t>(count), stats);
+    printStatus(st);
+    int32_t minRaw = INT16_MAX;
+    int32_t maxRaw = INT16_MIN;
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < stats.samples; ++i) {
+      if (burstBuffer[i] < minRaw) {
+        minRaw = burstBuffer[i];
+      }
+      if (burstBuffer[i] > maxRaw) {
+        maxRaw = burstBuffer[i];
+      }
+      sum += burstBuffer[i];
+      LOGV(verboseMode, "  %lu: %d", static_cast<unsigned long>(i), burstBuffer[i]);
+    }
+    Serial.printf("  Samples: %lu  missed: %lu  achieved: %.1f SPS over %lu us\n",
+                  static_cast<unsigned long>(stats.samples),
+                  static_cast<unsigned long>(stats.missed), stats.achievedSps,
+                  static_cast<unsigned long>(stats.elapsedUs));
+    if (stats.synced) {
+      Serial.printf("  Paced by ALERT/RDY, %lu stale pulses ignored\n",
+                    static_cast<unsigned long>(stats.duplicates));
+    } else {
+      Serial.println("  Unsynced: codes may repeat or be skipped (see ALERT/RDY)");
+    }
+    if (stats.samples > 0) {
+      Serial.printf("  Raw min/mean/max: %ld / %.1f / %ld\n", static_cast<long>(minRaw),
+                    static_cast<double>(sum) / stats.samples, static_cast<long>(maxRaw));
+    }
   } else if (cmd == "config") {
     printConfig();
   } else {
@@ -450,9 +605,15 @@ void setup() {
   ADS1115::Config cfg;
   cfg.i2cWrite = transport::wireWrite;
   cfg.i2cWriteRead = transport::wireWriteRead;
+  cfg.i2cRead = transport::wireRead;
   cfg.i2cAddress = 0x48;
   cfg.i2cTimeoutMs = board::I2C_TIMEOUT_MS;
   cfg.offlineThreshold = 5;
+#if ADS1115_ENERGY
+  cfg.power.enabled = true;
+  cfg.power.i2cClockHz = board::I2C_FREQ_HZ;
+#endif
+  cfg.onSample = onSample;
   if (board::ALERT_RDY_PIN >= 0) {
     cfg.alertRdyPin = board::ALERT_RDY_PIN;
     cfg.gpioRead = board::readAlertRdyPin;
@@ -0,0 +1,234 @@
+/// @file main.cpp
+/// @brief ADS1115 dual-core acquisition/processing pipeline example
+/// @note This is an EXAMPLE, not part of the library
+///
+/// Core 1 (Arduino loop) owns the I2C bus and pushes every conversion into
+/// the pipeline ring. A task pinned to core 0 runs the stage chain
+/// (calibration -> IIR filter -> dead band -> packing) in batches. Per-stage cycle counts
+/// are printed once a second so the load on each core can be balanced.
+
+#include <Arduino.h>
+
+#include "examples/common/BoardConfig.h"
+#include "examples/common/I2cTransport.h"
+#include "examples/common/Log.h"
+
+/// 1 = drive the bus through ESP-IDF i2c_master instead of Wire
+#ifndef EXAMPLE_IDF_I2C
+#define EXAMPLE_IDF_I2C 0
+#endif
+
+#if EXAMPLE_IDF_I2C
+#include "examples/common/EspIdfI2cTransport.h"
+#endif
+
+#include "ADS1115/ADS1115.h"
+#include "ADS1115/DeadBand.h"
+#include "ADS1115/Pipeline.h"
+
+// ============================================================================
+// Globals
+// ============================================================================
+
+ADS1115::ADS1115 device;
+ADS1115::Pipeline<256, 4, 32> pipeline;
+#if EXAMPLE_IDF_I2C
+transport::IdfI2cBus i2cBus;
+#endif
+
+static constexpr BaseType_t PROCESSING_CORE = 0;
+static constexpr uint32_t REPORT_INTERVAL_MS = 1000;
+static constexpr uint32_t SAMPLE_PERIOD_US = 1163;  ///< 860 SPS conversion period
+static constexpr float DEAD_BAND_VOLTS = 0.002f;
+static constexpr uint32_t HEARTBEAT_US = 5000000;
+
+// ============================================================================
+// Stages (run on the processing core)
+// ============================================================================
+
+/// Two-point calibration applied to the raw code
+struct Calibration {
+  int16_t offset = 0;      ///< Code read with shorted inputs
+  float gain = 1.0f;       ///< Reference / measured scale
+};
+
+size_t calibrateStage(ADS1115::Sample* samples, size_t count, void* ctx) {
+  const Calibration* cal = static_cast<const Calibration*>(ctx);
+  for (size_t i = 0; i < count; ++i) {
+    float corrected = (samples[i].raw - cal->offset) * cal->gain;
+    if (corrected > 32767.0f) {
+      corrected = 32767.0f;
+    } else if (corrected < -32768.0f) {
+      corrected = -32768.0f;
+    }
+    samples[i].raw = static_cast<int16_t>(corrected);
+  }
+  return count;
+}
+
+/// First-order IIR low-pass (alpha = 1 / 2^shift)
+struct IirFilter {
+  uint8_t shift = 3;
+  int32_t state = 0;
+  bool primed = false;
+};
+
+size_t filterStage(ADS1115::Sample* samples, size_t count, void* ctx) {
+  IirFilter* f = static_cast<IirFilter*>(ctx);
+  for (size_t i = 0; i < count; ++i) {
+    int32_t x = static_cast<int32_t>(samples[i].raw) << 8;
+    if (!f->primed) {
+      f->state = x;
+      f->primed = true;
+    }
+    f->state += (x - f->state) >> f->shift;
+    samples[i].raw = static_cast<int16_t>(f->state >> 8);
+  }
+  return count;
+}
+
+/// Packs filtered codes into fixed-size telemetry frames
+struct Packer {
+  static constexpr size_t FRAME_SAMPLES = 16;
+  int16_t frame[FRAME_SAMPLES] = {};
+  size_t fill = 0;
+  uint32_t frames = 0;
+  uint32_t firstSeq = 0;
+};
+
+size_t packStage(ADS1115::Sample* samples, size_t count, void* ctx) {
+  Packer* p = static_cast<Packer*>(ctx);
+  for (size_t i = 0; i < count; ++i) {
+    if (p->fill == 0) {
+      p->firstSeq = samples[i].seq;
+    }
+    p->frame[p->fill++] = samples[i].raw;
+    if (p->fill == Packer::FRAME_SAMPLES) {
+      // A real application would hand the frame to a radio / USB queue here
+      p->frames++;
+      p->fill = 0;
+    }
+  }
+  return count;
+}
+
+Calibration calibration;
+IirFilter filter;
+ADS1115::DeadBand deadBand;
+Packer packer;
+
+uint32_t cycleCount() {
+  return ESP.getCycleCount();
+}
+
+void processingTask(void*) {
+  for (;;) {
+    if (pipeline.process() == 0) {
+      vTaskDelay(1);
+    }
+  }
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+void printPipelineStats() {
+  Serial.printf("processed=%lu dropped=%lu gaps=%lu backlog=%u frames=%lu\n",
+                static_cast<unsigned long>(pipeline.processed()),
+                static_cast<unsigned long>(pipeline.dropped()),
+                static_cast<unsigned long>(pipeline.gaps()),
+                static_cast<unsigned>(pipeline.backlog()),
+                static_cast<unsigned long>(packer.frames));
+  ADS1115::DeadBandStats db = deadBand.stats(ADS1115::Mux::AIN0_GND);
+  Serial.printf("  dead band: reported=%lu suppressed=%lu heartbeats=%lu\n",
+                static_cast<unsigned long>(db.reported),
+                static_cast<unsigned long>(db.suppressed),
+                static_cast<unsigned long>(db.heartbeats));
+  for (size_t i = 0; i < pipeline.stageCount(); ++i) {
+    ADS1115::StageStats st = pipeline.stageStats(i);
+    float perSample = st.samples ? static_cast<float>(st.cycles) / st.samples : 0.0f;
+    Serial.printf("  %-10s calls=%lu samples=%lu cycles/sample=%.1f max=%lu\n",
+                  pipeline.stageName(i), static_cast<unsigned long>(st.calls),
+                  static_cast<unsigned long>(st.samples), perSample,
+                  static_cast<unsigned long>(st.maxCycles));
+  }
+}
+
+// ============================================================================
+// Setup and Loop
+// ============================================================================
+
+void setup() {
+  board::initSerial();
+  delay(100);
+
+  LOGI("=== ADS1115 Dual-Core Pipeline Example ===");
+
+#if EXAMPLE_IDF_I2C
+  if (!i2cBus.begin(0, board::I2C_SDA, board::I2C_SCL).ok() ||
+      !i2cBus.addDevice(0x48, board::I2C_FREQ_HZ).ok()) {
+    LOGE("Failed to initialize I2C");
+    return;
+  }
+#else
+  if (!board::initI2c()) {
+    LOGE("Failed to initialize I2C");
+    return;
+  }
+#endif
+
+  pipeline.setCycleCounter(cycleCount);
+  pipeline.addStage("calibrate", calibrateStage, &calibration);
+  pipeline.addStage("filter", filterStage, &filter);
+  deadBand.setThresholdVolts(ADS1115::Mux::AIN0_GND, DEAD_BAND_VOLTS, ADS1115::Gain::FSR_2_048V);
+  deadBand.setMaxSilenceUs(ADS1115::Mux::AIN0_GND, HEARTBEAT_US);
+  pipeline.addStage("deadband", ADS1115::DeadBand::stage, &deadBand);
+  pipeline.addStage("pack", packStage, &packer);
+
+  ADS1115::Config cfg;
+#if EXAMPLE_IDF_I2C
+  i2cBus.attach(cfg);
+#else
+  cfg.i2cWrite = transport::wireWrite;
+  cfg.i2cWriteRead = transport::wireWriteRead;
+#endif
+  cfg.i2cAddress = 0x48;
+  cfg.i2cTimeoutMs = board::I2C_TIMEOUT_MS;
+  cfg.dataRate = ADS1115::DataRate::SPS_860;
+  cfg.mode = ADS1115::Mode::CONTINUOUS;
+  cfg.onSample = decltype(pipeline)::onSample;
+  cfg.sampleUser = &pipeline;
+
+  auto st = device.begin(cfg);
+  if (!st.ok()) {
+    LOGE("Failed to initialize device: %s", st.msg);
+    return;
+  }
+
+  xTaskCreatePinnedToCore(processingTask, "ads_proc", 4096, nullptr, 5, nullptr,
+                          PROCESSING_CORE);
+  LOGI("Acquisition on core %d, processing on core %d", xPortGetCoreID(),
+       static_cast<int>(PROCESSING_CORE));
+}
+
+void loop() {
+  device.tick(millis());
+
+  // Acquisition: one read per continuous-mode conversion; onSample pushes it
+  // into the ring
+  static uint32_t lastReadUs = 0;
+  uint32_t nowUs = micros();
+  if (nowUs - lastReadUs >= SAMPLE_PERIOD_US) {
+    lastReadUs = nowUs;
+    int16_t raw = 0;
+    device.readRaw(raw);
+  }
+
+  static uint32_t lastReportMs = 0;
+  uint32_t now = millis();
+  if (now - lastReportMs >= REPORT_INTERVAL_MS) {
+    lastReportMs = now;
+    printPipelineStats();
+  }
+}
@@ -0,0 +1,281 @@
+/// @file main.cpp
+/// @brief ADS1115 acquisition daemon publishing into a shared-memory ring
+/// @note This is an EXAMPLE, not part of the library (Linux hosts)
+///
+/// One process owns /dev/i2c-N and the ALERT/RDY line and publishes every
+/// conversion into a POSIX shared-memory ring. Loggers, bridges and UIs attach
+/// as readers with their own cursor and sleep on a futex until data arrives;
+/// none of them touch the bus.
+///
+///   ads1115d [-b bus] [-a addr] [-c chans] [-r sps] [-g chip:line] [-n name] [-s slots]
+///   ads1115d -n /ads1115 --consume          # print what a reader sees
+
+#include <Arduino.h>
+
+#include <getopt.h>
+#include <signal.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "examples/common/LinuxGpioAlert.h"
+#include "examples/common/LinuxI2cTransport.h"
+#include "examples/common/LinuxShmRing.h"
+
+#include "ADS1115/ADS1115.h"
+
+// ============================================================================
+// Options
+// ============================================================================
+
+struct Options {
+  int bus = 1;
+  uint8_t address = 0x48;
+  ADS1115::Mux channels[4] = {ADS1115::Mux::AIN0_GND};
+  size_t channelCount = 1;
+  ADS1115::DataRate rate = ADS1115::DataRate::SPS_860;
+  const char* gpioChip = nullptr;
+  uint32_t gpioLine = 0;
+  const char* name = "/ads1115";
+  uint32_t slots = 4096;
+  bool consume = false;
+};
+
+static constexpr uint32_t REPORT_INTERVAL_MS = 1000;
+static constexpr uint32_t REAP_INTERVAL_MS = 5000;
+static constexpr int ALERT_TIMEOUT_MS = 200;
+static constexpr uint32_t POLL_SLEEP_US = 100;
+
+static volatile sig_atomic_t running = 1;
+
+static void onSignal(int) { running = 0; }
+
+static bool parseRate(long sps, ADS1115::DataRate& out) {
+  static constexpr long kRates[] = {8, 16, 32, 64, 128, 250, 475, 860};
+  for (size_t i = 0; i < sizeof(kRates) / sizeof(kRates[0]); ++i) {
+    if (kRates[i] == sps) {
+      out = static_cast<ADS1115::DataRate>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+/// "0,1,3" -> AIN0_GND, AIN1_GND, AIN3_GND
+static bool parseChannels(const char* list, Options& opt) {
+  opt.channelCount = 0;
+  for (const char* p = list; *p != '\0'; ++p) {
+    if (*p == ',') {
+      continue;
+    }
+    if (*p < '0' || *p > '3' || opt.channelCount >= 4) {
+      return false;
+    }
+    opt.channels[opt.channelCount++] =
+      static_cast<ADS1115::Mux>(static_cast<uint8_t>(ADS1115::Mux::AIN0_GND) + (*p - '0'));
+  }
+  return opt.channelCount > 0;
+}
+
+static bool parseArgs(int argc, char** argv, Options& opt) {
+  static const option longOpts[] = {
+    {"consume", no_argument, nullptr, 'C'},
+    {nullptr, 0, nullptr, 0}
+  };
+  int c;
+  while ((c = getopt_long(argc, argv, "b:a:c:r:g:n:s:", longOpts, nullptr)) != -1) {
+    switch (c) {
+      case 'b': opt.bus = atoi(optarg); break;
+      case 'a': opt.address = static_cast<uint8_t>(strtol(optarg, nullptr, 0)); break;
+      case 'c':
+        if (!parseChannels(optarg, opt)) {
+          return false;
+        }
+        break;
+      case 'r':
+        if (!parseRate(strtol(optarg, nullptr, 10), opt.rate)) {
+          return false;
+        }
+        break;
+      case 'g': {
+        static char chip[64];
+        const char* colon = strchr(optarg, ':');
+        if (colon == nullptr || static_cast<size_t>(colon - optarg) >= sizeof(chip)) {
+          return false;
+        }
+        memcpy(chip, optarg, static_cast<size_t>(colon - optarg));
+        chip[colon - optarg] = '\0';
+        opt.gpioChip = chip;
+        opt.gpioLine = static_cast<uint32_t>(strtoul(colon + 1, nullptr, 10));
+        break;
+      }
+      case 'n': opt.name = optarg; break;
+      case 's': opt.slots = static_cast<uint32_t>(strtoul(optarg, nullptr, 10)); break;
+      case 'C': opt.consume = true; break;
+      default: return false;
+    }
+  }
+  return true;
+}
+
+// ============================================================================
+// Consumer mode
+// ============================================================================
+
+static int runConsumer(const Options& opt) {
+  transport::ShmSampleReader reader;
+  ADS1115::Status st = reader.open(opt.name);
+  if (!st.ok()) {
+    fprintf(stderr, "open %s: %s\n", opt.name, st.msg);
+    return 1;
+  }
+
+  ADS1115::Sample batch[64];
+  uint32_t count = 0;
+  uint32_t lastReportMs = millis();
+  while (running && reader.writerAlive()) {
+    if (!reader.wait(ALERT_TIMEOUT_MS)) {
+      continue;
+    }
+    size_t n = reader.read(batch, 64);
+    count += static_cast<uint32_t>(n);
+    uint32_t now = millis();
+    if (n > 0 && now - lastReportMs >= REPORT_INTERVAL_MS) {
+      const ADS1115::Sample& s = batch[n - 1];
+      printf("%u samples/s  lost=%llu  last: mux=%u raw=%d %.5f V\n",
+             static_cast<unsigned>(count * 1000ULL / (now - lastReportMs)),
+             static_cast<unsigned long long>(reader.lost()),
+             static_cast<unsigned>(s.mux), s.raw, static_cast<double>(s.volts()));
+      fflush(stdout);
+      count = 0;
+      lastReportMs = now;
+    }
+  }
+  return 0;
+}
+
+// ============================================================================
+// Acquisition (bus owner)
+// ============================================================================
+
+/// One single-shot conversion on @p mux; blocks in epoll when the ALERT/RDY
+/// line is available, otherwise sleeps through the conversion time
+static ADS1115::Status acquire(ADS1115::ADS1115& device, transport::LinuxGpioAlert& alert,
+                               ADS1115::Mux mux, int16_t& raw) {
+  if (alert.isOpen()) {
+    alert.arm();  // an edge left from an earlier conversion must not count
+  }
+  ADS1115::Status st = device.startConversion(mux);
+  if (!st.inProgress()) {
+    return st;
+  }
+  if (alert.isOpen()) {
+    while (running && !device.conversionReady()) {
+      if (alert.wait(ALERT_TIMEOUT_MS) <= 0) {
+        return ADS1115::Status::Error(ADS1115::Err::TIMEOUT, "No ALERT/RDY edge");
+      }
+    }
+  } else {
+    delay(device.getConversionTimeMs());
+    while (running && !device.conversionReady()) {
+      delayMicroseconds(POLL_SLEEP_US);
+    }
+  }
+  return device.readRaw(raw);
+}
+
+static int runDaemon(const Options& opt) {
+  transport::LinuxI2cBus bus;
+  ADS1115::Status st = bus.open(opt.bus);
+  if (!st.ok()) {
+    fprintf(stderr, "i2c-%d: %s\n", opt.bus, st.msg);
+    return 1;
+  }
+  bus.setTimeoutMs(50);
+
+  transport::ShmSampleWriter ring;
+  st = ring.create(opt.name, opt.slots);
+  if (!st.ok()) {
+    fprintf(stderr, "ring %s: %s\n", opt.name, st.msg);
+    return 1;
+  }
+
+  ADS1115::ADS1115 device;
+  ADS1115::Config cfg;
+  bus.attach(cfg);
+  cfg.i2cAddress = opt.address;
+  cfg.mux = opt.channels[0];
+  cfg.dataRate = opt.rate;
+  cfg.onSample = transport::ShmSampleWriter::onSample;
+  cfg.sampleUser = &ring;
+  st = device.begin(cfg);
+  if (!st.ok()) {
+    fprintf(stderr, "begin: %s\n", st.msg);
+    return 1;
+  }
+
+  transport::LinuxGpioAlert alert;
+  if (opt.gpioChip != nullptr) {
+    st = alert.open(opt.gpioChip, opt.gpioLine);
+    if (st.ok()) {
+      st = device.enableConversionReadyPin();
+    }
+    if (!st.ok()) {
+      fprintf(stderr, "ALERT/RDY %s:%u: %s\n", opt.gpioChip, opt.gpioLine, st.msg);
+      return 1;
+    }
+    alert.attach(device);
+  }
+
+  printf("Publishing %s (%u slots), %u channel(s), ALERT/RDY %s\n", opt.name, opt.slots,
+         static_cast<unsigned>(opt.channelCount), alert.isOpen() ? "edges" : "polled");
+  fflush(stdout);
+
+  uint32_t errors = 0;
+  uint32_t lastReportMs = millis();
+  uint32_t lastReapMs = lastReportMs;
+  uint64_t lastPublished = 0;
+  size_t next = 0;
+  while (running) {
+    int16_t raw = 0;
+    st = acquire(device, alert, opt.channels[next], raw);
+    if (!st.ok()) {
+      errors++;
+    }
+    next = (next + 1) % opt.channelCount;
+
+    uint32_t now = millis();
+    if (now - lastReapMs >= REAP_INTERVAL_MS) {
+      ring.reapConsumers();
+      lastReapMs = now;
+    }
+    if (now - lastReportMs >= REPORT_INTERVAL_MS) {
+      uint64_t published = ring.published();
+      printf("%llu samples/s  errors=%u  ioctls=%u  edges=%u  stale=%u\n",
+             static_cast<unsigned long long>((published - lastPublished) * 1000ULL /
+                                             (now - lastReportMs)),
+             errors, bus.counters().ioctls, alert.counters().edges, alert.counters().stale);
+      fflush(stdout);
+      lastPublished = published;
+      lastReportMs = now;
+      bus.resetCounters();
+      alert.resetCounters();
+      errors = 0;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) {
+    fprintf(stderr,
+            "usage: %s [-b bus] [-a addr] [-c 0,1,2,3] [-r sps] [-g /dev/gpiochipN:line]\n"
+            "          [-n /name] [-s slots] [--consume]\n", argv[0]);
+    return 2;
+  }
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  return opt.consume ? runConsumer(opt) : runDaemon(opt);
+}
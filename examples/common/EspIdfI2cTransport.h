@@ -0,0 +1,407 @@
+/// @file EspIdfI2cTransport.h
+/// @brief ESP-IDF i2c_master transport adapter for examples (bypasses Wire)
+/// @note NOT part of the library - examples only. Needs ESP-IDF >= 5.2
+///       (Arduino-ESP32 3.x); do not start Wire on the same port.
+#pragma once
+
+#include <driver/i2c_master.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ADS1115/Config.h"
+#include "ADS1115/Status.h"
+
+namespace transport {
+
+using ADS1115::Err;
+using ADS1115::Status;
+
+/// Transfer counters
+struct IdfI2cCounters {
+  uint32_t transfers = 0;  ///< i2c_master_* calls
+  uint32_t queued = 0;     ///< Writes queued without waiting (async mode)
+  uint32_t drains = 0;     ///< Waits for queued writes before a read or reuse
+  uint32_t errors = 0;     ///< Failed calls
+  uint32_t queuedFailures = 0;  ///< Queued transfers that completed with an error
+};
+
+/// One I2C controller with preallocated device handles
+/// @code
+///   transport::IdfI2cBus bus;
+///   bus.begin(0, board::I2C_SDA, board::I2C_SCL);
+///   bus.addDevice(0x48, board::I2C_FREQ_HZ);
+///   bus.attach(cfg);
+/// @endcode
+/// @note Bus and device handles are created once; each driver transaction is
+///       one i2c_master_* call with no per-call clock or timeout setup.
+///       Register reads use i2c_master_transmit_receive() (repeated START).
+///       With asyncDepth > 0, write-only transactions (config, thresholds,
+///       conversion starts) are copied into a small pool and queued without
+///       waiting; the next read, or a full pool, waits for them to finish.
+/// @note A queued write returns OK before it reaches the wire. In async mode
+///       i2c_master_* only reports a NACK through the done callback, so the
+///       failure is latched there and returned as I2C_ERROR "Queued I2C
+///       transfer failed" (detail = failed transfers) by the next call on this
+///       bus: a read, flush(), batch(), or the next write, which is then not
+///       sent. The driver's health counters charge it to that later call.
+class IdfI2cBus {
+public:
+  static constexpr size_t kMaxDevices = 4;
+  static constexpr size_t kAsyncSlots = 8;     ///< Queued writes in flight
+  static constexpr size_t kAsyncBytes = 4;     ///< Pointer + 16-bit value (+1 spare)
+
+  IdfI2cBus() = default;
+  ~IdfI2cBus() { end(); }
+
+  IdfI2cBus(const IdfI2cBus&) = delete;
+  IdfI2cBus& operator=(const IdfI2cBus&) = delete;
+
+  /// Create the controller
+  /// @param asyncDepth Hardware transaction queue depth; 0 = blocking transfers
+  Status begin(i2c_port_num_t port, int sda, int scl, size_t asyncDepth = 0,
+               bool internalPullup = true) {
+    if (_bus != nullptr) {
+      return Status::Ok();
+    }
+    i2c_master_bus_config_t cfg = {};
+    cfg.i2c_port = port;
+    cfg.sda_io_num = static_cast<gpio_num_t>(sda);
+    cfg.scl_io_num = static_cast<gpio_num_t>(scl);
+    cfg.clk_source = I2C_CLK_SRC_DEFAULT;
+    cfg.glitch_ignore_cnt = 7;
+    cfg.trans_queue_depth = asyncDepth;
+    cfg.flags.enable_internal_pullup = internalPullup ? 1 : 0;
+    esp_err_t err = i2c_new_master_bus(&cfg, &_bus);
+    if (err != ESP_OK) {
+      _bus = nullptr;
+      return Status::Error(Err::INVALID_CONFIG, "i2c_new_master_bus failed", err);
+    }
+    _async = asyncDepth > 0;
+    return Status::Ok();
+  }
+
+  /// Create the handle for @p addr (call once per device before begin() of the driver)
+  Status addDevice(uint8_t addr, uint32_t sclHz = 400000) {
+    if (_bus == nullptr) {
+      return Status::Error(Err::NOT_INITIALIZED, "I2C bus not started");
+    }
+    if (_find(addr) != nullptr) {
+      return Status::Ok();
+    }
+    if (_deviceCount >= kMaxDevices) {
+      return Status::Error(Err::INVALID_CONFIG, "Too many I2C devices");
+    }
+    i2c_device_config_t cfg = {};
+    cfg.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+    cfg.device_address = addr;
+    cfg.scl_speed_hz = sclHz;
+    Device& dev = _devices[_deviceCount];
+    esp_err_t err = i2c_master_bus_add_device(_bus, &cfg, &dev.handle);
+    if (err != ESP_OK) {
+      return Status::Error(Err::INVALID_CONFIG, "i2c_master_bus_add_device failed", err);
+    }
+    if (_async) {
+      i2c_master_event_callbacks_t cbs = {};
+      cbs.on_trans_done = _onDone;
+      err = i2c_master_register_event_callbacks(dev.handle, &cbs, this);
+      if (err != ESP_OK) {
+        i2c_master_bus_rm_device(dev.handle);
+        return Status::Error(Err::INVALID_CONFIG, "I2C callback registration failed", err);
+      }
+    }
+    dev.addr = addr;
+    _deviceCount++;
+    return Status::Ok();
+  }
+
+  /// Wait for queued writes, remove every device and delete the controller
+  void end() {
+    if (_bus == nullptr) {
+      return;
+    }
+    flush(1000);
+    for (size_t i = 0; i < _deviceCount; ++i) {
+      i2c_master_bus_rm_device(_devices[i].handle);
+    }
+    _deviceCount = 0;
+    i2c_del_master_bus(_bus);
+    _bus = nullptr;
+    _submitted = 0;
+    _completed.store(0, std::memory_order_relaxed);
+    _failed.store(0, std::memory_order_relaxed);
+    _failedReported = 0;
+  }
+
+  /// Wait until every queued write has completed (no-op in blocking mode)
+  /// @return The drain error, else any queued-write failure not yet reported
+  Status flush(uint32_t timeoutMs) {
+    if (!_async) {
+      return Status::Ok();
+    }
+    if (_inFlight() > 0) {
+      _counters.drains++;
+      esp_err_t err = i2c_master_bus_wait_all_done(_bus, static_cast<int>(timeoutMs));
+      if (err != ESP_OK) {
+        _counters.errors++;
+        return _toStatus(err, "I2C queue drain failed");
+      }
+    }
+    return _queuedFailure();
+  }
+
+  Status write(uint8_t addr, const uint8_t* data, size_t len, uint32_t timeoutMs) {
+    Device* dev = _find(addr);
+    if (dev == nullptr) {
+      return Status::Error(Err::INVALID_PARAM, "I2C device not added");
+    }
+    Status failed = _queuedFailure();
+    if (!failed.ok()) {
+      return failed;
+    }
+    const uint8_t* payload = data;
+    bool queued = _async && len <= kAsyncBytes;
+    if (queued) {
+      // Slots are reused in order, so at most kAsyncSlots transfers may be in flight
+      if (_inFlight() >= kAsyncSlots) {
+        Status st = flush(timeoutMs);
+        if (!st.ok()) {
+          return st;
+        }
+      }
+      uint8_t* slot = _pool[_poolNext++ % kAsyncSlots];
+      std::memcpy(slot, data, len);
+      payload = slot;
+      _counters.queued++;
+    }
+    esp_err_t err = _begin(i2c_master_transmit(dev->handle, payload, len,
+                                               static_cast<int>(timeoutMs)));
+    if (err == ESP_OK && !queued) {
+      err = _waitDone(timeoutMs);
+    }
+    if (err != ESP_OK) {
+      _counters.errors++;
+      return _toStatus(err, "I2C write failed");
+    }
+    return Status::Ok();
+  }
+
+  Status writeRead(uint8_t addr, const uint8_t* tx, size_t txLen, uint8_t* rx, size_t rxLen,
+                   uint32_t timeoutMs) {
+    Device* dev = _find(addr);
+    if (dev == nullptr) {
+      return Status::Error(Err::INVALID_PARAM, "I2C device not added");
+    }
+    esp_err_t err = _begin(i2c_master_transmit_receive(dev->handle, tx, txLen, rx, rxLen,
+                                                       static_cast<int>(timeoutMs)));
+    if (err == ESP_OK) {
+      err = _waitDone(timeoutMs);
+    }
+    if (err != ESP_OK) {
+      _counters.errors++;
+      return _toStatus(err, "I2C write-read failed");
+    }
+    return _queuedFailure();
+  }
+
+  Status read(uint8_t addr, uint8_t* rx, size_t rxLen, uint32_t timeoutMs) {
+    Device* dev = _find(addr);
+    if (dev == nullptr) {
+      return Status::Error(Err::INVALID_PARAM, "I2C device not added");
+    }
+    esp_err_t err = _begin(i2c_master_receive(dev->handle, rx, rxLen,
+                                              static_cast<int>(timeoutMs)));
+    if (err == ESP_OK) {
+      err = _waitDone(timeoutMs);
+    }
+    if (err != ESP_OK) {
+      _counters.errors++;
+      return _toStatus(err, "I2C read failed");
+    }
+    return _queuedFailure();
+  }
+
+  /// Execute driver batch operations
+  /// @note In async mode every operation is queued and the batch waits once at
+  ///       the end (buffers belong to the caller until then); otherwise this
+  ///       is a plain loop.
+  Status batch(const ADS1115::I2cOp* ops, size_t count, uint32_t timeoutMs) {
+    if (!_async) {
+      for (size_t i = 0; i < count; ++i) {
+        Status st = _runBlocking(ops[i], timeoutMs);
+        if (!st.ok()) {
+          return st;
+        }
+      }
+      return Status::Ok();
+    }
+    for (size_t i = 0; i < count; ++i) {
+      const ADS1115::I2cOp& op = ops[i];
+      Device* dev = _find(op.addr);
+      if (dev == nullptr) {
+        return Status::Error(Err::INVALID_PARAM, "I2C device not added");
+      }
+      int ms = static_cast<int>(timeoutMs);
+      esp_err_t err = ESP_ERR_INVALID_ARG;
+      switch (op.type) {
+        case ADS1115::I2cOpType::WRITE:
+          err = _begin(i2c_master_transmit(dev->handle, op.tx, op.txLen, ms));
+          break;
+        case ADS1115::I2cOpType::WRITE_READ:
+          err = _begin(i2c_master_transmit_receive(dev->handle, op.tx, op.txLen, op.rx,
+                                                   op.rxLen, ms));
+          break;
+        case ADS1115::I2cOpType::READ:
+          err = _begin(i2c_master_receive(dev->handle, op.rx, op.rxLen, ms));
+          break;
+      }
+      if (err != ESP_OK) {
+        _counters.errors++;
+        _waitDone(timeoutMs);
+        return _toStatus(err, "I2C batch failed");
+      }
+      _counters.queued++;
+    }
+    esp_err_t err = _waitDone(timeoutMs);
+    if (err != ESP_OK) {
+      _counters.errors++;
+      return _toStatus(err, "I2C batch failed");
+    }
+    return _queuedFailure();
+  }
+
+  const IdfI2cCounters& counters() const { return _counters; }
+  void resetCounters() { _counters = IdfI2cCounters{}; }
+
+  /// Point a Config (or shared BusConfig) at this controller
+  void attach(ADS1115::BusConfig& cfg) {
+    cfg.i2cWrite = i2cWrite;
+    cfg.i2cWriteRead = i2cWriteRead;
+    cfg.i2cRead = i2cRead;
+    cfg.i2cBatch = i2cBatch;
+    cfg.i2cUser = this;
+  }
+
+  // === BusConfig adapters (user = IdfI2cBus*) ===
+
+  static Status i2cWrite(uint8_t addr, const uint8_t* data, size_t len, uint32_t timeoutMs,
+                         void* user) {
+    return static_cast<IdfI2cBus*>(user)->write(addr, data, len, timeoutMs);
+  }
+
+  static Status i2cWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                             uint8_t* rxData, size_t rxLen, uint32_t timeoutMs, void* user) {
+    return static_cast<IdfI2cBus*>(user)->writeRead(addr, txData, txLen, rxData, rxLen,
+                                                    timeoutMs);
+  }
+
+  static Status i2cRead(uint8_t addr, uint8_t* rxData, size_t rxLen, uint32_t timeoutMs,
+                        void* user) {
+    return static_cast<IdfI2cBus*>(user)->read(addr, rxData, rxLen, timeoutMs);
+  }
+
+  static Status i2cBatch(const ADS1115::I2cOp* ops, size_t count, uint32_t timeoutMs,
+                         void* user) {
+    return static_cast<IdfI2cBus*>(user)->batch(ops, count, timeoutMs);
+  }
+
+private:
+  struct Device {
+    uint8_t addr = 0;
+    i2c_master_dev_handle_t handle = nullptr;
+  };
+
+  Device* _find(uint8_t addr) {
+    for (size_t i = 0; i < _deviceCount; ++i) {
+      if (_devices[i].addr == addr) {
+        return &_devices[i];
+      }
+    }
+    return nullptr;
+  }
+
+  Status _runBlocking(const ADS1115::I2cOp& op, uint32_t timeoutMs) {
+    switch (op.type) {
+      case ADS1115::I2cOpType::WRITE:
+        return write(op.addr, op.tx, op.txLen, timeoutMs);
+      case ADS1115::I2cOpType::WRITE_READ:
+        return writeRead(op.addr, op.tx, op.txLen, op.rx, op.rxLen, timeoutMs);
+      case ADS1115::I2cOpType::READ:
+        return read(op.addr, op.rx, op.rxLen, timeoutMs);
+    }
+    return Status::Error(Err::INVALID_PARAM, "Invalid I2C operation");
+  }
+
+  /// Queued transfers not yet reported done
+  /// @note The done callback can run before the issuing call returns, so the
+  ///       difference is clamped at zero.
+  uint32_t _inFlight() const {
+    int32_t diff = static_cast<int32_t>(_submitted - _completed.load(std::memory_order_acquire));
+    return diff > 0 ? static_cast<uint32_t>(diff) : 0;
+  }
+
+  /// Count a transfer that has just been issued
+  esp_err_t _begin(esp_err_t err) {
+    _counters.transfers++;
+    if (_async && err == ESP_OK) {
+      _submitted++;
+    }
+    return err;
+  }
+
+  /// In async mode a transfer is only queued; caller buffers are valid again
+  /// once the queue drains
+  esp_err_t _waitDone(uint32_t timeoutMs) {
+    if (!_async) {
+      return ESP_OK;
+    }
+    _counters.drains++;
+    return i2c_master_bus_wait_all_done(_bus, static_cast<int>(timeoutMs));
+  }
+
+  /// Transaction-done ISR callback (async mode)
+  static bool _onDone(i2c_master_dev_handle_t, const i2c_master_event_data_t* evt, void* arg) {
+    IdfI2cBus* self = static_cast<IdfI2cBus*>(arg);
+    if (evt != nullptr && evt->event != I2C_EVENT_DONE) {
+      self->_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    self->_completed.fetch_add(1, std::memory_order_release);
+    return false;
+  }
+
+  /// Report queued transfers that failed since the last call (async mode)
+  Status _queuedFailure() {
+    uint32_t failed = _failed.load(std::memory_order_acquire);
+    uint32_t fresh = failed - _failedReported;
+    if (fresh == 0) {
+      return Status::Ok();
+    }
+    _failedReported = failed;
+    _counters.errors++;
+    _counters.queuedFailures += fresh;
+    return Status::Error(Err::I2C_ERROR, "Queued I2C transfer failed", static_cast<int32_t>(fresh));
+  }
+
+  static Status _toStatus(esp_err_t err, const char* msg) {
+    if (err == ESP_ERR_TIMEOUT) {
+      return Status::Error(Err::TIMEOUT, msg, err);
+    }
+    return Status::Error(Err::I2C_ERROR, msg, err);
+  }
+
+  i2c_master_bus_handle_t _bus = nullptr;
+  Device _devices[kMaxDevices];
+  size_t _deviceCount = 0;
+  IdfI2cCounters _counters;
+  uint8_t _pool[kAsyncSlots][kAsyncBytes] = {};
+  uint32_t _poolNext = 0;
+  uint32_t _submitted = 0;
+  std::atomic<uint32_t> _completed{0};
+  std::atomic<uint32_t> _failed{0};
+  uint32_t _failedReported = 0;
+  bool _async = false;
+};
+
+} // namespace transport
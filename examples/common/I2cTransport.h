@@ -87,4 +87,28 @@ inline Status wireWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
   return Status::Ok();
 }
 
+/// I2C read-only callback using Wire library (reads the current pointer register)
+/// @param addr I2C device address (7-bit)
+/// @param rxData Buffer for read data
+/// @param rxLen Number of bytes to read
+/// @param timeoutMs Timeout (used to set Wire timeout)
+/// @param user User context (unused)
+/// @return Status indicating success or failure
+inline Status wireRead(uint8_t addr, uint8_t* rxData, size_t rxLen,
+                       uint32_t timeoutMs, void* user) {
+  (void)user;
+  Wire.setTimeOut(static_cast<uint16_t>(timeoutMs));
+
+  size_t received = Wire.requestFrom(addr, rxLen);
+  if (received != rxLen) {
+    return Status::Error(Err::I2C_ERROR, "I2C read incomplete", static_cast<int32_t>(received));
+  }
+
+  for (size_t i = 0; i < rxLen; i++) {
+    rxData[i] = Wire.read();
+  }
+
+  return Status::Ok();
+}
+
 } // namespace transport
@@ -0,0 +1,279 @@
+/// @file LinuxGpioAlert.h
+/// @brief ALERT/RDY edge events through the Linux GPIO character device
+/// @note NOT part of the library - examples only (Linux hosts, uAPI v2)
+#pragma once
+
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ADS1115/ADS1115.h"
+
+namespace transport {
+
+using ADS1115::Err;
+using ADS1115::Status;
+
+/// System calls used by LinuxGpioAlert; replace open/ioctl to hand back a fake
+/// event fd (e.g. a pipe carrying gpio_v2_line_event records) and clock to
+/// control the event timestamps it is compared with
+struct LinuxGpioSyscalls {
+  int (*open)(const char* path, int flags, void* ctx) = nullptr;
+  int (*ioctl)(int fd, unsigned long request, void* arg, void* ctx) = nullptr;
+  int (*close)(int fd, void* ctx) = nullptr;
+  uint64_t (*clockNs)(void* ctx) = nullptr;  ///< CLOCK_MONOTONIC, as in line events
+  void* ctx = nullptr;
+
+  /// The real open/ioctl/close/clock_gettime
+  static LinuxGpioSyscalls system() {
+    LinuxGpioSyscalls sys;
+    sys.open = [](const char* path, int flags, void*) { return ::open(path, flags); };
+    sys.ioctl = [](int fd, unsigned long request, void* arg, void*) {
+      return ::ioctl(fd, request, arg);
+    };
+    sys.close = [](int fd, void*) { return ::close(fd); };
+    sys.clockNs = [](void*) -> uint64_t {
+      timespec ts;
+      ::clock_gettime(CLOCK_MONOTONIC, &ts);
+      return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+             static_cast<uint64_t>(ts.tv_nsec);
+    };
+    return sys;
+  }
+};
+
+/// Edge and wakeup counters
+struct LinuxGpioCounters {
+  uint32_t edges = 0;     ///< Assert edges read from the event fd
+  uint32_t stale = 0;     ///< Edges stamped before the last arm(); ignored
+  uint32_t lost = 0;      ///< Edges the kernel dropped (line_seqno gaps)
+  uint32_t notified = 0;  ///< Edges that completed a driver conversion
+  uint32_t wakeups = 0;   ///< wait() calls that returned with events
+  uint32_t timeouts = 0;  ///< wait() calls that timed out
+};
+
+/// ALERT/RDY line requested for edge events, feeding the driver's readiness
+/// @code
+///   transport::LinuxGpioAlert alert;
+///   alert.open("/dev/gpiochip0", 17);
+///   alert.attach(device);            // edges -> notifyConversionReady()
+///   device.enableConversionReadyPin();
+///   alert.arm();                     // before every start
+///   device.startConversion();
+///   while (alert.wait(200) > 0 && !device.conversionReady()) {}
+/// @endcode
+/// @note The driver must be in conversion-ready comparator mode. Edges carry
+///       kernel CLOCK_MONOTONIC timestamps (lastEdgeNs()); the acquisition
+///       thread sleeps in epoll_wait() between conversions. In continuous
+///       mode ALERT/RDY only pulses for ~8 us, so the event fd is the only
+///       reliable way to see it from user space.
+/// @note An edge can still be queued from an earlier conversion (a timeout,
+///       a conversion read by polling, a glitch). Call arm() right before
+///       each startConversion(): it discards queued events and ignores any
+///       edge stamped before that moment, so only the new conversion's edge
+///       reaches notifyConversionReady().
+class LinuxGpioAlert {
+public:
+  static constexpr size_t kReadBatch = 16;  ///< Events read per read() call
+
+  explicit LinuxGpioAlert(const LinuxGpioSyscalls& sys = LinuxGpioSyscalls::system())
+      : _sys(sys) {}
+  ~LinuxGpioAlert() { close(); }
+
+  LinuxGpioAlert(const LinuxGpioAlert&) = delete;
+  LinuxGpioAlert& operator=(const LinuxGpioAlert&) = delete;
+
+  /// Request @p line on @p chipPath for assert edges
+  /// @param polarity Must match Config::compPolarity (ACTIVE_LOW = falling)
+  /// @param pullUp   Enable the SoC pull-up (ALERT/RDY is open-drain)
+  Status open(const char* chipPath, uint32_t line,
+              ADS1115::ComparatorPolarity polarity = ADS1115::ComparatorPolarity::ACTIVE_LOW,
+              bool pullUp = true) {
+    close();
+    int chipFd = _sys.open(chipPath, O_RDWR | O_CLOEXEC, _sys.ctx);
+    if (chipFd < 0) {
+      return Status::Error(Err::DEVICE_NOT_FOUND, "Cannot open GPIO chip", errno);
+    }
+
+    gpio_v2_line_request req;
+    std::memset(&req, 0, sizeof(req));
+    req.offsets[0] = line;
+    req.num_lines = 1;
+    req.event_buffer_size = 64;
+    std::strncpy(req.consumer, "ads1115-alert", sizeof(req.consumer) - 1);
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT |
+                       (polarity == ADS1115::ComparatorPolarity::ACTIVE_LOW
+                          ? GPIO_V2_LINE_FLAG_EDGE_FALLING
+                          : GPIO_V2_LINE_FLAG_EDGE_RISING);
+    if (pullUp) {
+      req.config.flags |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+    }
+
+    int rc = _sys.ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &req, _sys.ctx);
+    int err = errno;
+    _sys.close(chipFd, _sys.ctx);
+    if (rc < 0 || req.fd < 0) {
+      return Status::Error(Err::INVALID_CONFIG, "GPIO line request failed", err);
+    }
+    _fd = req.fd;
+    ::fcntl(_fd, F_SETFL, ::fcntl(_fd, F_GETFL) | O_NONBLOCK);
+
+    _epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (_epollFd < 0) {
+      close();
+      return Status::Error(Err::INVALID_CONFIG, "epoll_create1 failed", errno);
+    }
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = _fd;
+    if (::epoll_ctl(_epollFd, EPOLL_CTL_ADD, _fd, &ev) < 0) {
+      close();
+      return Status::Error(Err::INVALID_CONFIG, "epoll_ctl failed", errno);
+    }
+    _haveSeq = false;
+    _pending = 0;
+    _notBeforeNs = 0;
+    return Status::Ok();
+  }
+
+  void close() {
+    if (_epollFd >= 0) {
+      ::close(_epollFd);
+      _epollFd = -1;
+    }
+    if (_fd >= 0) {
+      _sys.close(_fd, _sys.ctx);
+      _fd = -1;
+    }
+  }
+
+  bool isOpen() const { return _fd >= 0; }
+
+  /// Line event fd, for callers that run their own epoll/select loop
+  int fd() const { return _fd; }
+
+  /// Forward each edge to @p device.notifyConversionReady() (nullptr detaches)
+  void attach(ADS1115::ADS1115* device) { _device = device; }
+  void attach(ADS1115::ADS1115& device) { _device = &device; }
+
+  /// Discard queued edges and ignore any stamped before now; call right
+  /// before startConversion()
+  /// @return Stale edges discarded
+  size_t arm() {
+    _notBeforeNs = (_sys.clockNs != nullptr) ? _sys.clockNs(_sys.ctx) : 0;
+    size_t discarded = drain();
+    _pending = 0;
+    return discarded;
+  }
+
+  /// Block until an edge arrives or @p timeoutMs expires (-1 = forever)
+  /// @return Edges consumed, 0 on timeout, -1 on error
+  int wait(int timeoutMs) {
+    if (_epollFd < 0) {
+      return -1;
+    }
+    size_t got = drain();
+    if (got > 0) {
+      _counters.wakeups++;
+      return static_cast<int>(got);
+    }
+    epoll_event ev;
+    int n;
+    do {
+      n = ::epoll_wait(_epollFd, &ev, 1, timeoutMs);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+      return -1;
+    }
+    if (n == 0) {
+      _counters.timeouts++;
+      return 0;
+    }
+    got = drain();
+    if (got > 0) {
+      _counters.wakeups++;
+    }
+    return static_cast<int>(got);
+  }
+
+  /// Read every queued event without blocking
+  /// @return Assert edges consumed (including stale ones)
+  size_t drain() {
+    if (_fd < 0) {
+      return 0;
+    }
+    size_t edges = 0;
+    gpio_v2_line_event events[kReadBatch];
+    for (;;) {
+      ssize_t n = ::read(_fd, events, sizeof(events));
+      if (n < static_cast<ssize_t>(sizeof(gpio_v2_line_event))) {
+        break;
+      }
+      size_t count = static_cast<size_t>(n) / sizeof(gpio_v2_line_event);
+      for (size_t i = 0; i < count; ++i) {
+        _onEvent(events[i]);
+        edges++;
+      }
+      if (count < kReadBatch) {
+        break;
+      }
+    }
+    return edges;
+  }
+
+  /// Take one latched edge (true if any arrived since the last take)
+  bool takeEdge() {
+    if (_pending == 0) {
+      return false;
+    }
+    _pending--;
+    return true;
+  }
+
+  uint64_t lastEdgeNs() const { return _lastEdgeNs; }
+  const LinuxGpioCounters& counters() const { return _counters; }
+  void resetCounters() { _counters = LinuxGpioCounters{}; }
+
+private:
+  void _onEvent(const gpio_v2_line_event& ev) {
+    if (_haveSeq && ev.line_seqno > _lastSeq + 1) {
+      _counters.lost += ev.line_seqno - _lastSeq - 1;
+    }
+    _lastSeq = ev.line_seqno;
+    _haveSeq = true;
+    _counters.edges++;
+    if (ev.timestamp_ns < _notBeforeNs) {
+      _counters.stale++;
+      return;
+    }
+    _lastEdgeNs = ev.timestamp_ns;
+    if (_pending < UINT32_MAX) {
+      _pending++;
+    }
+    if (_device != nullptr && _device->notifyConversionReady()) {
+      _counters.notified++;
+    }
+  }
+
+  LinuxGpioSyscalls _sys;
+  LinuxGpioCounters _counters;
+  ADS1115::ADS1115* _device = nullptr;
+  uint64_t _lastEdgeNs = 0;
+  uint64_t _notBeforeNs = 0;
+  uint32_t _lastSeq = 0;
+  uint32_t _pending = 0;
+  int _fd = -1;
+  int _epollFd = -1;
+  bool _haveSeq = false;
+};
+
+} // namespace transport
@@ -0,0 +1,277 @@
+/// @file LinuxI2cTransport.h
+/// @brief Linux i2c-dev transport using combined I2C_RDWR messages
+/// @note NOT part of the library - examples only (Linux hosts)
+#pragma once
+
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "ADS1115/Config.h"
+#include "ADS1115/Status.h"
+
+namespace transport {
+
+using ADS1115::Err;
+using ADS1115::Status;
+
+/// System calls used by LinuxI2cBus; replace them to test without hardware
+struct LinuxI2cSyscalls {
+  int (*open)(const char* path, int flags, void* ctx) = nullptr;
+  int (*ioctl)(int fd, unsigned long request, void* arg, void* ctx) = nullptr;
+  int (*close)(int fd, void* ctx) = nullptr;
+  void* ctx = nullptr;
+
+  /// The real open/ioctl/close
+  static LinuxI2cSyscalls system() {
+    LinuxI2cSyscalls sys;
+    sys.open = [](const char* path, int flags, void*) { return ::open(path, flags); };
+    sys.ioctl = [](int fd, unsigned long request, void* arg, void*) {
+      return ::ioctl(fd, request, arg);
+    };
+    sys.close = [](int fd, void*) { return ::close(fd); };
+    return sys;
+  }
+};
+
+/// Syscall and message counters
+struct LinuxI2cCounters {
+  uint32_t ioctls = 0;    ///< I2C_RDWR calls (one per transaction or batch)
+  uint32_t messages = 0;  ///< i2c_msg segments carried by those calls
+  uint32_t opens = 0;     ///< Device node opens
+  uint32_t errors = 0;    ///< Failed ioctls
+};
+
+/// Queue of register operations submitted as one I2C_RDWR ioctl
+/// @note Buffers must stay valid until LinuxI2cBus::submit() returns.
+///       The kernel caps one ioctl at I2C_RDWR_IOCTL_MAX_MSGS (42) messages.
+template <size_t MaxMessages = 8>
+class LinuxI2cBatch {
+public:
+  static_assert(MaxMessages <= I2C_RDWR_IOCTL_MAX_MSGS, "Too many messages for one ioctl");
+
+  /// Append a write (e.g. pointer + 16-bit register value)
+  bool write(uint8_t addr, const uint8_t* data, size_t len) {
+    return _add(addr, 0, const_cast<uint8_t*>(data), len);
+  }
+
+  /// Append a pointer write followed by a repeated-start read
+  bool writeRead(uint8_t addr, const uint8_t* tx, size_t txLen, uint8_t* rx, size_t rxLen) {
+    if (_count + 2 > MaxMessages) {
+      return false;
+    }
+    _add(addr, 0, const_cast<uint8_t*>(tx), txLen);
+    return _add(addr, I2C_M_RD, rx, rxLen);
+  }
+
+  /// Append a read from the current pointer register
+  bool read(uint8_t addr, uint8_t* rx, size_t rxLen) { return _add(addr, I2C_M_RD, rx, rxLen); }
+
+  void clear() { _count = 0; }
+  size_t size() const { return _count; }
+  i2c_msg* messages() { return _msgs; }
+
+private:
+  bool _add(uint8_t addr, uint16_t flags, uint8_t* buf, size_t len) {
+    if (_count >= MaxMessages || len > 0xFFFF) {
+      return false;
+    }
+    _msgs[_count].addr = addr;
+    _msgs[_count].flags = flags;
+    _msgs[_count].len = static_cast<uint16_t>(len);
+    _msgs[_count].buf = buf;
+    _count++;
+    return true;
+  }
+
+  i2c_msg _msgs[MaxMessages] = {};
+  size_t _count = 0;
+};
+
+/// One /dev/i2c-N adapter, opened once and shared by every device on it
+/// @code
+///   transport::LinuxI2cBus bus;
+///   bus.open(1);                     // /dev/i2c-1
+///   bus.setTimeoutMs(50);
+///   ADS1115::Config cfg;
+///   bus.attach(cfg);
+/// @endcode
+/// @note Each driver transaction is a single I2C_RDWR ioctl: a register read
+///       is pointer write + repeated start + read in one syscall instead of
+///       write() followed by read().
+class LinuxI2cBus {
+public:
+  explicit LinuxI2cBus(const LinuxI2cSyscalls& sys = LinuxI2cSyscalls::system()) : _sys(sys) {}
+  ~LinuxI2cBus() { close(); }
+
+  LinuxI2cBus(const LinuxI2cBus&) = delete;
+  LinuxI2cBus& operator=(const LinuxI2cBus&) = delete;
+
+  /// Open /dev/i2c-@p busNumber (no-op if already open)
+  Status open(int busNumber) {
+    char path[32];
+    std::snprintf(path, sizeof(path), "/dev/i2c-%d", busNumber);
+    return open(path);
+  }
+
+  Status open(const char* path) {
+    if (_fd >= 0) {
+      return Status::Ok();
+    }
+    _fd = _sys.open(path, O_RDWR | O_CLOEXEC, _sys.ctx);
+    _counters.opens++;
+    if (_fd < 0) {
+      return Status::Error(Err::DEVICE_NOT_FOUND, "Cannot open i2c-dev node", errno);
+    }
+    return Status::Ok();
+  }
+
+  void close() {
+    if (_fd >= 0) {
+      _sys.close(_fd, _sys.ctx);
+      _fd = -1;
+    }
+  }
+
+  /// Adapter-wide transfer timeout (I2C_TIMEOUT, 10 ms resolution)
+  Status setTimeoutMs(uint32_t timeoutMs) {
+    if (_fd < 0) {
+      return Status::Error(Err::NOT_INITIALIZED, "i2c-dev node not open");
+    }
+    unsigned long ticks = (timeoutMs + 9) / 10;
+    if (_sys.ioctl(_fd, I2C_TIMEOUT, reinterpret_cast<void*>(ticks), _sys.ctx) < 0) {
+      return Status::Error(Err::I2C_ERROR, "I2C_TIMEOUT failed", errno);
+    }
+    return Status::Ok();
+  }
+
+  bool isOpen() const { return _fd >= 0; }
+  int fd() const { return _fd; }
+
+  Status write(uint8_t addr, const uint8_t* data, size_t len) {
+    i2c_msg msg = {addr, 0, static_cast<uint16_t>(len), const_cast<uint8_t*>(data)};
+    return transfer(&msg, 1);
+  }
+
+  Status writeRead(uint8_t addr, const uint8_t* tx, size_t txLen, uint8_t* rx, size_t rxLen) {
+    i2c_msg msgs[2] = {
+      {addr, 0, static_cast<uint16_t>(txLen), const_cast<uint8_t*>(tx)},
+      {addr, I2C_M_RD, static_cast<uint16_t>(rxLen), rx}
+    };
+    return transfer(msgs, 2);
+  }
+
+  Status read(uint8_t addr, uint8_t* rx, size_t rxLen) {
+    i2c_msg msg = {addr, I2C_M_RD, static_cast<uint16_t>(rxLen), rx};
+    return transfer(&msg, 1);
+  }
+
+  /// Submit every queued operation in one ioctl (repeated starts between them)
+  template <size_t N>
+  Status submit(LinuxI2cBatch<N>& batch) {
+    Status st = transfer(batch.messages(), batch.size());
+    batch.clear();
+    return st;
+  }
+
+  /// Execute driver batch operations, packing as many as fit into each ioctl
+  Status batch(const ADS1115::I2cOp* ops, size_t count) {
+    i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    size_t used = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const ADS1115::I2cOp& op = ops[i];
+      size_t need = (op.type == ADS1115::I2cOpType::WRITE_READ) ? 2 : 1;
+      if (used + need > I2C_RDWR_IOCTL_MAX_MSGS) {
+        Status st = transfer(msgs, used);
+        if (!st.ok()) {
+          return st;
+        }
+        used = 0;
+      }
+      if (op.type != ADS1115::I2cOpType::READ) {
+        msgs[used++] = {op.addr, 0, static_cast<uint16_t>(op.txLen), const_cast<uint8_t*>(op.tx)};
+      }
+      if (op.type != ADS1115::I2cOpType::WRITE) {
+        msgs[used++] = {op.addr, I2C_M_RD, static_cast<uint16_t>(op.rxLen), op.rx};
+      }
+    }
+    return transfer(msgs, used);
+  }
+
+  /// Raw I2C_RDWR
+  Status transfer(i2c_msg* msgs, size_t count) {
+    if (_fd < 0) {
+      return Status::Error(Err::NOT_INITIALIZED, "i2c-dev node not open");
+    }
+    if (count == 0) {
+      return Status::Ok();
+    }
+    if (count > I2C_RDWR_IOCTL_MAX_MSGS) {
+      return Status::Error(Err::INVALID_PARAM, "Too many I2C messages");
+    }
+    i2c_rdwr_ioctl_data data = {msgs, static_cast<uint32_t>(count)};
+    _counters.ioctls++;
+    _counters.messages += static_cast<uint32_t>(count);
+    if (_sys.ioctl(_fd, I2C_RDWR, &data, _sys.ctx) < 0) {
+      _counters.errors++;
+      int err = errno;
+      if (err == ETIMEDOUT) {
+        return Status::Error(Err::TIMEOUT, "I2C_RDWR timed out", err);
+      }
+      return Status::Error(Err::I2C_ERROR, "I2C_RDWR failed", err);
+    }
+    return Status::Ok();
+  }
+
+  const LinuxI2cCounters& counters() const { return _counters; }
+  void resetCounters() { _counters = LinuxI2cCounters{}; }
+
+  /// Point a Config (or shared BusConfig) at this adapter
+  void attach(ADS1115::BusConfig& cfg) {
+    cfg.i2cWrite = i2cWrite;
+    cfg.i2cWriteRead = i2cWriteRead;
+    cfg.i2cRead = i2cRead;
+    cfg.i2cBatch = i2cBatch;
+    cfg.i2cUser = this;
+  }
+
+  // === BusConfig adapters (user = LinuxI2cBus*) ===
+
+  static Status i2cWrite(uint8_t addr, const uint8_t* data, size_t len, uint32_t timeoutMs,
+                         void* user) {
+    (void)timeoutMs;  // Adapter-wide; see setTimeoutMs()
+    return static_cast<LinuxI2cBus*>(user)->write(addr, data, len);
+  }
+
+  static Status i2cWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                             uint8_t* rxData, size_t rxLen, uint32_t timeoutMs, void* user) {
+    (void)timeoutMs;
+    return static_cast<LinuxI2cBus*>(user)->writeRead(addr, txData, txLen, rxData, rxLen);
+  }
+
+  static Status i2cRead(uint8_t addr, uint8_t* rxData, size_t rxLen, uint32_t timeoutMs,
+                        void* user) {
+    (void)timeoutMs;
+    return static_cast<LinuxI2cBus*>(user)->read(addr, rxData, rxLen);
+  }
+
+  static Status i2cBatch(const ADS1115::I2cOp* ops, size_t count, uint32_t timeoutMs,
+                         void* user) {
+    (void)timeoutMs;
+    return static_cast<LinuxI2cBus*>(user)->batch(ops, count);
+  }
+
+private:
+  LinuxI2cSyscalls _sys;
+  LinuxI2cCounters _counters;
+  int _fd = -1;
+};
+
+} // namespace transport
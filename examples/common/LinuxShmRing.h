@@ -0,0 +1,397 @@
+/// @file LinuxShmRing.h
+/// @brief POSIX shared-memory sample ring: one writer process, many readers
+/// @note NOT part of the library - examples only (Linux hosts)
+#pragma once
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+
+#include "ADS1115/Sample.h"
+#include "ADS1115/Status.h"
+
+namespace transport {
+
+using ADS1115::Err;
+using ADS1115::Sample;
+using ADS1115::Status;
+
+namespace shm {
+
+static constexpr uint32_t kMagic = 0x41445331;  ///< "ADS1"
+static constexpr uint32_t kVersion = 1;
+static constexpr size_t kMaxConsumers = 16;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Futex word must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring counters must be lock-free");
+
+/// Per-consumer state, owned by the reader that claimed it
+struct ConsumerSlot {
+  std::atomic<uint32_t> pid{0};      ///< 0 = free
+  std::atomic<uint64_t> cursor{0};   ///< Next sample index to read
+  std::atomic<uint64_t> lost{0};     ///< Samples overwritten before being read
+};
+
+/// One sample, published with a seqlock keyed on the sample index
+struct Slot {
+  std::atomic<uint64_t> stamp{0};        ///< 2 * index + 1 while writing, + 2 when done
+  std::atomic<uint32_t> timestampUs{0};
+  std::atomic<uint32_t> sampleSeq{0};
+  std::atomic<uint32_t> packed{0};       ///< ADS1115::packSample()
+};
+
+/// Mapped at offset 0, followed by capacity Slots
+struct Header {
+  std::atomic<uint32_t> magic{0};    ///< Written last by the creator
+  uint32_t version = kVersion;
+  uint32_t capacity = 0;             ///< Power of two
+  uint32_t writerPid = 0;
+  std::atomic<uint64_t> head{0};     ///< Samples published so far
+  std::atomic<uint32_t> wakeSeq{0};  ///< Futex word, bumped when readers sleep
+  std::atomic<uint32_t> waiters{0};  ///< Readers inside futex wait
+  ConsumerSlot consumers[kMaxConsumers];
+};
+
+inline size_t mappedSize(uint32_t capacity) {
+  return sizeof(Header) + static_cast<size_t>(capacity) * sizeof(Slot);
+}
+
+inline Slot* slots(Header* header) {
+  return reinterpret_cast<Slot*>(reinterpret_cast<uint8_t*>(header) + sizeof(Header));
+}
+
+/// Process-shared futex (no FUTEX_PRIVATE_FLAG)
+inline long futex(std::atomic<uint32_t>* word, int op, uint32_t value,
+                  const timespec* timeout) {
+  return ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout,
+                   nullptr, 0);
+}
+
+} // namespace shm
+
+/// Acquisition side: owns the bus and publishes every sample into /dev/shm
+/// @code
+///   transport::ShmSampleWriter ring;
+///   ring.create("/ads1115", 4096);
+///   cfg.onSample = transport::ShmSampleWriter::onSample;
+///   cfg.sampleUser = &ring;
+/// @endcode
+/// @note The writer never waits for readers: a reader that falls more than
+///       capacity samples behind loses the oldest ones and sees them in its
+///       lost() count. Publishing is a few relaxed stores; the futex wake
+///       syscall is only made while a reader is asleep.
+class ShmSampleWriter {
+public:
+  ShmSampleWriter() = default;
+  ~ShmSampleWriter() { close(); }
+
+  ShmSampleWriter(const ShmSampleWriter&) = delete;
+  ShmSampleWriter& operator=(const ShmSampleWriter&) = delete;
+
+  /// Create (or replace) shared-memory object @p name ("/ads1115")
+  /// @param capacity Samples held; rounded up to a power of two
+  Status create(const char* name, uint32_t capacity) {
+    close();
+    if (capacity < 2 || capacity > (1u << 24)) {
+      return Status::Error(Err::INVALID_PARAM, "Ring capacity out of range");
+    }
+    uint32_t cap = 2;
+    while (cap < capacity) {
+      cap <<= 1;
+    }
+
+    ::shm_unlink(name);
+    int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      return Status::Error(Err::INVALID_CONFIG, "shm_open failed", errno);
+    }
+    size_t size = shm::mappedSize(cap);
+    if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+      int err = errno;
+      ::close(fd);
+      ::shm_unlink(name);
+      return Status::Error(Err::INVALID_CONFIG, "ftruncate failed", err);
+    }
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+      ::shm_unlink(name);
+      return Status::Error(Err::INVALID_CONFIG, "mmap failed", errno);
+    }
+
+    _header = new (base) shm::Header();
+    _header->capacity = cap;
+    _header->writerPid = static_cast<uint32_t>(::getpid());
+    shm::Slot* slots = shm::slots(_header);
+    for (uint32_t i = 0; i < cap; ++i) {
+      new (&slots[i]) shm::Slot();
+    }
+    _slots = slots;
+    _mask = cap - 1;
+    _size = size;
+    std::snprintf(_name, sizeof(_name), "%s", name);
+    _header->magic.store(shm::kMagic, std::memory_order_release);
+    return Status::Ok();
+  }
+
+  /// Unmap and remove the object (attached readers keep their mapping)
+  void close() {
+    if (_header == nullptr) {
+      return;
+    }
+    _header->magic.store(0, std::memory_order_release);
+    _wakeAll();
+    ::munmap(_header, _size);
+    ::shm_unlink(_name);
+    _header = nullptr;
+    _slots = nullptr;
+  }
+
+  bool isOpen() const { return _header != nullptr; }
+
+  /// Writer side; call from one thread only
+  void publish(const Sample& sample) {
+    uint64_t index = _header->head.load(std::memory_order_relaxed);
+    shm::Slot& slot = _slots[index & _mask];
+    slot.stamp.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestampUs.store(sample.timestampUs, std::memory_order_relaxed);
+    slot.sampleSeq.store(sample.seq, std::memory_order_relaxed);
+    slot.packed.store(ADS1115::packSample(sample), std::memory_order_relaxed);
+    slot.stamp.store(2 * index + 2, std::memory_order_release);
+    _header->head.store(index + 1, std::memory_order_seq_cst);
+    if (_header->waiters.load(std::memory_order_seq_cst) != 0) {
+      _wakeAll();
+    }
+  }
+
+  uint64_t published() const { return _header ? _header->head.load() : 0; }
+
+  /// Free consumer slots whose process has exited
+  /// @return Slots reclaimed
+  size_t reapConsumers() {
+    size_t reaped = 0;
+    for (size_t i = 0; _header != nullptr && i < shm::kMaxConsumers; ++i) {
+      uint32_t pid = _header->consumers[i].pid.load(std::memory_order_acquire);
+      if (pid != 0 && ::kill(static_cast<pid_t>(pid), 0) < 0 && errno == ESRCH) {
+        _header->consumers[i].pid.compare_exchange_strong(pid, 0);
+        reaped++;
+      }
+    }
+    return reaped;
+  }
+
+  /// Consumer @p index lag behind the writer (0 if the slot is free)
+  uint64_t consumerLag(size_t index) const {
+    if (_header == nullptr || index >= shm::kMaxConsumers ||
+        _header->consumers[index].pid.load() == 0) {
+      return 0;
+    }
+    return _header->head.load() - _header->consumers[index].cursor.load();
+  }
+
+  /// SampleFn adapter; user must point to this writer
+  static void onSample(const Sample& sample, void* user) {
+    static_cast<ShmSampleWriter*>(user)->publish(sample);
+  }
+
+private:
+  void _wakeAll() {
+    _header->wakeSeq.fetch_add(1, std::memory_order_seq_cst);
+    shm::futex(&_header->wakeSeq, FUTEX_WAKE, INT_MAX, nullptr);
+  }
+
+  shm::Header* _header = nullptr;
+  shm::Slot* _slots = nullptr;
+  uint64_t _mask = 0;
+  size_t _size = 0;
+  char _name[64] = {};
+};
+
+/// Consumer side: any number of processes, each with its own cursor
+/// @code
+///   transport::ShmSampleReader reader;
+///   reader.open("/ads1115");
+///   ADS1115::Sample batch[64];
+///   for (;;) {
+///     reader.wait(1000);
+///     size_t n = reader.read(batch, 64);
+///   }
+/// @endcode
+class ShmSampleReader {
+public:
+  ShmSampleReader() = default;
+  ~ShmSampleReader() { close(); }
+
+  ShmSampleReader(const ShmSampleReader&) = delete;
+  ShmSampleReader& operator=(const ShmSampleReader&) = delete;
+
+  /// Attach to @p name and claim a consumer slot
+  /// @param fromOldest Start at the oldest retained sample instead of the newest
+  Status open(const char* name, bool fromOldest = false) {
+    close();
+    int fd = ::shm_open(name, O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) {
+      return Status::Error(Err::DEVICE_NOT_FOUND, "No such sample ring", errno);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(shm::Header)) {
+      ::close(fd);
+      return Status::Error(Err::INVALID_CONFIG, "Sample ring too small");
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+      return Status::Error(Err::INVALID_CONFIG, "mmap failed", errno);
+    }
+    auto* header = static_cast<shm::Header*>(base);
+    if (header->magic.load(std::memory_order_acquire) != shm::kMagic ||
+        header->version != shm::kVersion || shm::mappedSize(header->capacity) > size) {
+      ::munmap(base, size);
+      return Status::Error(Err::INVALID_CONFIG, "Sample ring not initialized");
+    }
+
+    uint32_t pid = static_cast<uint32_t>(::getpid());
+    for (size_t i = 0; i < shm::kMaxConsumers; ++i) {
+      uint32_t expected = 0;
+      if (header->consumers[i].pid.compare_exchange_strong(expected, pid)) {
+        _consumer = &header->consumers[i];
+        break;
+      }
+    }
+    if (_consumer == nullptr) {
+      ::munmap(base, size);
+      return Status::Error(Err::BUSY, "All consumer slots in use");
+    }
+
+    _header = header;
+    _slots = shm::slots(header);
+    _capacity = header->capacity;
+    _size = size;
+    uint64_t head = header->head.load(std::memory_order_acquire);
+    uint64_t start = head;
+    if (fromOldest) {
+      start = (head > _capacity) ? head - _capacity : 0;
+    }
+    _consumer->lost.store(0, std::memory_order_relaxed);
+    _consumer->cursor.store(start, std::memory_order_release);
+    return Status::Ok();
+  }
+
+  /// Release the consumer slot and unmap
+  void close() {
+    if (_header == nullptr) {
+      return;
+    }
+    _consumer->pid.store(0, std::memory_order_release);
+    ::munmap(_header, _size);
+    _header = nullptr;
+    _slots = nullptr;
+    _consumer = nullptr;
+  }
+
+  bool isOpen() const { return _header != nullptr; }
+
+  /// False once the writer has closed the ring
+  bool writerAlive() const {
+    return _header != nullptr && _header->magic.load(std::memory_order_acquire) == shm::kMagic;
+  }
+
+  /// Samples waiting for this reader (may exceed capacity if it fell behind)
+  uint64_t available() const {
+    return _header->head.load(std::memory_order_acquire) -
+           _consumer->cursor.load(std::memory_order_relaxed);
+  }
+
+  /// Copy up to @p max samples, oldest first
+  /// @note Samples overwritten before they could be read are skipped and
+  ///       added to lost().
+  size_t read(Sample* out, size_t max) {
+    uint64_t cursor = _consumer->cursor.load(std::memory_order_relaxed);
+    size_t n = 0;
+    while (n < max) {
+      uint64_t head = _header->head.load(std::memory_order_acquire);
+      if (cursor == head) {
+        break;
+      }
+      if (head - cursor > _capacity) {
+        _consumer->lost.fetch_add(head - cursor - _capacity, std::memory_order_relaxed);
+        cursor = head - _capacity;
+      }
+      const shm::Slot& slot = _slots[cursor & (_capacity - 1)];
+      uint64_t expect = 2 * cursor + 2;
+      uint64_t before = slot.stamp.load(std::memory_order_acquire);
+      uint32_t timestampUs = slot.timestampUs.load(std::memory_order_relaxed);
+      uint32_t sampleSeq = slot.sampleSeq.load(std::memory_order_relaxed);
+      uint32_t packed = slot.packed.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      uint64_t after = slot.stamp.load(std::memory_order_relaxed);
+      if (before != expect || after != expect) {
+        if (before < expect) {
+          break;  // Not published yet
+        }
+        // Lapped by the writer while reading this slot
+        _consumer->lost.fetch_add(1, std::memory_order_relaxed);
+        cursor++;
+        continue;
+      }
+      out[n].timestampUs = timestampUs;
+      out[n].seq = sampleSeq;
+      ADS1115::unpackSample(packed, out[n]);
+      n++;
+      cursor++;
+    }
+    _consumer->cursor.store(cursor, std::memory_order_release);
+    return n;
+  }
+
+  /// Sleep until a sample is available, the writer closes or @p timeoutMs
+  /// expires (-1 = forever)
+  /// @return true if samples are available
+  bool wait(int timeoutMs) {
+    if (available() > 0) {
+      return true;
+    }
+    timespec ts;
+    timespec* timeout = nullptr;
+    if (timeoutMs >= 0) {
+      ts.tv_sec = timeoutMs / 1000;
+      ts.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+      timeout = &ts;
+    }
+    uint32_t seq = _header->wakeSeq.load(std::memory_order_seq_cst);
+    _header->waiters.fetch_add(1, std::memory_order_seq_cst);
+    uint64_t head = _header->head.load(std::memory_order_seq_cst);
+    if (head == _consumer->cursor.load(std::memory_order_relaxed) && writerAlive()) {
+      shm::futex(&_header->wakeSeq, FUTEX_WAIT, seq, timeout);
+    }
+    _header->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    return available() > 0;
+  }
+
+  uint64_t lost() const { return _consumer ? _consumer->lost.load() : 0; }
+  uint32_t capacity() const { return _capacity; }
+
+private:
+  shm::Header* _header = nullptr;
+  shm::Slot* _slots = nullptr;
+  shm::ConsumerSlot* _consumer = nullptr;
+  uint32_t _capacity = 0;
+  size_t _size = 0;
+};
+
+} // namespace transport
@@ -0,0 +1,35 @@
+/// @file Arduino.h
+/// @brief Arduino timing API on Linux for the host examples
+/// @note NOT part of the library - add examples/common/linux to the include
+///       path so the driver's <Arduino.h> resolves here. Uses CLOCK_MONOTONIC,
+///       the same clock as GPIO line event timestamps.
+#pragma once
+
+#include <time.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+namespace host {
+
+inline uint64_t monotonicUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000U + static_cast<uint64_t>(ts.tv_nsec) / 1000U;
+}
+
+inline void sleepUs(uint64_t us) {
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(us / 1000000U);
+  ts.tv_nsec = static_cast<long>(us % 1000000U) * 1000L;
+  while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+  }
+}
+
+} // namespace host
+
+inline uint32_t micros() { return static_cast<uint32_t>(host::monotonicUs()); }
+inline uint32_t millis() { return static_cast<uint32_t>(host::monotonicUs() / 1000U); }
+inline void delay(uint32_t ms) { host::sleepUs(static_cast<uint64_t>(ms) * 1000U); }
+inline void delayMicroseconds(uint32_t us) { host::sleepUs(us); }
@@ -7,9 +7,17 @@
 
 #include "ADS1115/CommandTable.h"
 #include "ADS1115/Config.h"
+#include "ADS1115/Sample.h"
 #include "ADS1115/Status.h"
 #include "ADS1115/Version.h"
 
+/// Build flag: set to 1 for the slim instance layout. The driver then keeps
+/// only a pointer to a shared BusConfig (Config::bus is required) instead of
+/// room for a private copy, which is worthwhile with many devices.
+#ifndef ADS1115_SLIM_INSTANCE
+#define ADS1115_SLIM_INSTANCE 0
+#endif
+
 namespace ADS1115 {
 
 /// Driver state for health monitoring
@@ -20,6 +28,32 @@ enum class DriverState : uint8_t {
   OFFLINE    ///< consecutiveFailures >= offlineThreshold
 };
 
+/// Run @p ops through BusConfig::i2cBatch, or one transport callback per
+/// operation when it is not set (stops at the first failure)
+Status executeI2cBatch(const BusConfig& bus, const I2cOp* ops, size_t count);
+
+/// Energy estimate snapshot (see Config::power; needs ADS1115_ENERGY=1)
+struct EnergyStats {
+  uint64_t elapsedUs = 0;        ///< Time covered by the estimate
+  uint64_t convertingUs = 0;     ///< Time the ADC spent converting
+  uint64_t powerDownUs = 0;      ///< Time the ADC spent powered down
+  uint64_t i2cUs = 0;            ///< Estimated I2C bus activity
+  uint32_t conversions = 0;      ///< Single-shot conversions started
+  float energyUj = 0.0f;         ///< Estimated energy in microjoules
+  float averageCurrentUa = 0.0f; ///< Average supply + bus current over elapsedUs
+};
+
+/// Burst capture result (see ADS1115::readBurst)
+struct BurstStats {
+  uint32_t samples = 0;      ///< Conversions stored in the caller's buffer
+  uint32_t missed = 0;       ///< Conversions skipped because a read ran late
+  uint32_t duplicates = 0;   ///< Synced only: re-reads avoided by ignoring an
+                             ///< ALERT/RDY level from the previous conversion
+  uint32_t elapsedUs = 0;    ///< First to last read
+  float achievedSps = 0.0f;  ///< Read rate over elapsedUs
+  bool synced = false;       ///< Reads were paced by ALERT/RDY pulses
+};
+
 /// ADS1115 driver class
 class ADS1115 {
 public:
@@ -47,14 +81,61 @@ public:
   uint32_t totalFailures() const { return _totalFailures; }
   uint32_t totalSuccess() const { return _totalSuccess; }
 
+  // === Energy Estimate ===
+  EnergyStats energyStats() const;
+  void resetEnergyStats();
+
   // === Conversion API ===
   Status startConversion();
   Status startConversion(Mux mux);
+  Status startConversion(const ChannelConfig& channel);
+
+  /// Abort any in-flight single-shot conversion and start @p urgent instead
+  /// @note The ADS1115 ignores OS_START while converting, so the only abort is
+  ///       a general-call reset (BusConfig::allowGeneralCallReset must be
+  ///       set). Thresholds are rewritten afterwards; other devices on the bus
+  ///       are reset too and need reapplyConfig(). Returns IN_PROGRESS, or
+  ///       BUSY without touching the bus while the sample sink is full.
+  Status preemptConversion(const ChannelConfig& urgent);
+
+  /// Rewrite thresholds and config from the driver's settings (e.g. after a
+  /// general-call reset issued for another device)
+  Status reapplyConfig();
   bool conversionReady();
+
+  /// Mark the in-flight single-shot conversion complete from an ALERT/RDY
+  /// edge observed outside gpioRead (e.g. a Linux GPIO event fd)
+  /// @return true if a conversion was waiting and the comparator is in
+  ///         conversion-ready mode
+  bool notifyConversionReady();
   Status readRaw(int16_t& out);
   Status readVoltage(float& volts);
   Status readBlocking(int16_t& out, uint32_t timeoutMs = 200);
   Status readBlockingVoltage(float& volts, uint32_t timeoutMs = 200);
+  const Sample& lastSample() const { return _lastSample; }
+
+  /// Times acquisition paused because Config::sampleBackpressure asked for it
+  /// @note While paused, startConversion() returns BUSY and continuous mode
+  ///       is left (device powered down) until readRaw() or tick() finds the
+  ///       sink ready again. The next sample carries SampleFlag::GAP.
+  uint32_t backpressurePauses() const { return _backpressurePauses; }
+  bool acquisitionPaused() const { return _acquisitionPaused; }
+
+  /// Capture @p count back-to-back conversions in continuous mode
+  /// @param out   Caller-supplied buffer of at least @p count codes
+  /// @param stats Achieved rate and missed conversions
+  /// @param rate  Data rate for the burst; the previous config is restored
+  /// @note With ALERT/RDY in conversion-ready mode and BusConfig::gpioRead
+  ///       set, each read waits for the end-of-conversion pulse (TIMEOUT if
+  ///       none arrives within two periods). Otherwise reads are scheduled
+  ///       from the nominal conversion period, so ±10% oscillator error shows
+  ///       up as skipped codes or as codes read twice, neither of which the
+  ///       driver can detect; only synced bursts are free of re-reads. With
+  ///       Config::i2cRead set, each read is
+  ///       a 2-byte read-only transaction. Samples are not passed to
+  ///       Config::onSample and lastSample() is left unchanged.
+  Status readBurst(int16_t* out, size_t count, BurstStats& stats,
+                   DataRate rate = DataRate::SPS_860);
 
   // === Configuration ===
   Status setMux(Mux mux);
@@ -90,6 +171,13 @@ public:
 
   Status enableConversionReadyPin();
   Status disableComparator();
+  /// True when Config::alertRdyPin can be read and the comparator is in
+  /// conversion-ready mode, i.e. readBurst() will be paced by ALERT/RDY
+  bool conversionReadyPinActive() const;
+
+  // === Excitation ===
+  /// Drive Config::excitationPin through BusConfig::gpioWrite
+  Status setExcitation(bool level);
 
   // === Utility ===
   float rawToVoltage(int16_t raw) const;
@@ -101,9 +189,11 @@ private:
   Status _i2cWriteReadRaw(const uint8_t* txBuf, size_t txLen,
                           uint8_t* rxBuf, size_t rxLen);
   Status _i2cWriteRaw(const uint8_t* buf, size_t len);
+  Status _i2cReadRaw(uint8_t* rxBuf, size_t rxLen);
   Status _i2cWriteReadTracked(const uint8_t* txBuf, size_t txLen,
                               uint8_t* rxBuf, size_t rxLen);
   Status _i2cWriteTracked(const uint8_t* buf, size_t len);
+  Status _i2cBatchTracked(const I2cOp* ops, size_t count);
 
   // === Register Access ===
   Status readRegister16(uint8_t reg, uint16_t& value);
@@ -113,28 +203,70 @@ private:
   // === Health Tracking ===
   Status _updateHealth(const Status& st);
 
+  // === Energy Estimate ===
+  void _energyAccount();
+  void _energyConversionStarted();
+  void _energyI2c(size_t txLen, size_t rxLen);
+
+  // === Backpressure ===
+  bool _sinkFull();
+  Status _continuousBackpressure();
+
   // === Internal ===
   Status _applyConfig();
   uint16_t _buildConfigRegister() const;
+  const BusConfig* _busConfig() const;
+
+  // Members are ordered by alignment to keep the instance compact.
 
   // === State ===
-  Config _config;
-  bool _initialized = false;
-  DriverState _driverState = DriverState::UNINIT;
+#if ADS1115_SLIM_INSTANCE
+  const BusConfig* _bus = nullptr;  ///< Shared transport (Config::bus)
+#else
+  /// Config::bus, or a private copy of the transport fields when it is null;
+  /// begin() picks one and sets _ownsBus, so no instance carries both
+  union BusSlot {
+    BusSlot() : shared(nullptr) {}
+    const BusConfig* shared;
+    BusConfig own;
+  };
+  BusSlot _bus;
+#endif
+  DeviceConfig _config;
+
+  // === Last Conversion ===
+  Sample _lastSample;
 
   // === Health Counters ===
+  Status _lastError = Status::Ok();
   uint32_t _lastOkMs = 0;
   uint32_t _lastErrorMs = 0;
-  Status _lastError = Status::Ok();
-  uint8_t _consecutiveFailures = 0;
   uint32_t _totalFailures = 0;
   uint32_t _totalSuccess = 0;
+  uint32_t _backpressurePauses = 0;
+
+#if ADS1115_ENERGY
+  // === Energy Counters ===
+  uint64_t _energyElapsedUs = 0;
+  uint64_t _energyConvertingUs = 0;
+  uint64_t _energyI2cBits = 0;
+  uint32_t _energyConversions = 0;
+  uint32_t _energyMarkUs = 0;
+#endif
 
   // === Conversion State ===
+  uint32_t _conversionStartMs = 0;
   bool _conversionStarted = false;
   bool _conversionReady = false;
-  uint32_t _conversionStartMs = 0;
-  int16_t _lastRawValue = 0;
+  bool _acquisitionPaused = false;  ///< Sink asked for a pause (see backpressurePauses())
+  bool _sampleGap = false;          ///< Flag the next sample with SampleFlag::GAP
+#if !ADS1115_SLIM_INSTANCE
+  bool _ownsBus = false;            ///< _bus.own is the active member
+#endif
+
+  bool _initialized = false;
+  DriverState _driverState = DriverState::UNINIT;
+  uint8_t _consecutiveFailures = 0;
 };
 
 } // namespace ADS1115
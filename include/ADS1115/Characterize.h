@@ -0,0 +1,238 @@
+/// @file Characterize.h
+/// @brief Noise / ENOB self-characterization over Gain x DataRate settings
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/ADS1115.h"
+
+namespace ADS1115 {
+
+/// Noise figures for one Gain / DataRate setting
+struct NoiseStats {
+  Gain gain = Gain::FSR_2_048V;
+  DataRate dataRate = DataRate::SPS_128;
+  uint32_t samples = 0;
+  float meanCodes = 0.0f;
+  float rmsCodes = 0.0f;       ///< Standard deviation of the code
+  uint16_t peakToPeakCodes = 0;
+  float rmsUv = 0.0f;          ///< rmsCodes in microvolts
+  float peakToPeakUv = 0.0f;
+  float enob = 0.0f;           ///< log2(full-scale span / RMS noise), TI definition
+  float noiseFreeBits = 0.0f;  ///< log2(full-scale span / peak-to-peak noise)
+  int16_t minRaw = 0;
+  int16_t maxRaw = 0;
+};
+
+/// Streaming noise accumulator (Welford mean/variance, min/max, histogram)
+/// @tparam Bins Histogram bins of one code each, centred on the first sample
+template <size_t Bins = 64>
+class NoiseAccumulator {
+public:
+  static_assert(Bins >= 2, "NoiseAccumulator needs at least two bins");
+
+  void reset() {
+    _count = 0;
+    _mean = 0.0;
+    _m2 = 0.0;
+    _min = 0;
+    _max = 0;
+    _center = 0;
+    _below = 0;
+    _above = 0;
+    for (size_t i = 0; i < Bins; ++i) {
+      _bins[i] = 0;
+    }
+  }
+
+  void add(int16_t raw) {
+    if (_count == 0) {
+      _center = raw;
+      _min = raw;
+      _max = raw;
+    }
+    _count++;
+    double delta = raw - _mean;
+    _mean += delta / _count;
+    _m2 += delta * (raw - _mean);
+    if (raw < _min) {
+      _min = raw;
+    }
+    if (raw > _max) {
+      _max = raw;
+    }
+    int32_t offset = static_cast<int32_t>(raw) - binCode(0);
+    if (offset < 0) {
+      _below++;
+    } else if (offset >= static_cast<int32_t>(Bins)) {
+      _above++;
+    } else {
+      _bins[offset]++;
+    }
+  }
+
+  /// Fill @p out from the accumulated samples; gain sets the microvolt scale
+  void summarize(Gain gain, NoiseStats& out) const {
+    out.gain = gain;
+    out.samples = _count;
+    out.minRaw = _min;
+    out.maxRaw = _max;
+    out.meanCodes = static_cast<float>(_mean);
+    out.rmsCodes = (_count > 1) ? static_cast<float>(std::sqrt(_m2 / (_count - 1))) : 0.0f;
+    out.peakToPeakCodes = static_cast<uint16_t>(static_cast<int32_t>(_max) - _min);
+    float lsbUv = lsbVolts(gain) * 1e6f;
+    out.rmsUv = out.rmsCodes * lsbUv;
+    out.peakToPeakUv = out.peakToPeakCodes * lsbUv;
+    // 65536 codes span the full +/-FSR range; a noise-free reading saturates at 16 bits
+    out.enob = (out.rmsCodes > 0.0f) ? static_cast<float>(std::log2(65536.0 / out.rmsCodes))
+                                     : 16.0f;
+    out.noiseFreeBits =
+        (out.peakToPeakCodes > 0)
+            ? static_cast<float>(std::log2(65536.0 / out.peakToPeakCodes))
+            : 16.0f;
+    if (out.enob > 16.0f) {
+      out.enob = 16.0f;
+    }
+    if (out.noiseFreeBits > 16.0f) {
+      out.noiseFreeBits = 16.0f;
+    }
+  }
+
+  uint32_t count() const { return _count; }
+  uint32_t bin(size_t index) const { return (index < Bins) ? _bins[index] : 0; }
+  /// Raw code counted in bin @p index
+  int32_t binCode(size_t index) const {
+    return static_cast<int32_t>(_center) - static_cast<int32_t>(Bins / 2) +
+           static_cast<int32_t>(index);
+  }
+  uint32_t belowRange() const { return _below; }
+  uint32_t aboveRange() const { return _above; }
+  static constexpr size_t bins() { return Bins; }
+
+private:
+  uint32_t _bins[Bins] = {};
+  double _mean = 0.0;
+  double _m2 = 0.0;
+  uint32_t _count = 0;
+  uint32_t _below = 0;
+  uint32_t _above = 0;
+  int16_t _min = 0;
+  int16_t _max = 0;
+  int16_t _center = 0;
+};
+
+/// Called after each setting of a sweep
+using NoisePointFn = void (*)(const NoiseStats& stats, const NoiseAccumulator<>& histogram,
+                              void* user);
+
+/// Bit masks selecting the settings to sweep
+/// @note Bit n selects Gain / DataRate value n, e.g. 1u << uint8_t(DataRate::SPS_860)
+static constexpr uint8_t kAllGains = 0x3F;
+static constexpr uint8_t kAllDataRates = 0xFF;
+
+/// Measure noise for every selected Gain x DataRate pair on the current mux
+/// @param device      Initialized driver; gain, data rate and mode are restored
+/// @param gainMask    Gains to sweep (bit per Gain value)
+/// @param rateMask    Data rates to sweep (bit per DataRate value)
+/// @param samples     Samples per setting
+/// @param out         Table of at least popcount(gainMask) * popcount(rateMask)
+///                    entries, filled gain-major
+/// @param outCapacity Entries available in @p out
+/// @param written     Entries filled
+/// @param onPoint     Optional per-setting callback (e.g. to print the histogram)
+/// @note Every sample is a distinct conversion. With ALERT/RDY pacing (see
+///       ADS1115::conversionReadyPinActive()) samples are read with
+///       readBurst() in chunks of 32 codes. Without it a burst scheduled from
+///       the nominal period could read one conversion twice, which would
+///       understate the noise, so each sample is a single-shot conversion
+///       polled through the OS bit instead (slower, and the samples also
+///       reach Config::onSample). Memory use is independent of @p samples.
+///       Apply a quiet, fixed input (e.g. shorted inputs or a reference)
+///       while the sweep runs.
+inline Status characterizeNoise(ADS1115& device, uint8_t gainMask, uint8_t rateMask,
+                                uint32_t samples, NoiseStats* out, size_t outCapacity,
+                                size_t& written, NoisePointFn onPoint = nullptr,
+                                void* user = nullptr) {
+  written = 0;
+  if (samples < 2) {
+    return Status::Error(Err::INVALID_PARAM, "Need at least two samples");
+  }
+  if (out == nullptr) {
+    return Status::Error(Err::INVALID_PARAM, "Result table missing");
+  }
+
+  static constexpr size_t kChunk = 32;
+  const Gain prevGain = device.getGain();
+  const DataRate prevRate = device.getDataRate();
+  const Mode prevMode = device.getMode();
+  const bool paced = device.conversionReadyPinActive();
+  NoiseAccumulator<> acc;
+  Status result = paced ? Status::Ok() : device.setMode(Mode::SINGLE_SHOT);
+
+  for (uint8_t g = 0; g < 6 && result.ok(); ++g) {
+    if ((gainMask & (1u << g)) == 0) {
+      continue;
+    }
+    Gain gain = static_cast<Gain>(g);
+    result = device.setGain(gain);
+    for (uint8_t r = 0; r < 8 && result.ok(); ++r) {
+      if ((rateMask & (1u << r)) == 0) {
+        continue;
+      }
+      if (written >= outCapacity) {
+        result = Status::Error(Err::INVALID_PARAM, "Result table too small");
+        break;
+      }
+      DataRate rate = static_cast<DataRate>(r);
+      acc.reset();
+      if (paced) {
+        int16_t chunk[kChunk];
+        while (acc.count() < samples) {
+          size_t want = samples - acc.count();
+          if (want > kChunk) {
+            want = kChunk;
+          }
+          BurstStats burst;
+          result = device.readBurst(chunk, want, burst, rate);
+          for (uint32_t i = 0; i < burst.samples; ++i) {
+            acc.add(chunk[i]);
+          }
+          if (!result.ok()) {
+            break;
+          }
+        }
+      } else {
+        result = device.setDataRate(rate);
+        while (result.ok() && acc.count() < samples) {
+          int16_t raw = 0;
+          result = device.readBlocking(raw);
+          if (result.ok()) {
+            acc.add(raw);
+          }
+        }
+      }
+      if (!result.ok()) {
+        break;
+      }
+      NoiseStats& stats = out[written++];
+      acc.summarize(gain, stats);
+      stats.dataRate = rate;
+      if (onPoint != nullptr) {
+        onPoint(stats, acc, user);
+      }
+    }
+  }
+
+  Status restore = device.setGain(prevGain);
+  if (!paced) {
+    Status st = device.setDataRate(prevRate);
+    restore = restore.ok() ? st : restore;
+    st = device.setMode(prevMode);
+    restore = restore.ok() ? st : restore;
+  }
+  return result.ok() ? restore : result;
+}
+
+} // namespace ADS1115
@@ -0,0 +1,193 @@
+/// @file Chopper.h
+/// @brief Excitation-synchronous (chopped) acquisition with integer demodulation
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/ADS1115.h"
+
+namespace ADS1115 {
+
+/// Chopped acquisition settings
+struct ChopConfig {
+  ChannelConfig channel;          ///< Input converted in every phase
+  uint32_t settleUs = 1000;       ///< Wait after each excitation flip
+  uint16_t samplesPerOutput = 4;  ///< Phases per output; rounded up to a multiple of 4
+                                  ///< (at most 65532)
+  bool excitationIdle = false;    ///< Level left on the pin by stop()
+};
+
+/// One demodulated output
+struct ChopOutput {
+  int32_t value = 0;        ///< Demodulated result in codes (sum / samples, rounded)
+  int32_t offset = 0;       ///< Excitation-independent part (thermal EMF, ADC offset)
+  int32_t sum = 0;          ///< Raw demodulated sum, sign(+) phase minus sign(-) phase
+  uint16_t samples = 0;     ///< Conversions in this output
+  uint32_t timestampUs = 0; ///< Time of the last conversion
+  uint32_t seq = 0;         ///< Output counter
+};
+
+/// Called with every completed output
+using ChopOutputFn = void (*)(const ChopOutput& output, void* user);
+
+/// Excitation-synchronous acquisition
+/// @code
+///   cfg.excitationPin = 5;
+///   cfg.gpioWrite = [](int pin, bool level, void*) { digitalWrite(pin, level); };
+///   device.begin(cfg);
+///
+///   ADS1115::ChopConfig chop;
+///   chop.channel = {ADS1115::Mux::AIN0_AIN1, ADS1115::Gain::FSR_0_256V,
+///                   ADS1115::DataRate::SPS_128};
+///   chop.settleUs = 500;
+///   ADS1115::Chopper chopper;
+///   chopper.start(chop, onOutput, nullptr);
+///   // loop():
+///   chopper.poll(device, micros());
+/// @endcode
+/// @note Phases follow + - - + so offsets and linear drift cancel over each
+///       group of four. Excitation HIGH is the + phase. A bridge output
+///       reverses with the excitation while thermocouple EMFs and ADC offset
+///       do not; value is therefore (V+ - V-) / 2 in codes and offset is
+///       (V+ + V-) / 2. Accumulation is integer and per sample.
+class Chopper {
+public:
+  /// Begin chopping; the first phase drives the pin on the next poll()
+  void start(const ChopConfig& config, ChopOutputFn fn = nullptr, void* user = nullptr) {
+    _cfg = config;
+    // 65532 is the largest multiple of 4 that fits; rounding 65533-65535 up
+    // would wrap to 0
+    uint16_t n = _cfg.samplesPerOutput;
+    n = (n < 4) ? 4 : (n > 65532) ? 65532 : n;
+    n = static_cast<uint16_t>((n + 3) & ~3u);
+    _cfg.samplesPerOutput = n;
+    _onOutput = fn;
+    _user = user;
+    _phase = 0;
+    _demodSum = 0;
+    _commonSum = 0;
+    _errors = 0;
+    _outputs = 0;
+    _step = Step::SET_EXCITATION;
+    _running = true;
+  }
+
+  /// Stop and park the excitation pin at ChopConfig::excitationIdle
+  Status stop(ADS1115& device) {
+    _running = false;
+    return device.setExcitation(_cfg.excitationIdle);
+  }
+
+  /// Advance the state machine; call often (non-blocking)
+  Status poll(ADS1115& device, uint32_t nowUs) {
+    if (!_running) {
+      return Status::Ok();
+    }
+    switch (_step) {
+      case Step::SET_EXCITATION: {
+        Status st = device.setExcitation(_positive());
+        if (!st.ok()) {
+          return _fail(st);
+        }
+        _markUs = nowUs;
+        _step = Step::SETTLE;
+        return Status::Ok();
+      }
+      case Step::SETTLE: {
+        if (nowUs - _markUs < _cfg.settleUs) {
+          return Status::Ok();
+        }
+        Status st = device.startConversion(_cfg.channel);
+        if (st.code != Err::IN_PROGRESS) {
+          return _fail(st);
+        }
+        _step = Step::CONVERT;
+        return Status::Ok();
+      }
+      case Step::CONVERT: {
+        if (!device.conversionReady()) {
+          return Status::Ok();
+        }
+        int16_t raw = 0;
+        Status st = device.readRaw(raw);
+        if (st.code == Err::CONVERSION_NOT_READY) {
+          return Status::Ok();
+        }
+        if (!st.ok()) {
+          return _fail(st);
+        }
+        _accumulate(raw, nowUs);
+        _step = Step::SET_EXCITATION;
+        return Status::Ok();
+      }
+    }
+    return Status::Ok();
+  }
+
+  bool running() const { return _running; }
+  const ChopOutput& lastOutput() const { return _last; }
+  uint32_t outputs() const { return _outputs; }
+  uint32_t errors() const { return _errors; }  ///< Failed phases (the group restarts)
+
+private:
+  enum class Step : uint8_t { SET_EXCITATION, SETTLE, CONVERT };
+
+  /// + - - + pattern: phase bit 0 XOR bit 1
+  bool _positive() const { return ((_phase ^ (_phase >> 1)) & 1u) == 0; }
+
+  void _accumulate(int16_t raw, uint32_t nowUs) {
+    if (_positive()) {
+      _demodSum += raw;
+    } else {
+      _demodSum -= raw;
+    }
+    _commonSum += raw;
+    _phase++;
+    if (_phase < _cfg.samplesPerOutput) {
+      return;
+    }
+    // Each phase contributes half of the differential signal
+    int32_t n = static_cast<int32_t>(_phase);
+    _last.sum = _demodSum;
+    _last.samples = _phase;
+    _last.value = _roundDiv(_demodSum, n);
+    _last.offset = _roundDiv(_commonSum, n);
+    _last.timestampUs = nowUs;
+    _last.seq = ++_outputs;
+    _phase = 0;
+    _demodSum = 0;
+    _commonSum = 0;
+    if (_onOutput != nullptr) {
+      _onOutput(_last, _user);
+    }
+  }
+
+  static int32_t _roundDiv(int32_t num, int32_t den) {
+    return (num >= 0) ? (num + den / 2) / den : -((-num + den / 2) / den);
+  }
+
+  Status _fail(const Status& st) {
+    _errors++;
+    _phase = 0;
+    _demodSum = 0;
+    _commonSum = 0;
+    _step = Step::SET_EXCITATION;
+    return st;
+  }
+
+  ChopConfig _cfg;
+  ChopOutput _last;
+  ChopOutputFn _onOutput = nullptr;
+  void* _user = nullptr;
+  int32_t _demodSum = 0;
+  int32_t _commonSum = 0;
+  uint32_t _markUs = 0;
+  uint32_t _outputs = 0;
+  uint32_t _errors = 0;
+  uint16_t _phase = 0;
+  Step _step = Step::SET_EXCITATION;
+  bool _running = false;
+};
+
+} // namespace ADS1115
@@ -16,6 +16,13 @@ static constexpr uint8_t REG_CONFIG     = 0x01;  ///< Configuration register (16
 static constexpr uint8_t REG_LO_THRESH  = 0x02;  ///< Low threshold (16-bit, R/W)
 static constexpr uint8_t REG_HI_THRESH  = 0x03;  ///< High threshold (16-bit, R/W)
 
+// ============================================================================
+// General Call
+// ============================================================================
+
+static constexpr uint8_t GENERAL_CALL_ADDR  = 0x00;  ///< I2C general-call address
+static constexpr uint8_t GENERAL_CALL_RESET = 0x06;  ///< Reset every responding device
+
 // ============================================================================
 // Default Register Values
 // ============================================================================
@@ -116,5 +123,39 @@ static constexpr uint16_t COMP_QUE_ASSERT_2 = 0x0001;
 static constexpr uint16_t COMP_QUE_ASSERT_4 = 0x0002;
 static constexpr uint16_t COMP_QUE_DISABLE  = 0x0003;
 
+// ============================================================================
+// Conversion Timing and Scaling
+// ============================================================================
+
+/// Nominal conversion period (1 / DR) in microseconds, indexed by DR field
+static constexpr uint32_t CONVERSION_US[] = {
+  125000,  // 8 SPS
+  62500,   // 16 SPS
+  31250,   // 32 SPS
+  15625,   // 64 SPS
+  7813,    // 128 SPS
+  4000,    // 250 SPS
+  2106,    // 475 SPS
+  1163     // 860 SPS
+};
+
+/// LSB size in volts, indexed by PGA field (6 and 7 alias 0.256V)
+static constexpr float LSB_VOLTS[] = {
+  187.5e-6f,   // 6.144V
+  125.0e-6f,   // 4.096V
+  62.5e-6f,    // 2.048V
+  31.25e-6f,   // 1.024V
+  15.625e-6f,  // 0.512V
+  7.8125e-6f,  // 0.256V
+  7.8125e-6f,
+  7.8125e-6f
+};
+
+/// Conversion period for DR field value @p dr (out of range reads as 128 SPS)
+constexpr uint32_t conversionUs(uint8_t dr) { return CONVERSION_US[dr < 8 ? dr : 4]; }
+
+/// LSB size for PGA field value @p pga (out of range reads as 2.048V)
+constexpr float lsbVolts(uint8_t pga) { return LSB_VOLTS[pga < 8 ? pga : 2]; }
+
 } // namespace cmd
 } // namespace ADS1115
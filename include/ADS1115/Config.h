@@ -4,8 +4,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "ADS1115/CommandTable.h"
 #include "ADS1115/Status.h"
 
+/// Build flag: set to 1 to compile in the energy estimate (BusConfig::power,
+/// ADS1115::energyStats()). With 0 (default) the model and its counters are
+/// left out of every driver instance and energyStats() reports zeros.
+#ifndef ADS1115_ENERGY
+#define ADS1115_ENERGY 0
+#endif
+
 namespace ADS1115 {
 
 /// I2C write callback signature
@@ -31,12 +39,68 @@ using I2cWriteReadFn = Status (*)(uint8_t addr, const uint8_t* txData, size_t tx
                                   uint8_t* rxData, size_t rxLen, uint32_t timeoutMs,
                                   void* user);
 
+/// I2C read-only callback signature (no pointer-register write)
+/// @param addr     I2C device address (7-bit)
+/// @param rxData   Pointer to buffer for read data
+/// @param rxLen    Number of bytes to read
+/// @param timeoutMs Maximum time to wait for completion
+/// @param user     User context pointer passed through from Config
+/// @return Status indicating success or failure
+using I2cReadFn = Status (*)(uint8_t addr, uint8_t* rxData, size_t rxLen,
+                             uint32_t timeoutMs, void* user);
+
+/// Kind of one batched I2C operation
+enum class I2cOpType : uint8_t {
+  WRITE      = 0,  ///< tx only
+  WRITE_READ = 1,  ///< tx, repeated START, rx
+  READ       = 2   ///< rx only (current pointer register)
+};
+
+/// One register operation in a batch
+struct I2cOp {
+  I2cOpType type = I2cOpType::WRITE;
+  uint8_t addr = 0;            ///< I2C device address (7-bit); may differ per op
+  const uint8_t* tx = nullptr;
+  size_t txLen = 0;
+  uint8_t* rx = nullptr;
+  size_t rxLen = 0;
+};
+
+/// Batched I2C callback signature
+/// @param ops      Operations to execute in order, as one controller sequence
+///                 where the platform supports it
+/// @param count    Number of operations
+/// @param timeoutMs Maximum time for the whole batch
+/// @param user     User context pointer passed through from Config
+/// @return OK if every operation succeeded, otherwise the first failure
+using I2cBatchFn = Status (*)(const I2cOp* ops, size_t count, uint32_t timeoutMs,
+                              void* user);
+
 /// GPIO read callback signature (for ALERT/RDY pin)
 /// @param pin      GPIO pin number
 /// @param user     User context pointer passed through from Config
 /// @return true if pin level is HIGH, false if LOW
 using GpioReadFn = bool (*)(int pin, void* user);
 
+/// GPIO write callback signature (for the excitation output)
+/// @param pin      GPIO pin number
+/// @param level    true = HIGH, false = LOW
+/// @param user     User context pointer passed through from Config
+using GpioWriteFn = void (*)(int pin, bool level, void* user);
+
+struct Sample;
+
+/// Sample callback signature (called after every successful readRaw())
+/// @param sample   Completed conversion
+/// @param user     User context pointer passed through from Config
+using SampleFn = void (*)(const Sample& sample, void* user);
+
+/// Sample sink backpressure query (called before starting acquisition)
+/// @param user     Config::sampleUser
+/// @return true while the sink cannot take more samples; the driver then
+///         stops starting conversions and leaves continuous mode
+using BackpressureFn = bool (*)(void* user);
+
 /// Input multiplexer configuration
 enum class Mux : uint8_t {
   AIN0_AIN1 = 0,  ///< Differential: AIN0 - AIN1 (default)
@@ -71,6 +135,14 @@ enum class DataRate : uint8_t {
   SPS_860 = 7    ///< 860 SPS
 };
 
+/// LSB size in volts for a PGA setting
+constexpr float lsbVolts(Gain gain) { return cmd::lsbVolts(static_cast<uint8_t>(gain)); }
+
+/// Nominal conversion time (1 / DR) in microseconds
+constexpr uint32_t conversionTimeUs(DataRate rate) {
+  return cmd::conversionUs(static_cast<uint8_t>(rate));
+}
+
 /// Operating mode
 enum class Mode : uint8_t {
   CONTINUOUS  = 0,  ///< Continuous conversion mode
@@ -103,16 +175,64 @@ enum class ComparatorQueue : uint8_t {
   DISABLE  = 3   ///< Disable comparator (default), ALERT/RDY high-Z
 };
 
-/// Configuration for ADS1115 driver
-struct Config {
+/// Per-conversion input settings (one logical channel)
+struct ChannelConfig {
+  Mux mux = Mux::AIN0_GND;
+  Gain gain = Gain::FSR_2_048V;
+  DataRate dataRate = DataRate::SPS_128;
+};
+
+/// Supply figures for the optional energy estimate
+/// @note Defaults are datasheet typical values at VDD = 3.3 V. The I2C figure
+///       approximates two 4.7 kOhm pull-ups held low about half the time.
+struct PowerModel {
+  bool enabled = false;                  ///< Accumulate EnergyStats
+  uint16_t supplyMv = 3300;              ///< VDD in millivolts
+  uint32_t convertingCurrentNa = 150000; ///< IDD while converting (150 uA typ)
+  uint32_t powerDownCurrentNa = 500;     ///< IDD in power-down (0.5 uA typ)
+  uint32_t i2cCurrentNa = 700000;        ///< Average bus current during I2C activity
+  uint32_t i2cClockHz = 400000;          ///< SCL rate used to convert bytes to time
+};
+
+/// Transport and board-level settings shared by every device on one I2C bus
+/// @note When referenced through Config::bus it must outlive every driver
+///       that uses it.
+struct BusConfig {
+  // Pointers first, then the narrower fields, so the struct packs without holes.
+
   // === I2C Transport (required) ===
   I2cWriteFn i2cWrite = nullptr;
   I2cWriteReadFn i2cWriteRead = nullptr;
   void* i2cUser = nullptr;
 
+  // === I2C Read-Only Transport (optional) ===
+  I2cReadFn i2cRead = nullptr;     ///< Lets readBurst() reuse the pointer register
+
+  // === Batched Transport (optional) ===
+  I2cBatchFn i2cBatch = nullptr;   ///< Multi-operation sequences in one call
+
+  // === GPIO access (optional) ===
+  GpioReadFn gpioRead = nullptr;   ///< ALERT/RDY input
+  GpioWriteFn gpioWrite = nullptr; ///< Excitation output
+  void* gpioUser = nullptr;
+
+  uint32_t i2cTimeoutMs = 50;      ///< I2C transaction timeout in ms
+
+  // === Preemption (optional) ===
+  /// Allow preemptConversion() to abort a conversion with an I2C general-call
+  /// reset. This resets EVERY general-call capable device on the bus.
+  bool allowGeneralCallReset = false;
+
+#if ADS1115_ENERGY
+  // === Energy Estimate (optional) ===
+  PowerModel power;                ///< Disabled by default
+#endif
+};
+
+/// Per-device settings
+struct DeviceConfig {
   // === Device Settings ===
   uint8_t i2cAddress = 0x48;       ///< 0x48-0x4B based on ADDR pin
-  uint32_t i2cTimeoutMs = 50;      ///< I2C transaction timeout in ms
 
   // === Conversion Settings ===
   Mux mux = Mux::AIN0_GND;               ///< Input multiplexer
@@ -128,13 +248,28 @@ struct Config {
   int16_t compThresholdHigh = 0x7FFF;  ///< High threshold (default: max)
   int16_t compThresholdLow = 0x8000;   ///< Low threshold (default: min)
 
+  // === Health Tracking ===
+  uint8_t offlineThreshold = 5;    ///< Consecutive failures before OFFLINE
+
   // === ALERT/RDY Pin (optional) ===
   int alertRdyPin = -1;        ///< GPIO pin for ALERT/RDY; -1 means not used
-  GpioReadFn gpioRead = nullptr;
-  void* gpioUser = nullptr;
 
-  // === Health Tracking ===
-  uint8_t offlineThreshold = 5;    ///< Consecutive failures before OFFLINE
+  // === Excitation Pin (optional) ===
+  int excitationPin = -1;      ///< GPIO driving bridge excitation polarity; -1 = not used
+
+  // === Sample Hook (optional) ===
+  SampleFn onSample = nullptr;     ///< Called with each completed conversion
+  BackpressureFn sampleBackpressure = nullptr;  ///< Optional pause request from the sink
+  void* sampleUser = nullptr;
+};
+
+/// Configuration for ADS1115 driver
+/// @note Fields are inherited from BusConfig and DeviceConfig, so
+///       cfg.i2cWrite, cfg.mux etc. are set directly. Several devices on one
+///       bus can instead point @ref bus at a single shared BusConfig; the
+///       inline transport fields are then ignored.
+struct Config : BusConfig, DeviceConfig {
+  const BusConfig* bus = nullptr;  ///< Optional shared transport (see note)
 };
 
 } // namespace ADS1115
@@ -0,0 +1,147 @@
+/// @file DeadBand.h
+/// @brief Report-by-exception filter: pass a sample only when it moved enough
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/Config.h"
+#include "ADS1115/Sample.h"
+
+namespace ADS1115 {
+
+/// Per-channel dead-band counters
+struct DeadBandStats {
+  uint32_t reported = 0;    ///< Samples passed on (including heartbeats)
+  uint32_t suppressed = 0;  ///< Samples inside the dead band
+  uint32_t heartbeats = 0;  ///< Passed only because maxSilenceUs expired
+};
+
+/// Dead-band reporting, one band per mux setting
+/// @code
+///   ADS1115::DeadBand band;
+///   band.setThresholdVolts(ADS1115::Mux::AIN0_GND, 0.005f, ADS1115::Gain::FSR_2_048V);
+///   band.setMaxSilenceUs(ADS1115::Mux::AIN0_GND, 10000000);  // 10 s heartbeat
+///   pipeline.addStage("deadband", ADS1115::DeadBand::stage, &band);
+/// @endcode
+/// @note A sample is reported when |raw - last reported raw| > threshold, when
+///       the gain differs from the last report, or when maxSilenceUs has
+///       elapsed since the last report (flagged SampleFlag::HEARTBEAT). The
+///       first sample of every channel is always reported. A threshold of 0
+///       reports every change. A SampleFlag::GAP on a suppressed sample is
+///       carried over to the next reported sample of the channel.
+class DeadBand {
+public:
+  static constexpr size_t kChannels = 8;  ///< One band per Mux value
+
+  /// Set the band in raw codes
+  void setThreshold(Mux mux, uint16_t codes) {
+    size_t ch = static_cast<size_t>(mux);
+    if (ch < kChannels) {
+      _channels[ch].thresholdCodes = codes;
+    }
+  }
+
+  /// Set the band in volts, converted with the LSB of @p gain
+  void setThresholdVolts(Mux mux, float volts, Gain gain) {
+    float codes = volts / lsbVolts(gain);
+    if (codes < 0.0f) {
+      codes = -codes;
+    }
+    setThreshold(mux, codes >= 65535.0f ? 0xFFFF : static_cast<uint16_t>(codes));
+  }
+
+  /// Heartbeat period; 0 disables the heartbeat
+  void setMaxSilenceUs(Mux mux, uint32_t us) {
+    size_t ch = static_cast<size_t>(mux);
+    if (ch < kChannels) {
+      _channels[ch].maxSilenceUs = us;
+    }
+  }
+
+  /// Decide whether @p sample is reported; sets SampleFlag::HEARTBEAT on it
+  /// when only the heartbeat let it through
+  bool accept(Sample& sample) {
+    size_t ch = static_cast<size_t>(sample.mux);
+    if (ch >= kChannels) {
+      return true;
+    }
+    Channel& c = _channels[ch];
+    bool report = !c.hasReported || sample.gain != c.gain;
+    if (!report) {
+      int32_t delta = static_cast<int32_t>(sample.raw) - c.lastRaw;
+      if (delta < 0) {
+        delta = -delta;
+      }
+      report = delta > static_cast<int32_t>(c.thresholdCodes);
+    }
+    if (!report && c.maxSilenceUs != 0 &&
+        (sample.timestampUs - c.lastReportUs) >= c.maxSilenceUs) {
+      report = true;
+      sample.flags |= SampleFlag::HEARTBEAT;
+      c.stats.heartbeats++;
+    }
+    if (!report) {
+      c.gapPending = c.gapPending || (sample.flags & SampleFlag::GAP) != 0;
+      c.stats.suppressed++;
+      return false;
+    }
+    if (c.gapPending) {
+      sample.flags |= SampleFlag::GAP;
+      c.gapPending = false;
+    }
+    c.hasReported = true;
+    c.lastRaw = sample.raw;
+    c.gain = sample.gain;
+    c.lastReportUs = sample.timestampUs;
+    c.stats.reported++;
+    return true;
+  }
+
+  DeadBandStats stats(Mux mux) const {
+    size_t ch = static_cast<size_t>(mux);
+    return (ch < kChannels) ? _channels[ch].stats : DeadBandStats{};
+  }
+
+  /// Clear counters; keep thresholds
+  void resetStats() {
+    for (size_t i = 0; i < kChannels; ++i) {
+      _channels[i].stats = DeadBandStats{};
+    }
+  }
+
+  /// Forget the last reported values so every channel reports again
+  void rearm() {
+    for (size_t i = 0; i < kChannels; ++i) {
+      _channels[i].hasReported = false;
+    }
+  }
+
+  /// Pipeline StageFn adapter; ctx must point to a DeadBand
+  static size_t stage(Sample* samples, size_t count, void* ctx) {
+    DeadBand* band = static_cast<DeadBand*>(ctx);
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (band->accept(samples[i])) {
+        samples[kept++] = samples[i];
+      }
+    }
+    return kept;
+  }
+
+private:
+  struct Channel {
+    DeadBandStats stats;
+    uint32_t lastReportUs = 0;
+    uint32_t maxSilenceUs = 0;
+    uint16_t thresholdCodes = 0;
+    int16_t lastRaw = 0;
+    Gain gain = Gain::FSR_2_048V;
+    bool hasReported = false;
+    bool gapPending = false;  ///< A suppressed sample carried SampleFlag::GAP
+  };
+
+  Channel _channels[kChannels];
+};
+
+} // namespace ADS1115
@@ -0,0 +1,197 @@
+/// @file JitterStats.h
+/// @brief Fixed-size inter-sample interval (jitter) statistics
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/Config.h"
+#include "ADS1115/Sample.h"
+
+namespace ADS1115 {
+
+/// Interval statistics snapshot
+struct JitterSummary {
+  uint32_t count = 0;     ///< Intervals recorded
+  float meanUs = 0.0f;    ///< Mean interval
+  float stddevUs = 0.0f;  ///< Standard deviation of the interval
+  uint32_t minUs = 0;     ///< Shortest interval
+  uint32_t p99Us = 0;     ///< 99th percentile (resolution: one bin)
+  uint32_t maxUs = 0;     ///< Longest interval
+};
+
+/// Streaming statistics over one stream of intervals
+/// @tparam Bins Histogram bins used for the percentile
+/// @note The histogram is centred on the nominal period passed to reset()
+///       (or, without one, on the first interval seen) and is Bins * binUs
+///       wide; intervals outside it only contribute through max/min and the
+///       moments. Moments are accumulated in double relative to the centre,
+///       so they stay exact near it and cannot overflow for far outliers.
+template <size_t Bins = 32>
+class IntervalStats {
+public:
+  static_assert(Bins >= 2, "IntervalStats needs at least two bins");
+
+  /// @param binUs     Histogram bin width
+  /// @param nominalUs Expected interval to centre the histogram on; 0 uses
+  ///                  the first interval, which is often a startup outlier
+  void reset(uint16_t binUs = 10, uint32_t nominalUs = 0) {
+    _binUs = (binUs == 0) ? 1 : binUs;
+    _nominalUs = nominalUs;
+    _count = 0;
+    _refUs = nominalUs;
+    _sumDev = 0.0;
+    _sumDevSq = 0.0;
+    _minUs = 0;
+    _maxUs = 0;
+    _below = 0;
+    _above = 0;
+    for (size_t i = 0; i < Bins; ++i) {
+      _bins[i] = 0;
+    }
+  }
+
+  void add(uint32_t intervalUs) {
+    if (_count == 0) {
+      _refUs = (_nominalUs != 0) ? _nominalUs : intervalUs;
+      _minUs = intervalUs;
+      _maxUs = intervalUs;
+    }
+    if (_count < UINT32_MAX) {
+      _count++;
+    }
+    int64_t dev = static_cast<int64_t>(intervalUs) - _refUs;
+    _sumDev += static_cast<double>(dev);
+    _sumDevSq += static_cast<double>(dev) * static_cast<double>(dev);
+    if (intervalUs < _minUs) {
+      _minUs = intervalUs;
+    }
+    if (intervalUs > _maxUs) {
+      _maxUs = intervalUs;
+    }
+
+    int64_t offset = dev + static_cast<int64_t>(Bins / 2) * _binUs;
+    if (offset < 0) {
+      _below++;
+    } else if (offset >= static_cast<int64_t>(Bins) * _binUs) {
+      _above++;
+    } else {
+      _bins[offset / _binUs]++;
+    }
+  }
+
+  JitterSummary summary() const {
+    JitterSummary out;
+    out.count = _count;
+    if (_count == 0) {
+      return out;
+    }
+    double n = static_cast<double>(_count);
+    double meanDev = _sumDev / n;
+    out.meanUs = static_cast<float>(_refUs + meanDev);
+    if (_count > 1) {
+      double var = (_sumDevSq - meanDev * _sumDev) / (n - 1.0);
+      out.stddevUs = static_cast<float>(var > 0.0 ? std::sqrt(var) : 0.0);
+    }
+    out.minUs = _minUs;
+    out.maxUs = _maxUs;
+
+    // Smallest bin upper edge with at least 99% of intervals at or below it
+    uint64_t target = (static_cast<uint64_t>(_count) * 99 + 99) / 100;
+    uint64_t seen = _below;
+    out.p99Us = _maxUs;
+    if (seen >= target) {
+      out.p99Us = _edgeUs(0);
+      return out;
+    }
+    for (size_t i = 0; i < Bins; ++i) {
+      seen += _bins[i];
+      if (seen >= target) {
+        out.p99Us = _edgeUs(i + 1);
+        if (out.p99Us > _maxUs) {
+          out.p99Us = _maxUs;
+        }
+        break;
+      }
+    }
+    return out;
+  }
+
+private:
+  /// Lower edge of bin @p index (index == Bins is the top edge)
+  uint32_t _edgeUs(size_t index) const {
+    int64_t edge = static_cast<int64_t>(_refUs) +
+                   (static_cast<int64_t>(index) - static_cast<int64_t>(Bins / 2)) * _binUs;
+    return static_cast<uint32_t>(edge < 0 ? 0 : edge);
+  }
+
+  uint32_t _bins[Bins] = {};
+  double _sumDev = 0.0;
+  double _sumDevSq = 0.0;
+  uint32_t _count = 0;
+  uint32_t _refUs = 0;
+  uint32_t _nominalUs = 0;
+  uint32_t _minUs = 0;
+  uint32_t _maxUs = 0;
+  uint32_t _below = 0;
+  uint32_t _above = 0;
+  uint16_t _binUs = 10;
+};
+
+/// Per-channel jitter monitor fed from the driver's sample hook
+/// @code
+///   ADS1115::JitterMonitor<> jitter;
+///   cfg.onSample = ADS1115::JitterMonitor<>::onSample;
+///   cfg.sampleUser = &jitter;
+/// @endcode
+/// @note Intervals are measured between consecutive samples of the same mux
+///       setting using Sample::timestampUs. An interval ending at a sample
+///       flagged SampleFlag::GAP spans a loss or an acquisition pause and is
+///       skipped.
+template <size_t Bins = 32>
+class JitterMonitor {
+public:
+  static constexpr size_t kChannels = 8;  ///< One slot per Mux value
+
+  JitterMonitor() { reset(); }
+
+  /// @param binUs     Histogram bin width
+  /// @param nominalUs Expected sampling period of every channel (0 = unknown)
+  void reset(uint16_t binUs = 10, uint32_t nominalUs = 0) {
+    for (size_t i = 0; i < kChannels; ++i) {
+      _stats[i].reset(binUs, nominalUs);
+      _lastUs[i] = 0;
+      _seen[i] = false;
+    }
+  }
+
+  void record(const Sample& sample) {
+    size_t ch = static_cast<size_t>(sample.mux);
+    if (ch >= kChannels) {
+      return;
+    }
+    if (_seen[ch] && (sample.flags & SampleFlag::GAP) == 0) {
+      _stats[ch].add(sample.timestampUs - _lastUs[ch]);
+    }
+    _lastUs[ch] = sample.timestampUs;
+    _seen[ch] = true;
+  }
+
+  JitterSummary summary(Mux mux) const {
+    size_t ch = static_cast<size_t>(mux);
+    return (ch < kChannels) ? _stats[ch].summary() : JitterSummary{};
+  }
+
+  /// SampleFn adapter; user must point to this monitor
+  static void onSample(const Sample& sample, void* user) {
+    static_cast<JitterMonitor*>(user)->record(sample);
+  }
+
+private:
+  IntervalStats<Bins> _stats[kChannels];
+  uint32_t _lastUs[kChannels] = {};
+  bool _seen[kChannels] = {};
+};
+
+} // namespace ADS1115
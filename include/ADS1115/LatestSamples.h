@@ -0,0 +1,101 @@
+/// @file LatestSamples.h
+/// @brief Lock-free latest-sample board, one seqlock slot per channel
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/Config.h"
+#include "ADS1115/Sample.h"
+
+namespace ADS1115 {
+
+/// Latest completed conversion per mux setting, published with a seqlock
+/// @code
+///   ADS1115::LatestSamples latest;          // static storage, outlives the driver
+///   cfg.onSample = ADS1115::LatestSamples::onSample;
+///   cfg.sampleUser = &latest;
+///
+///   // Any task, any core, no bus traffic:
+///   ADS1115::Sample s;
+///   if (latest.read(ADS1115::Mux::AIN0_GND, s)) { float v = s.volts(); }
+/// @endcode
+/// @note Single writer (the task driving the ADS1115), any number of readers.
+///       Readers never block the writer; they retry if a publish overlaps the
+///       read. Slot fields are 32-bit atomics, which are lock-free on ESP32.
+class LatestSamples {
+public:
+  static constexpr size_t kChannels = 8;  ///< One slot per Mux value
+
+  /// Writer side; call from one context only
+  void publish(const Sample& sample) {
+    size_t ch = static_cast<size_t>(sample.mux);
+    if (ch >= kChannels) {
+      return;
+    }
+    Slot& slot = _slots[ch];
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);  // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestampUs.store(sample.timestampUs, std::memory_order_relaxed);
+    slot.sampleSeq.store(sample.seq, std::memory_order_relaxed);
+    slot.packed.store(packSample(sample), std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+  }
+
+  /// Copy the latest sample of @p mux into @p out
+  /// @param maxRetries Attempts before giving up on a slot being rewritten
+  /// @return false if nothing was published yet or every attempt overlapped a write
+  bool read(Mux mux, Sample& out, uint8_t maxRetries = 8) const {
+    size_t ch = static_cast<size_t>(mux);
+    if (ch >= kChannels) {
+      return false;
+    }
+    const Slot& slot = _slots[ch];
+    for (uint8_t attempt = 0; attempt <= maxRetries; ++attempt) {
+      uint32_t before = slot.seq.load(std::memory_order_acquire);
+      if (before == 0) {
+        return false;
+      }
+      if (before & 1u) {
+        continue;
+      }
+      uint32_t timestampUs = slot.timestampUs.load(std::memory_order_relaxed);
+      uint32_t sampleSeq = slot.sampleSeq.load(std::memory_order_relaxed);
+      uint32_t packed = slot.packed.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      out.timestampUs = timestampUs;
+      out.seq = sampleSeq;
+      unpackSample(packed, out);
+      return true;
+    }
+    return false;
+  }
+
+  /// Number of publishes to @p mux so far (0 = never); cheap change detection
+  uint32_t version(Mux mux) const {
+    size_t ch = static_cast<size_t>(mux);
+    return (ch < kChannels) ? (_slots[ch].seq.load(std::memory_order_acquire) >> 1) : 0;
+  }
+
+  /// SampleFn adapter; user must point to this board
+  static void onSample(const Sample& sample, void* user) {
+    static_cast<LatestSamples*>(user)->publish(sample);
+  }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> timestampUs{0};
+    std::atomic<uint32_t> sampleSeq{0};
+    std::atomic<uint32_t> packed{0};  ///< packSample()
+  };
+
+  Slot _slots[kChannels];
+};
+
+} // namespace ADS1115
@@ -0,0 +1,352 @@
+/// @file Pipeline.h
+/// @brief Acquisition/processing split: SPSC sample ring plus a stage chain
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/Config.h"
+#include "ADS1115/Sample.h"
+#include "ADS1115/Status.h"
+
+namespace ADS1115 {
+
+/// Processing stage callback
+/// @param samples  Batch to transform in place
+/// @param count    Number of valid samples in @p samples
+/// @param ctx      Stage context registered with addStage()
+/// @return Number of samples passed on (compact kept samples to the front);
+///         0 ends the chain for this batch
+using StageFn = size_t (*)(Sample* samples, size_t count, void* ctx);
+
+/// Free-running cycle (or tick) counter used for stage accounting
+/// @note On ESP32 use the CPU cycle counter, e.g. `[] { return ESP.getCycleCount(); }`
+using CycleCountFn = uint32_t (*)();
+
+/// What Pipeline::push() does when the ring is full
+enum class OverflowPolicy : uint8_t {
+  DROP_NEWEST = 0,  ///< Refuse the incoming sample (default)
+  DROP_OLDEST,      ///< Discard the oldest queued sample to make room
+  PAUSE             ///< Ask the driver to stop acquiring (Pipeline::backpressure)
+};
+
+/// Per-stage load counters
+struct StageStats {
+  uint32_t calls = 0;    ///< Batches the stage ran on
+  uint32_t samples = 0;  ///< Samples handed to the stage
+  uint64_t cycles = 0;   ///< Sum of CycleCountFn deltas spent in the stage
+  uint32_t maxCycles = 0;  ///< Longest single call
+};
+
+/// Lock-free single-producer / single-consumer ring of samples
+/// @note pushOverwrite() lets the producer rewrite a slot the consumer may be
+///       copying. Slots therefore hold the sample as three 32-bit atomics
+///       (timestamp, seq, packSample()), so an overlapping copy is not a data
+///       race, and the tail is the sequence check: the producer advances it
+///       before rewriting the oldest slot, and pop() copies first and then
+///       claims the range with a compare-exchange. A failed exchange means
+///       part of the copy may be torn, so it is discarded and retried.
+/// @tparam Capacity Power of two
+template <size_t Capacity>
+class SampleRing {
+public:
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SampleRing capacity must be a power of two");
+
+  /// Producer side
+  bool push(const Sample& sample) {
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    if (head - tail >= Capacity) {
+      return false;
+    }
+    _store(head, sample);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Producer side; discards the oldest sample when the ring is full
+  /// @return true if a sample was discarded
+  bool pushOverwrite(const Sample& sample) {
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    bool discarded = false;
+    while (head - tail >= Capacity) {
+      if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        discarded = true;
+        break;
+      }
+    }
+    _store(head, sample);
+    _head.store(head + 1, std::memory_order_release);
+    return discarded;
+  }
+
+  /// Consumer side; copies up to @p max samples into @p out
+  /// @param lost Set to the samples discarded by pushOverwrite() since the
+  ///             previous pop; out[0] then carries SampleFlag::GAP
+  size_t pop(Sample* out, size_t max, uint32_t* lost = nullptr) {
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    size_t n = 0;
+    do {
+      uint32_t head = _head.load(std::memory_order_acquire);
+      n = head - tail;
+      if (n > max) {
+        n = max;
+      }
+      for (size_t i = 0; i < n; ++i) {
+        _load(tail + static_cast<uint32_t>(i), out[i]);
+      }
+    } while (!_tail.compare_exchange_weak(tail, tail + static_cast<uint32_t>(n),
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire));
+    uint32_t skipped = 0;
+    if (n > 0) {
+      skipped = tail - _expectedTail;
+      if (skipped > 0) {
+        out[0].flags |= SampleFlag::GAP;
+      }
+      _expectedTail = tail + static_cast<uint32_t>(n);
+    }
+    if (lost != nullptr) {
+      *lost = skipped;
+    }
+    return n;
+  }
+
+  /// Samples waiting (approximate when called from a third context)
+  size_t size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> timestampUs{0};
+    std::atomic<uint32_t> sampleSeq{0};
+    std::atomic<uint32_t> packed{0};  ///< packSample()
+  };
+
+  void _store(uint32_t index, const Sample& sample) {
+    Slot& slot = _items[index & (Capacity - 1)];
+    slot.timestampUs.store(sample.timestampUs, std::memory_order_relaxed);
+    slot.sampleSeq.store(sample.seq, std::memory_order_relaxed);
+    slot.packed.store(packSample(sample), std::memory_order_relaxed);
+  }
+
+  void _load(uint32_t index, Sample& out) const {
+    const Slot& slot = _items[index & (Capacity - 1)];
+    out.timestampUs = slot.timestampUs.load(std::memory_order_relaxed);
+    out.seq = slot.sampleSeq.load(std::memory_order_relaxed);
+    unpackSample(slot.packed.load(std::memory_order_relaxed), out);
+  }
+
+  Slot _items[Capacity];
+  std::atomic<uint32_t> _head{0};  ///< Written by the producer only
+  std::atomic<uint32_t> _tail{0};  ///< Consumer; producer too in pushOverwrite()
+  uint32_t _expectedTail = 0;      ///< Consumer only: tail after the previous pop
+};
+
+/// Two-sided sample pipeline
+/// @code
+///   ADS1115::Pipeline<> pipeline;
+///   pipeline.setCycleCounter([] { return ESP.getCycleCount(); });
+///   pipeline.addStage("filter", filterStage, &filterState);
+///   pipeline.addStage("pack", packStage, &packer);
+///   cfg.onSample = ADS1115::Pipeline<>::onSample;   // acquisition core
+///   cfg.sampleUser = &pipeline;
+///   // processing core:
+///   while (pipeline.process() > 0) {}
+/// @endcode
+/// @note Configure stages and the overflow policy before either side runs.
+///       push() and backpressure() belong to the acquisition context,
+///       process() and the stats to the processing context; stats read from
+///       elsewhere are diagnostic and may tear.
+/// @tparam RingSize  Ring capacity in samples (power of two)
+/// @tparam MaxStages Maximum chain length
+/// @tparam BatchSize Samples handed to the chain per process() call
+template <size_t RingSize = 256, size_t MaxStages = 8, size_t BatchSize = 32>
+class Pipeline {
+public:
+  static_assert(MaxStages > 0 && BatchSize > 0, "Pipeline needs stages and a batch");
+
+  /// Append a stage; stages run in the order they were added
+  Status addStage(const char* name, StageFn fn, void* ctx) {
+    if (fn == nullptr) {
+      return Status::Error(Err::INVALID_PARAM, "Stage function is null");
+    }
+    if (_stageCount >= MaxStages) {
+      return Status::Error(Err::INVALID_CONFIG, "Too many pipeline stages");
+    }
+    _stages[_stageCount] = Stage{name ? name : "", fn, ctx};
+    _stats[_stageCount] = StageStats{};
+    _stageCount++;
+    return Status::Ok();
+  }
+
+  /// Set the counter used for per-stage cycle accounting (nullptr disables it)
+  void setCycleCounter(CycleCountFn fn) { _cycleCount = fn; }
+
+  /// Choose what push() does when the ring is full
+  /// @note With PAUSE, also set Config::sampleBackpressure = backpressure so
+  ///       the driver stops acquiring before the ring fills; anything pushed
+  ///       into a full ring is then refused as with DROP_NEWEST.
+  void setOverflowPolicy(OverflowPolicy policy) { _policy = policy; }
+  OverflowPolicy overflowPolicy() const { return _policy; }
+
+  // === Acquisition side ===
+
+  /// Queue one sample, applying the overflow policy when the ring is full
+  /// @return false if @p sample itself was dropped
+  /// @note The first sample queued after a loss carries SampleFlag::GAP.
+  bool push(const Sample& sample) {
+    if (_policy == OverflowPolicy::DROP_OLDEST) {
+      if (_ring.pushOverwrite(sample)) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+      return true;
+    }
+    if (!_gapPending) {
+      if (_ring.push(sample)) {
+        return true;
+      }
+    } else {
+      Sample marked = sample;
+      marked.flags |= SampleFlag::GAP;
+      if (_ring.push(marked)) {
+        _gapPending = false;
+        _gaps.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    _gapPending = true;
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// Queue a block of samples
+  /// @return Number queued (the rest were dropped)
+  size_t push(const Sample* samples, size_t count) {
+    size_t queued = 0;
+    while (queued < count && push(samples[queued])) {
+      queued++;
+    }
+    if (queued < count) {
+      _dropped.fetch_add(static_cast<uint32_t>(count - queued - 1), std::memory_order_relaxed);
+    }
+    return queued;
+  }
+
+  /// SampleFn adapter; user must point to this pipeline
+  static void onSample(const Sample& sample, void* user) {
+    static_cast<Pipeline*>(user)->push(sample);
+  }
+
+  /// BackpressureFn adapter (Config::sampleBackpressure); user must point to
+  /// this pipeline
+  /// @return true under the PAUSE policy from when the ring is 7/8 full until
+  ///         it has drained to half; the slack absorbs a conversion already
+  ///         in flight when the pause starts
+  static bool backpressure(void* user) {
+    Pipeline* self = static_cast<Pipeline*>(user);
+    if (self->_policy != OverflowPolicy::PAUSE) {
+      return false;
+    }
+    size_t backlog = self->_ring.size();
+    if (self->_paused) {
+      self->_paused = backlog > RingSize / 2;
+    } else if (backlog >= RingSize - RingSize / 8) {
+      self->_paused = true;
+      self->_pauses.fetch_add(1, std::memory_order_relaxed);
+    }
+    return self->_paused;
+  }
+
+  // === Processing side ===
+
+  /// Pop one batch and run it through the chain
+  /// @return Samples taken from the ring (0 when it was empty)
+  size_t process() {
+    uint32_t lost = 0;
+    size_t count = _ring.pop(_batch, BatchSize, &lost);
+    if (count == 0) {
+      return 0;
+    }
+    if (lost > 0) {
+      _gaps.fetch_add(1, std::memory_order_relaxed);
+    }
+    size_t live = count;
+    for (size_t i = 0; i < _stageCount && live > 0; ++i) {
+      StageStats& st = _stats[i];
+      uint32_t start = _cycleCount ? _cycleCount() : 0;
+      size_t out = _stages[i].fn(_batch, live, _stages[i].ctx);
+      if (_cycleCount) {
+        uint32_t spent = _cycleCount() - start;
+        st.cycles += spent;
+        if (spent > st.maxCycles) {
+          st.maxCycles = spent;
+        }
+      }
+      st.calls++;
+      st.samples += static_cast<uint32_t>(live);
+      live = (out < live) ? out : live;
+    }
+    _processed += static_cast<uint32_t>(count);
+    return count;
+  }
+
+  size_t stageCount() const { return _stageCount; }
+  const char* stageName(size_t index) const {
+    return (index < _stageCount) ? _stages[index].name : "";
+  }
+  StageStats stageStats(size_t index) const {
+    return (index < _stageCount) ? _stats[index] : StageStats{};
+  }
+
+  uint32_t processed() const { return _processed; }   ///< Samples run through the chain
+  /// Samples lost to a full ring (incoming under DROP_NEWEST / PAUSE, oldest
+  /// under DROP_OLDEST)
+  uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+  /// Samples delivered with SampleFlag::GAP because of a loss in this pipeline
+  uint32_t gaps() const { return _gaps.load(std::memory_order_relaxed); }
+  /// Times backpressure() started a pause
+  uint32_t pauses() const { return _pauses.load(std::memory_order_relaxed); }
+  size_t backlog() const { return _ring.size(); }     ///< Samples waiting in the ring
+
+  /// Clear stage, drop, gap and pause counters (processing side)
+  void resetStats() {
+    for (size_t i = 0; i < _stageCount; ++i) {
+      _stats[i] = StageStats{};
+    }
+    _processed = 0;
+    _dropped.store(0, std::memory_order_relaxed);
+    _gaps.store(0, std::memory_order_relaxed);
+    _pauses.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  struct Stage {
+    const char* name;
+    StageFn fn;
+    void* ctx;
+  };
+
+  SampleRing<RingSize> _ring;
+  Sample _batch[BatchSize];
+  Stage _stages[MaxStages] = {};
+  StageStats _stats[MaxStages] = {};
+  CycleCountFn _cycleCount = nullptr;
+  size_t _stageCount = 0;
+  uint32_t _processed = 0;
+  std::atomic<uint32_t> _dropped{0};
+  std::atomic<uint32_t> _gaps{0};
+  std::atomic<uint32_t> _pauses{0};
+  OverflowPolicy _policy = OverflowPolicy::DROP_NEWEST;
+  bool _gapPending = false;  ///< Acquisition side: mark the next queued sample
+  bool _paused = false;      ///< Acquisition side: backpressure() state
+};
+
+} // namespace ADS1115
@@ -0,0 +1,208 @@
+/// @file Planner.h
+/// @brief Pick Gain / DataRate / oversampling from bandwidth, noise and latency targets
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/Characterize.h"
+#include "ADS1115/Config.h"
+#include "ADS1115/Sample.h"
+#include "ADS1115/Status.h"
+
+namespace ADS1115 {
+
+/// What a channel needs
+struct ChannelRequirement {
+  Mux mux = Mux::AIN0_GND;
+  float maxInputV = 2.048f;   ///< Largest |input| that must not clip
+  float bandwidthHz = 1.0f;   ///< Required -3 dB signal bandwidth
+  float noiseUvRms = 0.0f;    ///< Maximum RMS noise; 0 = don't care
+  float maxLatencyMs = 0.0f;  ///< Maximum time to produce one output; 0 = don't care
+};
+
+/// Settings chosen for one channel
+struct ChannelPlan {
+  ChannelConfig config;        ///< Mux, gain and data rate to convert with
+  uint16_t oversample = 1;     ///< Conversions averaged per output
+  float outputRateHz = 0.0f;   ///< Outputs per second needed for the bandwidth
+  float bandwidthHz = 0.0f;    ///< -3 dB bandwidth of one averaged output
+  float noiseUvRms = 0.0f;     ///< Expected RMS noise of one output
+  float latencyMs = 0.0f;      ///< Conversion time of one output
+  float adcLoad = 0.0f;        ///< Fraction of ADC time this channel uses
+  bool feasible = false;       ///< All targets met
+};
+
+/// Totals for a plan
+struct PlanBudget {
+  float conversionsPerSec = 0.0f;  ///< Single-shot conversions per second
+  float adcLoad = 0.0f;            ///< Sum of channel ADC time fractions
+  float busBitsPerSec = 0.0f;      ///< I2C clocks per second
+  float busLoad = 0.0f;            ///< busBitsPerSec / i2cClockHz
+  bool feasible = false;           ///< Every channel feasible and both loads <= 1
+};
+
+/// Planner inputs beyond the requirements
+struct PlannerOptions {
+  uint32_t i2cClockHz = 400000;         ///< For the bus budget
+  const NoiseStats* measured = nullptr; ///< Optional characterizeNoise() results
+  size_t measuredCount = 0;
+  uint16_t maxOversample = 256;         ///< Largest averaging factor considered
+};
+
+namespace plan {
+
+/// Datasheet RMS noise in microvolts by [FSR][DR] (ADS1115 Table 1, inputs
+/// shorted, VDD = 3.3 V); rows 6.144 V to 0.256 V, columns 8 to 860 SPS.
+/// Every entry is one LSB: the ADS1115 is quantization-limited at all settings.
+static constexpr float kDatasheetNoiseUvRms[6][8] = {
+  {187.5f, 187.5f, 187.5f, 187.5f, 187.5f, 187.5f, 187.5f, 187.5f},
+  {125.0f, 125.0f, 125.0f, 125.0f, 125.0f, 125.0f, 125.0f, 125.0f},
+  {62.5f, 62.5f, 62.5f, 62.5f, 62.5f, 62.5f, 62.5f, 62.5f},
+  {31.25f, 31.25f, 31.25f, 31.25f, 31.25f, 31.25f, 31.25f, 31.25f},
+  {15.62f, 15.62f, 15.62f, 15.62f, 15.62f, 15.62f, 15.62f, 15.62f},
+  {7.81f, 7.81f, 7.81f, 7.81f, 7.81f, 7.81f, 7.81f, 7.81f},
+};
+
+/// Datasheet RMS noise for a setting (out-of-range values use the defaults)
+inline float datasheetNoiseUvRms(Gain gain, DataRate rate) {
+  uint8_t g = static_cast<uint8_t>(gain);
+  uint8_t d = static_cast<uint8_t>(rate);
+  return kDatasheetNoiseUvRms[g < 6 ? g : 2][d < 8 ? d : 4];
+}
+
+/// Noise for a setting: measured figure if one was supplied, else the datasheet
+inline float noiseUvRms(Gain gain, DataRate rate, const PlannerOptions& opt) {
+  for (size_t i = 0; i < opt.measuredCount && opt.measured != nullptr; ++i) {
+    const NoiseStats& m = opt.measured[i];
+    if (m.gain == gain && m.dataRate == rate && m.samples > 1) {
+      return m.rmsUv;
+    }
+  }
+  return datasheetNoiseUvRms(gain, rate);
+}
+
+/// Smallest full-scale range that holds @p volts
+/// @return false if even FSR_6_144V clips; @p gain is then FSR_6_144V
+inline bool gainFor(float volts, Gain& gain) {
+  static constexpr float kFsr[] = {6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f};
+  float v = volts < 0.0f ? -volts : volts;
+  for (int g = 5; g >= 0; --g) {
+    if (v <= kFsr[g]) {
+      gain = static_cast<Gain>(g);
+      return true;
+    }
+  }
+  gain = Gain::FSR_6_144V;
+  return false;
+}
+
+/// Single-shot transaction cost: config write (addr + 3) and conversion read
+/// (addr + pointer, addr + 2), 9 clocks per byte plus START/Sr/STOP
+static constexpr float kBusBitsPerConversion = 9.0f * 9.0f + 5.0f;
+
+/// The ADS1115 sinc filter averages one conversion period: -3 dB at 0.443 * DR,
+/// and averaging N conversions divides that by N.
+static constexpr float kSincBandwidth = 0.443f;
+
+} // namespace plan
+
+/// Choose settings for each channel and report the resulting budget
+/// @param req     Requirements, one per channel
+/// @param count   Number of channels
+/// @param out     Plans, one per requirement
+/// @param budget  ADC time and I2C totals for the whole plan
+/// @param options Bus clock, measured noise and oversampling limit
+/// @note Among settings that meet the noise, bandwidth and latency targets the
+///       one with the least ADC time (outputs/s x N / DR) wins, ties going to
+///       less oversampling. Averaging is assumed to reduce noise by sqrt(N),
+///       which holds while thermal noise is comparable to one LSB. When no
+///       setting meets every target the lowest-noise one that meets the
+///       bandwidth is returned with feasible = false. An input range above
+///       6.144 V is never feasible; the plan then uses FSR_6_144V.
+inline Status planChannels(const ChannelRequirement* req, size_t count, ChannelPlan* out,
+                           PlanBudget& budget, const PlannerOptions& options = PlannerOptions{}) {
+  budget = PlanBudget{};
+  if (req == nullptr || out == nullptr) {
+    return Status::Error(Err::INVALID_PARAM, "Planner tables missing");
+  }
+  if (options.i2cClockHz == 0 || options.maxOversample == 0) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid planner options");
+  }
+
+  bool allFeasible = true;
+  for (size_t c = 0; c < count; ++c) {
+    const ChannelRequirement& r = req[c];
+    if (!(r.bandwidthHz > 0.0f)) {
+      return Status::Error(Err::INVALID_PARAM, "Bandwidth must be > 0");
+    }
+    ChannelPlan best;
+    best.config.mux = r.mux;
+    const bool inRange = plan::gainFor(r.maxInputV, best.config.gain);
+    const float outputRate = r.bandwidthHz / plan::kSincBandwidth;
+    float bestCost = 0.0f;
+    float fallbackNoise = 0.0f;
+    bool haveFallback = false;
+
+    for (uint8_t d = 0; d < 8; ++d) {
+      DataRate rate = static_cast<DataRate>(d);
+      float convSec = conversionTimeUs(rate) * 1e-6f;
+      float baseNoise = plan::noiseUvRms(best.config.gain, rate, options);
+      for (uint32_t n = 1; n <= options.maxOversample; n *= 2) {
+        float outputSec = convSec * n;
+        if (outputSec * outputRate > 1.0f) {
+          break;  // cannot keep up with the bandwidth; larger N only gets slower
+        }
+        float noise = baseNoise / std::sqrt(static_cast<float>(n));
+        float latencyMs = outputSec * 1000.0f;
+        bool meets = inRange && (r.noiseUvRms <= 0.0f || noise <= r.noiseUvRms) &&
+                     (r.maxLatencyMs <= 0.0f || latencyMs <= r.maxLatencyMs);
+        float cost = outputRate * outputSec;
+        ChannelPlan candidate;
+        candidate.config = ChannelConfig{r.mux, best.config.gain, rate};
+        candidate.oversample = static_cast<uint16_t>(n);
+        candidate.outputRateHz = outputRate;
+        candidate.bandwidthHz = plan::kSincBandwidth / outputSec;
+        candidate.noiseUvRms = noise;
+        candidate.latencyMs = latencyMs;
+        candidate.adcLoad = cost;
+        candidate.feasible = meets;
+        if (meets) {
+          if (!best.feasible || cost < bestCost) {
+            best = candidate;
+            bestCost = cost;
+          }
+        } else if (!best.feasible && (!haveFallback || noise < fallbackNoise)) {
+          best = candidate;
+          fallbackNoise = noise;
+          haveFallback = true;
+        }
+      }
+    }
+
+    if (!best.feasible && !haveFallback) {
+      // Even 860 SPS without averaging is too slow for the bandwidth
+      best.config.dataRate = DataRate::SPS_860;
+      float convSec = conversionTimeUs(DataRate::SPS_860) * 1e-6f;
+      best.oversample = 1;
+      best.outputRateHz = outputRate;
+      best.bandwidthHz = plan::kSincBandwidth / convSec;
+      best.noiseUvRms = plan::noiseUvRms(best.config.gain, DataRate::SPS_860, options);
+      best.latencyMs = convSec * 1000.0f;
+      best.adcLoad = outputRate * convSec;
+    }
+
+    out[c] = best;
+    allFeasible = allFeasible && best.feasible;
+    budget.adcLoad += best.adcLoad;
+    budget.conversionsPerSec += best.outputRateHz * best.oversample;
+  }
+
+  budget.busBitsPerSec = budget.conversionsPerSec * plan::kBusBitsPerConversion;
+  budget.busLoad = budget.busBitsPerSec / static_cast<float>(options.i2cClockHz);
+  budget.feasible = allFeasible && budget.adcLoad <= 1.0f && budget.busLoad <= 1.0f;
+  return Status::Ok();
+}
+
+} // namespace ADS1115
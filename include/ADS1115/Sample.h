@@ -0,0 +1,46 @@
+/// @file Sample.h
+/// @brief Conversion result record published by the driver
+#pragma once
+
+#include <cstdint>
+
+#include "ADS1115/Config.h"
+
+namespace ADS1115 {
+
+/// Sample::flags bits
+namespace SampleFlag {
+static constexpr uint8_t HEARTBEAT = 0x01;  ///< Reported only because a heartbeat expired
+static constexpr uint8_t GAP = 0x02;        ///< Samples were lost or not taken before this one
+}
+
+/// One completed conversion
+struct Sample {
+  uint32_t timestampUs = 0;      ///< micros() when the result was read
+  uint32_t seq = 0;              ///< Per-driver sequence number, +1 per sample
+  int16_t raw = 0;               ///< Conversion result
+  Mux mux = Mux::AIN0_GND;       ///< Input the result belongs to
+  Gain gain = Gain::FSR_2_048V;  ///< PGA setting used for the conversion
+  uint8_t flags = 0;             ///< SampleFlag bits
+
+  /// Result in volts for the gain it was taken with
+  float volts() const { return raw * lsbVolts(gain); }
+};
+
+/// raw | mux << 16 | gain << 20 | flags << 24, for 32-bit atomic publication
+inline uint32_t packSample(const Sample& s) {
+  return static_cast<uint16_t>(s.raw) |
+         (static_cast<uint32_t>(s.mux) & 0x0Fu) << 16 |
+         (static_cast<uint32_t>(s.gain) & 0x0Fu) << 20 |
+         static_cast<uint32_t>(s.flags) << 24;
+}
+
+/// Inverse of packSample() (timestampUs and seq are left untouched)
+inline void unpackSample(uint32_t packed, Sample& s) {
+  s.raw = static_cast<int16_t>(packed & 0xFFFFu);
+  s.mux = static_cast<Mux>((packed >> 16) & 0x0Fu);
+  s.gain = static_cast<Gain>((packed >> 20) & 0x0Fu);
+  s.flags = static_cast<uint8_t>(packed >> 24);
+}
+
+} // namespace ADS1115
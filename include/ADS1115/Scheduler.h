@@ -0,0 +1,369 @@
+/// @file Scheduler.h
+/// @brief Non-preemptive earliest-deadline-first scheduler over single-shot conversions
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/ADS1115.h"
+
+namespace ADS1115 {
+
+/// Per-channel scheduling counters
+struct ChannelSchedStats {
+  uint32_t released = 0;      ///< Jobs released (one per period)
+  uint32_t completed = 0;     ///< Conversions read back
+  uint32_t misses = 0;        ///< Completed after their deadline
+  uint32_t overruns = 0;      ///< Released while the previous job was still waiting
+  uint32_t paused = 0;        ///< Like overruns, while the sample sink paused acquisition
+  uint32_t maxLatenessUs = 0; ///< Worst completion time past the deadline
+  uint32_t maxResponseUs = 0; ///< Worst release-to-completion time
+  uint32_t preempted = 0;     ///< Conversions aborted for a critical channel and re-queued
+  uint32_t timeouts = 0;      ///< Conversions abandoned after the job timeout
+};
+
+/// Scheduler-wide figures
+struct SchedulerStats {
+  float plannedUtilization = 0.0f;  ///< Sum of conversion time / period
+  float measuredUtilization = 0.0f; ///< Fraction of time a conversion was in flight
+  uint32_t elapsedUs = 0;           ///< Time since start()
+  uint32_t errors = 0;              ///< Failed start or read transactions and timeouts
+  uint32_t preemptions = 0;         ///< In-flight conversions aborted
+};
+
+/// Called with each completed conversion and the channel it belongs to
+using ChannelSampleFn = void (*)(size_t channel, const Sample& sample, void* user);
+
+/// EDF scheduler: each channel has a period and a relative deadline; when the
+/// ADC is idle the released job with the earliest absolute deadline is
+/// converted next
+/// @code
+///   ADS1115::EdfScheduler<> sched;
+///   sched.addChannel({ADS1115::Mux::AIN0_GND, ADS1115::Gain::FSR_2_048V,
+///                     ADS1115::DataRate::SPS_860}, 10000);      // 100 Hz
+///   sched.addChannel({ADS1115::Mux::AIN1_GND, ADS1115::Gain::FSR_4_096V,
+///                     ADS1115::DataRate::SPS_128}, 1000000);    // 1 Hz
+///   sched.setOnSample(handler, nullptr);
+///   sched.start(micros());
+///   // loop():
+///   sched.poll(device, micros());
+/// @endcode
+/// @note The driver must be in SINGLE_SHOT mode. Conversions are not
+///       preempted: a job becomes ready only when the current one is read.
+///       With setPreemption(true), a released critical channel aborts an
+///       in-flight non-critical conversion (ADS1115::preemptConversion(),
+///       general-call reset) when waiting for it would miss the critical
+///       deadline; the aborted job is re-queued with its original deadline.
+///       A channel whose conversion is longer than the gaps between critical
+///       jobs can then starve (watch ChannelSchedStats::preempted).
+///       Per-conversion overhead (I2C transactions, and the driver's
+///       millisecond readiness gate, which adds up to ~2 ms at 475/860 SPS)
+///       should be folded into setOverheadUs() for the planned utilization.
+///       A conversion still not ready after its nominal time + 1/8 (oscillator
+///       tolerance) + overhead + setTimeoutMarginUs() is abandoned: poll()
+///       counts an error and a timeout, rewrites the device config
+///       (ADS1115::reapplyConfig()) to drop the stale conversion and returns
+///       TIMEOUT. A read that still reports CONVERSION_NOT_READY once the
+///       driver said the conversion was ready also counts as an error.
+///       While Config::sampleBackpressure pauses acquisition, poll() starts
+///       nothing and returns Ok: released jobs wait, and jobs replaced in the
+///       meantime count as ChannelSchedStats::paused instead of overruns.
+template <size_t MaxChannels = 8>
+class EdfScheduler {
+public:
+  /// Add a channel
+  /// @param periodUs   Release period
+  /// @param deadlineUs Relative deadline; 0 means equal to the period
+  /// @param critical   May preempt non-critical conversions (see setPreemption())
+  /// @return Status; INVALID_CONFIG when all MaxChannels slots are used
+  Status addChannel(const ChannelConfig& config, uint32_t periodUs, uint32_t deadlineUs = 0,
+                    bool critical = false) {
+    if (_count >= MaxChannels) {
+      return Status::Error(Err::INVALID_CONFIG, "Too many scheduled channels");
+    }
+    if (periodUs == 0) {
+      return Status::Error(Err::INVALID_PARAM, "Period must be > 0");
+    }
+    Channel& ch = _channels[_count++];
+    ch = Channel{};
+    ch.config = config;
+    ch.periodUs = periodUs;
+    ch.deadlineUs = (deadlineUs == 0) ? periodUs : deadlineUs;
+    ch.critical = critical;
+    return Status::Ok();
+  }
+
+  /// Let critical channels abort non-critical conversions; requires
+  /// BusConfig::allowGeneralCallReset on the driver
+  void setPreemption(bool enable) { _preemption = enable; }
+
+  void setOnSample(ChannelSampleFn fn, void* user) {
+    _onSample = fn;
+    _sampleUser = user;
+  }
+
+  /// Fixed per-conversion overhead added to the planned utilization
+  void setOverheadUs(uint32_t us) { _overheadUs = us; }
+
+  /// Slack added to the job timeout; covers the driver's millisecond
+  /// readiness margin (up to 5 ms at low data rates) and poll() latency
+  void setTimeoutMarginUs(uint32_t us) { _timeoutMarginUs = us; }
+
+  /// Release every channel at @p nowUs and clear the counters
+  void start(uint32_t nowUs) {
+    for (size_t i = 0; i < _count; ++i) {
+      Channel& ch = _channels[i];
+      ch.stats = ChannelSchedStats{};
+      ch.nextReleaseUs = nowUs;
+      ch.pending = false;
+    }
+    _startUs = nowUs;
+    _busyUs = 0;
+    _errors = 0;
+    _preemptions = 0;
+    _active = -1;
+    _paused = false;
+    _running = true;
+  }
+
+  void stop() { _running = false; }
+
+  /// Drive the schedule; call often (at least once per shortest conversion)
+  Status poll(ADS1115& device, uint32_t nowUs) {
+    if (!_running) {
+      return Status::Ok();
+    }
+    _release(nowUs);
+
+    Status result = Status::Ok();
+    if (_active >= 0) {
+      if (!device.conversionReady()) {
+        if (_timedOut(nowUs)) {
+          return _abandon(device, nowUs);
+        }
+        return _preempt(device, nowUs);
+      }
+      int16_t raw = 0;
+      Status st = device.readRaw(raw);
+      _complete(static_cast<size_t>(_active), device.lastSample(), nowUs, st.ok());
+      _active = -1;
+      if (!st.ok()) {
+        _errors++;
+        result = st;
+      }
+      _release(nowUs);
+    }
+
+    int next = _earliestDeadline();
+    if (next < 0) {
+      return result;
+    }
+    Channel& ch = _channels[next];
+    Status st = device.startConversion(ch.config);
+    _paused = st.code == Err::BUSY && device.acquisitionPaused();
+    if (_paused) {
+      return result;  // the job waits for the sink
+    }
+    if (st.code != Err::IN_PROGRESS) {
+      _errors++;
+      return st;
+    }
+    ch.pending = false;
+    ch.startUs = nowUs;
+    _active = next;
+    return result;
+  }
+
+  size_t channelCount() const { return _count; }
+
+  ChannelSchedStats channelStats(size_t index) const {
+    return (index < _count) ? _channels[index].stats : ChannelSchedStats{};
+  }
+
+  /// Planned and measured utilization
+  SchedulerStats stats(uint32_t nowUs) const {
+    SchedulerStats out;
+    for (size_t i = 0; i < _count; ++i) {
+      const Channel& ch = _channels[i];
+      out.plannedUtilization +=
+          static_cast<float>(conversionTimeUs(ch.config.dataRate) + _overheadUs) / ch.periodUs;
+    }
+    out.elapsedUs = nowUs - _startUs;
+    if (out.elapsedUs > 0) {
+      out.measuredUtilization = static_cast<float>(_busyUs) / out.elapsedUs;
+    }
+    out.errors = _errors;
+    out.preemptions = _preemptions;
+    return out;
+  }
+
+private:
+  struct Channel {
+    ChannelConfig config;
+    ChannelSchedStats stats;
+    uint32_t periodUs = 0;
+    uint32_t deadlineUs = 0;
+    uint32_t nextReleaseUs = 0;
+    uint32_t releaseUs = 0;          ///< Release time of the current job
+    uint32_t absDeadlineUs = 0;
+    uint32_t startUs = 0;
+    bool pending = false;            ///< Released, not yet started
+    bool critical = false;
+  };
+
+  bool _timedOut(uint32_t nowUs) const {
+    const Channel& ch = _channels[_active];
+    uint32_t convUs = conversionTimeUs(ch.config.dataRate);
+    uint32_t limitUs = convUs + convUs / 8 + _overheadUs + _timeoutMarginUs;
+    return nowUs - ch.startUs > limitUs;
+  }
+
+  /// Give up on the running conversion and drop it from the driver
+  Status _abandon(ADS1115& device, uint32_t nowUs) {
+    Channel& ch = _channels[_active];
+    _busyUs += nowUs - ch.startUs;
+    ch.stats.timeouts++;
+    _errors++;
+    _active = -1;
+    (void)device.reapplyConfig();  // a failure shows up on the next start
+    return Status::Error(Err::TIMEOUT, "Scheduled conversion timed out");
+  }
+
+  /// Abort a non-critical conversion if a critical job is waiting
+  Status _preempt(ADS1115& device, uint32_t nowUs) {
+    if (!_preemption || _channels[_active].critical) {
+      return Status::Ok();
+    }
+    int urgent = -1;
+    for (size_t i = 0; i < _count; ++i) {
+      const Channel& ch = _channels[i];
+      if (ch.critical && ch.pending &&
+          (urgent < 0 ||
+           static_cast<int32_t>(ch.absDeadlineUs - _channels[urgent].absDeadlineUs) < 0)) {
+        urgent = static_cast<int>(i);
+      }
+    }
+    if (urgent < 0) {
+      return Status::Ok();
+    }
+    // Waiting is cheaper when the running conversion ends in time for the deadline
+    const Channel& running = _channels[_active];
+    uint32_t elapsedUs = nowUs - running.startUs;
+    uint32_t runUs = conversionTimeUs(running.config.dataRate) + _overheadUs;
+    uint32_t remainingUs = (elapsedUs < runUs) ? runUs - elapsedUs : 0;
+    uint32_t finishUs =
+        nowUs + remainingUs + conversionTimeUs(_channels[urgent].config.dataRate) + _overheadUs;
+    if (static_cast<int32_t>(finishUs - _channels[urgent].absDeadlineUs) <= 0) {
+      return Status::Ok();
+    }
+    Status st = device.preemptConversion(_channels[urgent].config);
+    if (st.code == Err::BUSY && device.acquisitionPaused()) {
+      return Status::Ok();  // sink full: the running conversion finishes
+    }
+    if (st.code != Err::IN_PROGRESS) {
+      _errors++;
+      return st;
+    }
+    Channel& victim = _channels[_active];
+    _busyUs += nowUs - victim.startUs;
+    victim.pending = true;  // same release and deadline
+    victim.stats.preempted++;
+    _preemptions++;
+    _channels[urgent].pending = false;
+    _channels[urgent].startUs = nowUs;
+    _active = urgent;
+    return Status::Ok();
+  }
+
+  void _release(uint32_t nowUs) {
+    for (size_t i = 0; i < _count; ++i) {
+      Channel& ch = _channels[i];
+      if (static_cast<int32_t>(nowUs - ch.nextReleaseUs) < 0) {
+        continue;
+      }
+      if (_active == static_cast<int>(i)) {
+        continue;  // released as soon as the running job is read back
+      }
+      if (ch.pending) {
+        // previous job never started; replace it
+        if (_paused) {
+          ch.stats.paused++;
+        } else {
+          ch.stats.overruns++;
+        }
+      }
+      ch.stats.released++;
+      ch.releaseUs = ch.nextReleaseUs;
+      ch.absDeadlineUs = ch.releaseUs + ch.deadlineUs;
+      ch.pending = true;
+      ch.nextReleaseUs += ch.periodUs;
+      // After a long stall, realign rather than releasing a burst of stale jobs
+      if (static_cast<int32_t>(nowUs - ch.nextReleaseUs) >= 0) {
+        uint32_t behind = (nowUs - ch.nextReleaseUs) / ch.periodUs + 1;
+        if (_paused) {
+          ch.stats.paused += behind;
+        } else {
+          ch.stats.overruns += behind;
+        }
+        ch.nextReleaseUs += behind * ch.periodUs;
+      }
+    }
+  }
+
+  int _earliestDeadline() const {
+    int best = -1;
+    for (size_t i = 0; i < _count; ++i) {
+      const Channel& ch = _channels[i];
+      if (!ch.pending) {
+        continue;
+      }
+      if (best < 0 ||
+          static_cast<int32_t>(ch.absDeadlineUs - _channels[best].absDeadlineUs) < 0) {
+        best = static_cast<int>(i);
+      }
+    }
+    return best;
+  }
+
+  void _complete(size_t index, const Sample& sample, uint32_t nowUs, bool ok) {
+    Channel& ch = _channels[index];
+    _busyUs += nowUs - ch.startUs;
+    if (!ok) {
+      return;
+    }
+    ch.stats.completed++;
+    uint32_t responseUs = nowUs - ch.releaseUs;
+    if (responseUs > ch.stats.maxResponseUs) {
+      ch.stats.maxResponseUs = responseUs;
+    }
+    int32_t lateness = static_cast<int32_t>(nowUs - ch.absDeadlineUs);
+    if (lateness > 0) {
+      ch.stats.misses++;
+      if (static_cast<uint32_t>(lateness) > ch.stats.maxLatenessUs) {
+        ch.stats.maxLatenessUs = static_cast<uint32_t>(lateness);
+      }
+    }
+    if (_onSample != nullptr) {
+      _onSample(index, sample, _sampleUser);
+    }
+  }
+
+  Channel _channels[MaxChannels];
+  ChannelSampleFn _onSample = nullptr;
+  void* _sampleUser = nullptr;
+  uint64_t _busyUs = 0;
+  uint32_t _startUs = 0;
+  uint32_t _overheadUs = 0;
+  uint32_t _timeoutMarginUs = 10000;
+  uint32_t _errors = 0;
+  uint32_t _preemptions = 0;
+  size_t _count = 0;
+  int _active = -1;
+  bool _running = false;
+  bool _preemption = false;
+  bool _paused = false;  ///< Last start refused by the sample sink
+};
+
+} // namespace ADS1115
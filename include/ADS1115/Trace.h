@@ -0,0 +1,125 @@
+/// @file Trace.h
+/// @brief Compile-time tracing hooks (compiled out unless ADS1115_TRACE=1)
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/Status.h"
+
+/// Build flag: set to 1 to call ADS1115::traceSink() at every register
+/// access, state change and conversion event. With 0 (default) the hooks
+/// expand to nothing and their arguments are never evaluated.
+#ifndef ADS1115_TRACE
+#define ADS1115_TRACE 0
+#endif
+
+namespace ADS1115 {
+
+/// What a TraceRecord describes
+enum class TraceEvent : uint8_t {
+  REG_READ = 0,      ///< reg = pointer, value = register contents
+  REG_WRITE,         ///< reg = pointer, value = data written (0 for pointer-only)
+  REG_READ_CURRENT,  ///< Read-only transaction from the current pointer
+  GENERAL_CALL,      ///< General-call reset sent (preemption)
+  BATCH,             ///< Batched operations; value = operation count
+  STATE_CHANGE,      ///< value = new DriverState, arg = previous DriverState
+  CONVERSION_START,  ///< value = config register written
+  CONVERSION_READY,  ///< arg = TraceReadySource
+  SAMPLE,            ///< value = raw code, arg = mux
+  BURST,             ///< value = samples captured
+  TICK               ///< tick() entered
+};
+
+/// How a conversion was found complete (TraceRecord::arg of CONVERSION_READY)
+namespace TraceReadySource {
+static constexpr uint8_t ALERT_PIN = 0;  ///< gpioRead on ALERT/RDY
+static constexpr uint8_t OS_POLL = 1;    ///< Config register OS bit
+static constexpr uint8_t NOTIFY = 2;     ///< notifyConversionReady()
+}
+
+/// One trace event (12 bytes)
+struct TraceRecord {
+  uint32_t timestampUs = 0;              ///< micros() when recorded
+  uint16_t value = 0;                    ///< Event-specific (see TraceEvent)
+  TraceEvent event = TraceEvent::TICK;
+  uint8_t addr = 0;                      ///< Device I2C address
+  uint8_t reg = 0;                       ///< Register pointer, 0xFF if none
+  Err err = Err::OK;                     ///< Result of the traced operation
+  uint8_t arg = 0;                       ///< Event-specific (see TraceEvent)
+};
+
+/// Short name for dumps and trace viewers
+inline const char* traceEventName(TraceEvent event) {
+  switch (event) {
+    case TraceEvent::REG_READ:         return "reg_read";
+    case TraceEvent::REG_WRITE:        return "reg_write";
+    case TraceEvent::REG_READ_CURRENT: return "reg_read_current";
+    case TraceEvent::GENERAL_CALL:     return "general_call";
+    case TraceEvent::BATCH:            return "batch";
+    case TraceEvent::STATE_CHANGE:     return "state_change";
+    case TraceEvent::CONVERSION_START: return "conversion_start";
+    case TraceEvent::CONVERSION_READY: return "conversion_ready";
+    case TraceEvent::SAMPLE:           return "sample";
+    case TraceEvent::BURST:            return "burst";
+    case TraceEvent::TICK:             return "tick";
+    default:                           return "unknown";
+  }
+}
+
+/// Fixed-size trace recorder keeping the most recent @p Capacity records
+/// @note Single writer; read it back when the driver is idle.
+template <size_t Capacity = 128>
+class TraceBuffer {
+public:
+  static_assert(Capacity > 0, "TraceBuffer needs capacity");
+
+  void record(const TraceRecord& rec) {
+    _records[_next] = rec;
+    _next = (_next + 1) % Capacity;
+    if (_count < Capacity) {
+      _count++;
+    }
+    _total++;
+  }
+
+  void clear() {
+    _next = 0;
+    _count = 0;
+    _total = 0;
+  }
+
+  /// Records held (at most Capacity)
+  size_t size() const { return _count; }
+
+  /// Records seen since clear(), including overwritten ones
+  uint32_t total() const { return _total; }
+
+  /// @p index 0 is the oldest record held
+  const TraceRecord& operator[](size_t index) const {
+    size_t start = (_count < Capacity) ? 0 : _next;
+    return _records[(start + index) % Capacity];
+  }
+
+private:
+  TraceRecord _records[Capacity];
+  size_t _next = 0;
+  size_t _count = 0;
+  uint32_t _total = 0;
+};
+
+} // namespace ADS1115
+
+#if ADS1115_TRACE
+#ifdef ADS1115_TRACE_SINK_HEADER
+/// The header named by ADS1115_TRACE_SINK_HEADER must define
+/// `inline void traceSink(const TraceRecord&)` inside namespace ADS1115 so
+/// the call inlines into the driver.
+#include ADS1115_TRACE_SINK_HEADER
+#else
+namespace ADS1115 {
+/// Trace sink, defined once by the application
+void traceSink(const TraceRecord& rec);
+} // namespace ADS1115
+#endif
+#endif
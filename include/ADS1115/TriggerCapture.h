@@ -0,0 +1,236 @@
+/// @file TriggerCapture.h
+/// @brief Oscilloscope-style triggered capture with a pre-trigger buffer
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/Config.h"
+#include "ADS1115/Sample.h"
+
+namespace ADS1115 {
+
+/// Trigger condition
+enum class TriggerMode : uint8_t {
+  RISING_LEVEL  = 0,  ///< previous < level <= current
+  FALLING_LEVEL = 1,  ///< previous > level >= current
+  SLOPE         = 2,  ///< |current - previous| >= slope codes per sample
+  WINDOW        = 3,  ///< current < low or current > high
+  EXTERNAL      = 4   ///< Only trigger() (e.g. from the ALERT comparator)
+};
+
+/// Trigger settings
+struct TriggerConfig {
+  TriggerMode mode = TriggerMode::RISING_LEVEL;
+  int16_t level = 0;          ///< RISING_LEVEL / FALLING_LEVEL threshold (codes)
+  uint16_t slope = 0;         ///< SLOPE: minimum step between samples (codes)
+  int16_t low = -32768;       ///< WINDOW lower bound (codes)
+  int16_t high = 32767;       ///< WINDOW upper bound (codes)
+  uint16_t postSamples = 0;   ///< Samples after the trigger; clamped to capacity - 1
+};
+
+/// Capture state
+enum class CaptureState : uint8_t {
+  IDLE      = 0,  ///< Not armed; samples ignored
+  ARMED     = 1,  ///< Filling the pre-trigger buffer, checking the trigger
+  TRIGGERED = 2,  ///< Collecting post-trigger samples
+  FROZEN    = 3   ///< Capture complete; block valid until arm() or disarm()
+};
+
+/// Description of a frozen capture
+struct CaptureInfo {
+  uint32_t triggerTimestampUs = 0;  ///< Timestamp of the trigger sample
+  uint32_t triggerSeq = 0;          ///< Sequence number of the trigger sample
+  uint16_t preSamples = 0;          ///< Samples before the trigger sample
+  uint16_t postSamples = 0;         ///< Samples after the trigger sample
+  uint16_t gaps = 0;                ///< Sequence-number gaps seen while capturing
+  Mux mux = Mux::AIN0_GND;
+  Gain gain = Gain::FSR_2_048V;
+};
+
+/// Triggered capture on one continuous sample stream
+/// @code
+///   ADS1115::TriggerCapture<1024> scope;        // 2 KB of codes
+///   ADS1115::TriggerConfig trig;
+///   trig.mode = ADS1115::TriggerMode::RISING_LEVEL;
+///   trig.level = 12000;
+///   trig.postSamples = 256;
+///   scope.arm(trig);
+///   cfg.onSample = decltype(scope)::onSample;
+///   cfg.sampleUser = &scope;
+///   ...
+///   if (scope.state() == ADS1115::CaptureState::FROZEN) {
+///     for (size_t i = 0; i < scope.size(); ++i) { use(scope.at(i)); }
+///     scope.arm(trig);
+///   }
+/// @endcode
+/// @note Only raw codes are stored (2 bytes per sample); the remaining Sample
+///       fields of the trigger sample are kept in CaptureInfo. Feed a single
+///       mux setting, at a fixed data rate, from one context.
+/// @tparam Capacity Samples in the circular buffer (pre + 1 + post)
+template <size_t Capacity>
+class TriggerCapture {
+public:
+  static_assert(Capacity >= 2 && Capacity <= 0xFFFF, "TriggerCapture capacity out of range");
+
+  using CaptureFn = void (*)(const TriggerCapture& capture, void* user);
+
+  /// Called once from feed() when a capture freezes (optional)
+  void setOnCapture(CaptureFn fn, void* user) {
+    _onCapture = fn;
+    _captureUser = user;
+  }
+
+  /// Start looking for a trigger; discards any previous capture and any
+  /// trigger() still pending from the last one
+  void arm(const TriggerConfig& config) {
+    _trigger = config;
+    if (_trigger.postSamples > Capacity - 1) {
+      _trigger.postSamples = static_cast<uint16_t>(Capacity - 1);
+    }
+    _head = 0;
+    _filled = 0;
+    _postRemaining = 0;
+    _hasPrev = false;
+    _info = CaptureInfo{};
+    _forced = false;
+    _state = CaptureState::ARMED;
+  }
+
+  /// Stop capturing and drop the block
+  void disarm() {
+    _state = CaptureState::IDLE;
+    _forced = false;
+  }
+
+  /// Force a trigger on the next fed sample (EXTERNAL mode, ALERT comparator,
+  /// user request). Safe to call from an ISR on the feeding core.
+  void trigger() { _forced = true; }
+
+  /// Hot path: store @p sample and evaluate the trigger
+  void feed(const Sample& sample) {
+    if (_state == CaptureState::IDLE || _state == CaptureState::FROZEN) {
+      return;
+    }
+    if (_hasPrev && sample.seq != _lastSeq + 1 && _info.gaps < 0xFFFF) {
+      _info.gaps++;
+    }
+    _lastSeq = sample.seq;
+
+    _buf[_head] = sample.raw;
+    _head = (_head + 1 == Capacity) ? 0 : _head + 1;
+    if (_filled < Capacity) {
+      _filled++;
+    }
+
+    if (_state == CaptureState::ARMED) {
+      if (_fires(sample.raw)) {
+        _info.triggerTimestampUs = sample.timestampUs;
+        _info.triggerSeq = sample.seq;
+        _info.mux = sample.mux;
+        _info.gain = sample.gain;
+        _postRemaining = _trigger.postSamples;
+        _state = CaptureState::TRIGGERED;
+        if (_postRemaining == 0) {
+          _freeze();
+        }
+      }
+    } else if (--_postRemaining == 0) {
+      _freeze();
+    }
+    _prev = sample.raw;
+    _hasPrev = true;
+  }
+
+  CaptureState state() const { return _state; }
+  const CaptureInfo& info() const { return _info; }
+
+  /// Samples in the frozen block (pre + trigger + post)
+  size_t size() const {
+    return (_state == CaptureState::FROZEN)
+               ? static_cast<size_t>(_info.preSamples) + 1 + _info.postSamples
+               : 0;
+  }
+
+  /// Sample @p index of the frozen block, oldest first; the trigger sample is
+  /// at info().preSamples
+  int16_t at(size_t index) const {
+    size_t n = size();
+    if (index >= n) {
+      return 0;
+    }
+    size_t start = (_head + Capacity - n) % Capacity;
+    size_t pos = start + index;
+    return _buf[pos >= Capacity ? pos - Capacity : pos];
+  }
+
+  /// Copy the frozen block (oldest first); returns the number copied
+  size_t copyTo(int16_t* out, size_t max) const {
+    size_t n = size();
+    if (n > max) {
+      n = max;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = at(i);
+    }
+    return n;
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+  /// SampleFn adapter; user must point to this capture
+  static void onSample(const Sample& sample, void* user) {
+    static_cast<TriggerCapture*>(user)->feed(sample);
+  }
+
+private:
+  bool _fires(int16_t raw) {
+    if (_forced) {
+      _forced = false;
+      return true;
+    }
+    if (!_hasPrev) {
+      return _trigger.mode == TriggerMode::WINDOW &&
+             (raw < _trigger.low || raw > _trigger.high);
+    }
+    switch (_trigger.mode) {
+      case TriggerMode::RISING_LEVEL:
+        return _prev < _trigger.level && raw >= _trigger.level;
+      case TriggerMode::FALLING_LEVEL:
+        return _prev > _trigger.level && raw <= _trigger.level;
+      case TriggerMode::SLOPE: {
+        int32_t step = static_cast<int32_t>(raw) - _prev;
+        return (step < 0 ? -step : step) >= _trigger.slope;
+      }
+      case TriggerMode::WINDOW:
+        return raw < _trigger.low || raw > _trigger.high;
+      default:
+        return false;
+    }
+  }
+
+  void _freeze() {
+    _info.postSamples = _trigger.postSamples;
+    _info.preSamples = static_cast<uint16_t>(_filled - 1 - _info.postSamples);
+    _state = CaptureState::FROZEN;
+    if (_onCapture) {
+      _onCapture(*this, _captureUser);
+    }
+  }
+
+  int16_t _buf[Capacity] = {};
+  CaptureInfo _info;
+  TriggerConfig _trigger;
+  CaptureFn _onCapture = nullptr;
+  void* _captureUser = nullptr;
+  uint32_t _lastSeq = 0;
+  uint16_t _head = 0;
+  uint16_t _filled = 0;
+  uint16_t _postRemaining = 0;
+  int16_t _prev = 0;
+  CaptureState _state = CaptureState::IDLE;
+  bool _hasPrev = false;
+  volatile bool _forced = false;
+};
+
+} // namespace ADS1115
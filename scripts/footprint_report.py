@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+"""
+Report the memory footprint of the ADS1115 driver.
+
+Compiles src/ADS1115.cpp (default and slim instance layouts) with
+-fstack-usage / -fcallgraph-info and prints:
+  - sizeof(ADS1115::ADS1115) and of the config structs
+  - code, read-only data and static RAM (.data + .bss) of the object
+  - per-function stack usage and worst-case stack depth per public API
+    (calls through the transport callbacks are reported, not followed)
+
+Standalone usage:
+    python scripts/footprint_report.py [--cxx g++] [--size size] [--nm nm] [--json]
+    python scripts/footprint_report.py --cxx xtensa-esp32s3-elf-g++ \\
+        --size xtensa-esp32s3-elf-size --nm xtensa-esp32s3-elf-nm
+
+Usage in platformio.ini (adds a "footprint" target using the env toolchain):
+    extra_scripts = post:scripts/footprint_report.py
+    pio run -e ex_bringup_s3 -t footprint
+
+The native Arduino stub (test/stubs) stands in for <Arduino.h>, so the figures
+cover the driver itself, not the Arduino core.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+PROBE_TYPES = {
+    "ADS1115": "ADS1115::ADS1115",
+    "Config": "ADS1115::Config",
+    "BusConfig": "ADS1115::BusConfig",
+    "DeviceConfig": "ADS1115::DeviceConfig",
+}
+
+LAYOUTS = {"default": "0", "slim": "1"}
+
+
+def run(cmd):
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        raise SystemExit(f"Command failed: {' '.join(cmd)}")
+    return result.stdout
+
+
+def compile_flags(root, slim, extra):
+    return [
+        "-std=c++17", "-Os", "-ffunction-sections", "-fdata-sections",
+        f"-I{root / 'include'}", f"-I{root / 'test' / 'stubs'}",
+        f"-DADS1115_SLIM_INSTANCE={slim}",
+    ] + extra
+
+
+def probe_sizes(args, root, workdir, slim):
+    """sizeof() via array symbols, read back with nm (works for cross compilers)."""
+    probe = workdir / f"sizeof_probe_{slim}.cpp"
+    lines = ['#include "ADS1115/ADS1115.h"']
+    for key, type_name in PROBE_TYPES.items():
+        lines.append(f"extern const unsigned char sizeof_{key}[sizeof({type_name})];")
+        lines.append(f"const unsigned char sizeof_{key}[sizeof({type_name})] = {{1}};")
+    probe.write_text("\n".join(lines) + "\n")
+    obj = workdir / f"sizeof_probe_{slim}.o"
+    run([args.cxx, *compile_flags(root, slim, args.flags), "-c", str(probe), "-o", str(obj)])
+
+    sizes = {}
+    for line in run([args.nm, "-S", "--defined-only", str(obj)]).splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[3].startswith("sizeof_"):
+            sizes[parts[3][len("sizeof_"):]] = int(parts[1], 16)
+    return sizes
+
+
+def section_sizes(args, obj):
+    totals = {"text": 0, "rodata": 0, "data": 0, "bss": 0}
+    for line in run([args.size, "-A", str(obj)]).splitlines():
+        parts = line.split()
+        if len(parts) < 2 or not parts[1].isdigit():
+            continue
+        name, size = parts[0], int(parts[1])
+        if "4stub" in name:
+            continue  # Arduino stub variables, not part of the driver
+        for key in totals:
+            if name == f".{key}" or name.startswith(f".{key}."):
+                totals[key] += size
+    totals["static_ram"] = totals["data"] + totals["bss"]
+    return totals
+
+
+def parse_callgraph(ci_path):
+    """Parse GCC -fcallgraph-info=su output into nodes and edges."""
+    nodes = {}
+    edges = {}
+    node_re = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+    edge_re = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+    for line in Path(ci_path).read_text().splitlines():
+        m = node_re.search(line)
+        if m:
+            title, label = m.groups()
+            parts = label.split("\\n")
+            stack = 0
+            kind = ""
+            if len(parts) >= 3:
+                sm = re.match(r"(\d+) bytes \((\w+)", parts[2])
+                if sm:
+                    stack = int(sm.group(1))
+                    kind = sm.group(2)
+            nodes[title] = {"name": parts[0], "stack": stack, "kind": kind}
+            continue
+        m = edge_re.search(line)
+        if m:
+            edges.setdefault(m.group(1), set()).add(m.group(2))
+    return nodes, edges
+
+
+def worst_depth(title, nodes, edges, memo, visiting):
+    if title in memo:
+        return memo[title]
+    if title in visiting:
+        return 0, True, False  # recursion: depth unbounded, flag it
+    visiting.add(title)
+    own = nodes.get(title, {}).get("stack", 0)
+    deepest, recursive, indirect = 0, False, False
+    for callee in edges.get(title, ()):
+        if callee == "__indirect_call":
+            indirect = True
+            continue
+        depth, rec, ind = worst_depth(callee, nodes, edges, memo, visiting)
+        deepest = max(deepest, depth)
+        recursive = recursive or rec
+        indirect = indirect or ind
+    visiting.discard(title)
+    memo[title] = (own + deepest, recursive, indirect)
+    return memo[title]
+
+
+def stack_report(args, root, workdir, slim):
+    obj = workdir / f"ads1115_{slim}.o"
+    ci = workdir / f"ads1115_{slim}.ci"
+    run([args.cxx, *compile_flags(root, slim, args.flags), "-fstack-usage",
+         "-fcallgraph-info=su", "-c", str(root / "src" / "ADS1115.cpp"), "-o", str(obj)])
+    nodes, edges = parse_callgraph(ci)
+    memo = {}
+    functions = []
+    for title, node in nodes.items():
+        if "ADS1115::ADS1115::" not in node["name"] or node["kind"] == "":
+            continue
+        depth, recursive, indirect = worst_depth(title, nodes, edges, memo, set())
+        functions.append({
+            "function": node["name"],
+            "stack": node["stack"],
+            "kind": node["kind"],
+            "worst_case": depth,
+            "calls_transport": indirect,
+            "recursive": recursive,
+        })
+    functions.sort(key=lambda f: f["worst_case"], reverse=True)
+    return obj, functions
+
+
+def build_report(args):
+    root = Path(args.root).resolve()
+    report = {"compiler": args.cxx, "layouts": {}}
+    with tempfile.TemporaryDirectory() as tmp:
+        workdir = Path(tmp)
+        for layout, slim in LAYOUTS.items():
+            obj, functions = stack_report(args, root, workdir, slim)
+            report["layouts"][layout] = {
+                "sizeof": probe_sizes(args, root, workdir, slim),
+                "sections": section_sizes(args, obj),
+                "stack": functions,
+            }
+    return report
+
+
+def print_report(report):
+    print(f"ADS1115 footprint ({report['compiler']})")
+    for layout, data in report["layouts"].items():
+        print(f"\n== {layout} layout ==")
+        for key, value in data["sizeof"].items():
+            print(f"  sizeof({key}): {value}")
+        sec = data["sections"]
+        print(f"  text: {sec['text']}  rodata: {sec['rodata']}  "
+              f"static RAM (data+bss): {sec['static_ram']}")
+        print("  stack (own / worst-case bytes):")
+        for fn in data["stack"]:
+            notes = []
+            if fn["calls_transport"]:
+                notes.append("+ transport callback")
+            if fn["recursive"]:
+                notes.append("recursive")
+            if fn["kind"] != "static":
+                notes.append(fn["kind"])
+            suffix = f"  ({', '.join(notes)})" if notes else ""
+            print(f"    {fn['stack']:5d} / {fn['worst_case']:5d}  {fn['function']}{suffix}")
+
+
+def parse_args(argv):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "g++"))
+    parser.add_argument("--size", default="size")
+    parser.add_argument("--nm", default="nm")
+    parser.add_argument("--root", default=str(Path(__file__).resolve().parent.parent))
+    parser.add_argument("--json", action="store_true", help="Print JSON instead of text")
+    parser.add_argument("--flags", nargs="*", default=[], help="Extra compiler flags")
+    return parser.parse_args(argv)
+
+
+def main(argv):
+    args = parse_args(argv)
+    report = build_report(args)
+    if args.json:
+        print(json.dumps(report, indent=2))
+    else:
+        print_report(report)
+    return 0
+
+
+try:
+    Import("env")  # PlatformIO environment
+except NameError:
+    env = None
+
+if env is not None:
+    def _footprint_action(*_args, **_kwargs):
+        cxx = env.subst("$CXX")
+        prefix = cxx[:-len("g++")] if cxx.endswith("g++") else ""
+        return main(["--cxx", cxx, "--size", prefix + "size", "--nm", prefix + "nm",
+                     "--root", env.subst("$PROJECT_DIR")])
+
+    env.AddCustomTarget(
+        name="footprint",
+        dependencies=None,
+        actions=[_footprint_action],
+        title="Footprint report",
+        description="sizeof, static RAM and stack usage of the ADS1115 driver",
+    )
+elif __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -2,9 +2,11 @@
 /// @brief Implementation of ADS1115 driver
 
 #include "ADS1115/ADS1115.h"
+#include "ADS1115/Trace.h"
 
 #include <Arduino.h>
 #include <climits>
+#include <new>
 
 namespace ADS1115 {
 
@@ -45,7 +47,7 @@ bool isValidCompQueue(ComparatorQueue queue) {
   return static_cast<uint8_t>(queue) <= static_cast<uint8_t>(ComparatorQueue::DISABLE);
 }
 
-bool isAlertRdyModeConfigured(const Config& cfg) {
+bool isAlertRdyModeConfigured(const DeviceConfig& cfg) {
   constexpr int16_t kAlertRdyLow = static_cast<int16_t>(0x0000);
   constexpr int16_t kAlertRdyHigh = static_cast<int16_t>(0x8000);
   return cfg.compThresholdLow == kAlertRdyLow &&
@@ -55,25 +57,39 @@ bool isAlertRdyModeConfigured(const Config& cfg) {
          cfg.compLatch == ComparatorLatch::NON_LATCHING;
 }
 
-bool isAlertRdyPinConfigured(const Config& cfg) {
-  return cfg.alertRdyPin >= 0 && cfg.gpioRead != nullptr;
+bool isAlertRdyPinConfigured(const DeviceConfig& cfg, const BusConfig& bus) {
+  return cfg.alertRdyPin >= 0 && bus.gpioRead != nullptr;
 }
 
-bool useAlertRdyPin(const Config& cfg) {
-  return isAlertRdyPinConfigured(cfg) && isAlertRdyModeConfigured(cfg);
+bool useAlertRdyPin(const DeviceConfig& cfg, const BusConfig& bus) {
+  return isAlertRdyPinConfigured(cfg, bus) && isAlertRdyModeConfigured(cfg);
 }
 
-bool isAlertRdyAsserted(const Config& cfg) {
-  if (!useAlertRdyPin(cfg)) {
+bool isAlertRdyAsserted(const DeviceConfig& cfg, const BusConfig& bus) {
+  if (!useAlertRdyPin(cfg, bus)) {
     return false;
   }
-  bool level = cfg.gpioRead(cfg.alertRdyPin, cfg.gpioUser);
+  bool level = bus.gpioRead(cfg.alertRdyPin, bus.gpioUser);
   if (cfg.compPolarity == ComparatorPolarity::ACTIVE_HIGH) {
     return level;
   }
   return !level;
 }
 
+#if ADS1115_ENERGY
+/// START + address/ACK + data bytes + STOP, with repeated start when both phases exist
+uint32_t i2cTransactionBits(size_t txLen, size_t rxLen) {
+  uint32_t bits = 2;
+  if (txLen > 0) {
+    bits += static_cast<uint32_t>(9 * (1 + txLen));
+  }
+  if (rxLen > 0) {
+    bits += static_cast<uint32_t>(9 * (1 + rxLen)) + ((txLen > 0) ? 1 : 0);
+  }
+  return bits;
+}
+#endif
+
 bool isValidConfigValue(uint16_t config) {
   uint8_t mux = static_cast<uint8_t>((config & cmd::MASK_MUX) >> cmd::BIT_MUX);
   uint8_t pga = static_cast<uint8_t>((config & cmd::MASK_PGA) >> cmd::BIT_PGA);
@@ -88,20 +104,59 @@ bool isValidConfigValue(uint16_t config) {
          compMode <= 1 && compPol <= 1 && compLat <= 1 && compQue <= 3;
 }
 
+#if ADS1115_TRACE
+void traceEvent(TraceEvent event, uint8_t addr, uint8_t reg, uint16_t value, Err err,
+                uint8_t arg) {
+  TraceRecord rec;
+  rec.timestampUs = micros();
+  rec.value = value;
+  rec.event = event;
+  rec.addr = addr;
+  rec.reg = reg;
+  rec.err = err;
+  rec.arg = arg;
+  traceSink(rec);
+}
+#endif
+
 } // namespace
 
+// Hooks compile to nothing (arguments unevaluated) unless ADS1115_TRACE is set
+#if ADS1115_TRACE
+#define ADS1115_TRACE_EVENT(event, reg, value, err, arg)                          \
+  traceEvent(TraceEvent::event, _config.i2cAddress, static_cast<uint8_t>(reg),    \
+             static_cast<uint16_t>(value), (err), static_cast<uint8_t>(arg))
+#else
+#define ADS1115_TRACE_EVENT(event, reg, value, err, arg) ((void)0)
+#endif
+
+constexpr uint8_t kTraceNoReg = 0xFF;
+
 // ============================================================================
 // Lifecycle
 // ============================================================================
 
 Status ADS1115::begin(const Config& config) {
   _config = config;
+#if ADS1115_SLIM_INSTANCE
+  _bus = config.bus;
+#else
+  _ownsBus = (config.bus == nullptr);
+  if (_ownsBus) {
+    new (&_bus.own) BusConfig(config);
+  } else {
+    _bus.shared = config.bus;
+  }
+#endif
   _initialized = false;
   _driverState = DriverState::UNINIT;
   _conversionStarted = false;
   _conversionReady = false;
   _conversionStartMs = 0;
-  _lastRawValue = 0;
+  _lastSample = Sample{};
+  _acquisitionPaused = false;
+  _sampleGap = false;
+  _backpressurePauses = 0;
 
   _lastOkMs = 0;
   _lastErrorMs = 0;
@@ -109,11 +164,16 @@ Status ADS1115::begin(const Config& config) {
   _consecutiveFailures = 0;
   _totalFailures = 0;
   _totalSuccess = 0;
+  resetEnergyStats();
 
-  if (_config.i2cWrite == nullptr || _config.i2cWriteRead == nullptr) {
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr) {
+    return Status::Error(Err::INVALID_CONFIG, "Shared bus required");
+  }
+  if (bus->i2cWrite == nullptr || bus->i2cWriteRead == nullptr) {
     return Status::Error(Err::INVALID_CONFIG, "I2C callbacks required");
   }
-  if (_config.i2cTimeoutMs == 0) {
+  if (bus->i2cTimeoutMs == 0) {
     return Status::Error(Err::INVALID_CONFIG, "Timeout must be > 0");
   }
   if (_config.i2cAddress < kMinAddress || _config.i2cAddress > kMaxAddress) {
@@ -128,13 +188,24 @@ Status ADS1115::begin(const Config& config) {
   if (_config.alertRdyPin < -1) {
     return Status::Error(Err::INVALID_CONFIG, "Invalid ALERT/RDY pin");
   }
-  if (_config.alertRdyPin >= 0 && _config.gpioRead == nullptr) {
+  if (_config.alertRdyPin >= 0 && bus->gpioRead == nullptr) {
     return Status::Error(Err::INVALID_CONFIG, "ALERT/RDY gpioRead required");
   }
+  if (_config.excitationPin < -1) {
+    return Status::Error(Err::INVALID_CONFIG, "Invalid excitation pin");
+  }
+  if (_config.excitationPin >= 0 && bus->gpioWrite == nullptr) {
+    return Status::Error(Err::INVALID_CONFIG, "Excitation gpioWrite required");
+  }
 
   if (_config.offlineThreshold == 0) {
     _config.offlineThreshold = 1;
   }
+#if ADS1115_ENERGY
+  if (bus->power.enabled && bus->power.i2cClockHz == 0) {
+    return Status::Error(Err::INVALID_CONFIG, "Power model needs I2C clock");
+  }
+#endif
 
   Status st = probe();
   if (!st.ok()) {
@@ -148,6 +219,8 @@ Status ADS1115::begin(const Config& config) {
 
   _initialized = true;
   _driverState = DriverState::READY;
+  ADS1115_TRACE_EVENT(STATE_CHANGE, kTraceNoReg, DriverState::READY, Err::OK,
+                      DriverState::UNINIT);
   return Status::Ok();
 }
 
@@ -155,13 +228,25 @@ void ADS1115::tick(uint32_t nowMs) {
   if (!_initialized) {
     return;
   }
+  ADS1115_TRACE_EVENT(TICK, kTraceNoReg, 0, Err::OK, 0);
+
+  // Keeps the micros() mark well inside its 71-minute wrap
+  _energyAccount();
+
+  if (_config.mode == Mode::CONTINUOUS) {
+    // Errors are tracked by the health counters; readRaw() reports them too
+    (void)_continuousBackpressure();
+    return;
+  }
 
   if (_config.mode == Mode::SINGLE_SHOT && _conversionStarted && !_conversionReady) {
     if ((nowMs - _conversionStartMs) >= getConversionTimeMs()) {
-      if (useAlertRdyPin(_config)) {
-        if (isAlertRdyAsserted(_config)) {
+      if (useAlertRdyPin(_config, *_busConfig())) {
+        if (isAlertRdyAsserted(_config, *_busConfig())) {
           _conversionStarted = false;
           _conversionReady = true;
+          ADS1115_TRACE_EVENT(CONVERSION_READY, kTraceNoReg, 0, Err::OK,
+                              TraceReadySource::ALERT_PIN);
         }
       } else {
         uint16_t configReg = 0;
@@ -169,6 +254,8 @@ void ADS1115::tick(uint32_t nowMs) {
         if (st.ok() && ((configReg & cmd::MASK_OS) == cmd::OS_IDLE)) {
           _conversionStarted = false;
           _conversionReady = true;
+          ADS1115_TRACE_EVENT(CONVERSION_READY, kTraceNoReg, 0, Err::OK,
+                              TraceReadySource::OS_POLL);
         }
       }
     }
@@ -176,6 +263,8 @@ void ADS1115::tick(uint32_t nowMs) {
 }
 
 void ADS1115::end() {
+  _energyAccount();
+  ADS1115_TRACE_EVENT(STATE_CHANGE, kTraceNoReg, DriverState::UNINIT, Err::OK, _driverState);
   _initialized = false;
   _driverState = DriverState::UNINIT;
   _conversionStarted = false;
@@ -221,6 +310,9 @@ Status ADS1115::startConversion() {
   if (_conversionStarted) {
     return Status::Error(Err::BUSY, "Conversion already in progress");
   }
+  if (_sinkFull()) {
+    return Status::Error(Err::BUSY, "Sample sink full");
+  }
 
   uint16_t configReg = _buildConfigRegister() | cmd::OS_START;
   Status st = writeRegister16(cmd::REG_CONFIG, configReg);
@@ -231,6 +323,8 @@ Status ADS1115::startConversion() {
   _conversionStarted = true;
   _conversionReady = false;
   _conversionStartMs = millis();
+  _energyConversionStarted();
+  ADS1115_TRACE_EVENT(CONVERSION_START, cmd::REG_CONFIG, configReg, Err::OK, 0);
   return Status{Err::IN_PROGRESS, 0, "Conversion started"};
 }
 
@@ -247,6 +341,9 @@ Status ADS1115::startConversion(Mux mux) {
   if (_conversionStarted) {
     return Status::Error(Err::BUSY, "Conversion already in progress");
   }
+  if (_sinkFull()) {
+    return Status::Error(Err::BUSY, "Sample sink full");
+  }
 
   Mux prevMux = _config.mux;
   _config.mux = mux;
@@ -261,9 +358,103 @@ Status ADS1115::startConversion(Mux mux) {
   _conversionStarted = true;
   _conversionReady = false;
   _conversionStartMs = millis();
+  _energyConversionStarted();
+  ADS1115_TRACE_EVENT(CONVERSION_START, cmd::REG_CONFIG, configReg, Err::OK, 0);
   return Status{Err::IN_PROGRESS, 0, "Conversion started"};
 }
 
+Status ADS1115::startConversion(const ChannelConfig& channel) {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
+  }
+  if (!isValidMux(channel.mux) || !isValidGain(channel.gain) ||
+      !isValidDataRate(channel.dataRate)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid channel config");
+  }
+  if (_config.mode == Mode::CONTINUOUS) {
+    return Status::Error(Err::BUSY, "Continuous mode active");
+  }
+  if (_conversionStarted) {
+    return Status::Error(Err::BUSY, "Conversion already in progress");
+  }
+  if (_sinkFull()) {
+    return Status::Error(Err::BUSY, "Sample sink full");
+  }
+
+  const Mux prevMux = _config.mux;
+  const Gain prevGain = _config.gain;
+  const DataRate prevRate = _config.dataRate;
+  _config.mux = channel.mux;
+  _config.gain = channel.gain;
+  _config.dataRate = channel.dataRate;
+
+  uint16_t configReg = _buildConfigRegister() | cmd::OS_START;
+  Status st = writeRegister16(cmd::REG_CONFIG, configReg);
+  if (!st.ok()) {
+    _config.mux = prevMux;
+    _config.gain = prevGain;
+    _config.dataRate = prevRate;
+    return st;
+  }
+
+  _conversionStarted = true;
+  _conversionReady = false;
+  _conversionStartMs = millis();
+  _energyConversionStarted();
+  ADS1115_TRACE_EVENT(CONVERSION_START, cmd::REG_CONFIG, configReg, Err::OK, 0);
+  return Status{Err::IN_PROGRESS, 0, "Conversion started"};
+}
+
+Status ADS1115::preemptConversion(const ChannelConfig& urgent) {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
+  }
+  if (_config.mode == Mode::CONTINUOUS) {
+    return Status::Error(Err::BUSY, "Continuous mode active");
+  }
+  if (!_conversionStarted) {
+    return startConversion(urgent);
+  }
+  // The urgent start would be refused; keep the running conversion
+  if (_sinkFull()) {
+    return Status::Error(Err::BUSY, "Sample sink full");
+  }
+  const BusConfig* bus = _busConfig();
+  if (!bus->allowGeneralCallReset) {
+    return Status::Error(Err::BUSY, "Preemption needs general-call reset");
+  }
+
+  const uint8_t reset = cmd::GENERAL_CALL_RESET;
+  _energyI2c(1, 0);
+  Status st = _updateHealth(bus->i2cWrite(cmd::GENERAL_CALL_ADDR, &reset, 1,
+                                          bus->i2cTimeoutMs, bus->i2cUser));
+  ADS1115_TRACE_EVENT(GENERAL_CALL, kTraceNoReg, reset, st.code, 0);
+  if (!st.ok()) {
+    return st;
+  }
+  _conversionStarted = false;
+  _conversionReady = false;
+
+  // Reset restores the default thresholds; config follows with the urgent start
+  st = writeRegister16(cmd::REG_LO_THRESH, static_cast<uint16_t>(_config.compThresholdLow));
+  if (!st.ok()) {
+    return st;
+  }
+  st = writeRegister16(cmd::REG_HI_THRESH, static_cast<uint16_t>(_config.compThresholdHigh));
+  if (!st.ok()) {
+    return st;
+  }
+  return startConversion(urgent);
+}
+
+Status ADS1115::reapplyConfig() {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
+  }
+  _energyAccount();
+  return _applyConfig();
+}
+
 bool ADS1115::conversionReady() {
   if (!_initialized) {
     return false;
@@ -278,14 +469,16 @@ bool ADS1115::conversionReady() {
     return false;
   }
 
-  if (useAlertRdyPin(_config)) {
+  if (useAlertRdyPin(_config, *_busConfig())) {
     uint32_t nowMs = millis();
     if ((nowMs - _conversionStartMs) < getConversionTimeMs()) {
       return false;
     }
-    if (isAlertRdyAsserted(_config)) {
+    if (isAlertRdyAsserted(_config, *_busConfig())) {
       _conversionStarted = false;
       _conversionReady = true;
+      ADS1115_TRACE_EVENT(CONVERSION_READY, kTraceNoReg, 0, Err::OK,
+                          TraceReadySource::ALERT_PIN);
       return true;
     }
     return false;
@@ -304,12 +497,28 @@ bool ADS1115::conversionReady() {
   if ((configReg & cmd::MASK_OS) == cmd::OS_IDLE) {
     _conversionStarted = false;
     _conversionReady = true;
+    ADS1115_TRACE_EVENT(CONVERSION_READY, kTraceNoReg, 0, Err::OK,
+                        TraceReadySource::OS_POLL);
     return true;
   }
 
   return false;
 }
 
+bool ADS1115::notifyConversionReady() {
+  if (!_initialized || _config.mode != Mode::SINGLE_SHOT || !_conversionStarted) {
+    return false;
+  }
+  if (!isAlertRdyModeConfigured(_config)) {
+    return false;
+  }
+  _conversionStarted = false;
+  _conversionReady = true;
+  ADS1115_TRACE_EVENT(CONVERSION_READY, kTraceNoReg, 0, Err::OK,
+                      TraceReadySource::NOTIFY);
+  return true;
+}
+
 Status ADS1115::readRaw(int16_t& out) {
   if (!_initialized) {
     return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
@@ -317,18 +526,24 @@ Status ADS1115::readRaw(int16_t& out) {
 
   if (_config.mode == Mode::SINGLE_SHOT) {
     if (!_conversionReady) {
+      // Nothing in flight: this would only re-read the previous result
+      if (!_conversionStarted && _sinkFull()) {
+        return Status::Error(Err::BUSY, "Sample sink full");
+      }
       if (_conversionStarted) {
         uint32_t nowMs = millis();
         if ((nowMs - _conversionStartMs) < getConversionTimeMs()) {
           return Status::Error(Err::CONVERSION_NOT_READY, "Conversion not ready");
         }
       }
-      if (useAlertRdyPin(_config)) {
-        if (!isAlertRdyAsserted(_config)) {
+      if (useAlertRdyPin(_config, *_busConfig())) {
+        if (!isAlertRdyAsserted(_config, *_busConfig())) {
           return Status::Error(Err::CONVERSION_NOT_READY, "Conversion not ready");
         }
         _conversionStarted = false;
         _conversionReady = true;
+        ADS1115_TRACE_EVENT(CONVERSION_READY, kTraceNoReg, 0, Err::OK,
+                            TraceReadySource::ALERT_PIN);
       } else {
         uint16_t configReg = 0;
         Status st = readRegister16(cmd::REG_CONFIG, configReg);
@@ -340,8 +555,22 @@ Status ADS1115::readRaw(int16_t& out) {
         }
         _conversionStarted = false;
         _conversionReady = true;
+        ADS1115_TRACE_EVENT(CONVERSION_READY, kTraceNoReg, 0, Err::OK,
+                            TraceReadySource::OS_POLL);
       }
     }
+  } else {
+    Status st = _continuousBackpressure();
+    if (!st.ok()) {
+      return st;
+    }
+    if (_conversionStarted) {
+      // Restarted after a pause; the register still holds the old result
+      if ((millis() - _conversionStartMs) < getConversionTimeMs()) {
+        return Status::Error(Err::CONVERSION_NOT_READY, "Conversion not ready");
+      }
+      _conversionStarted = false;
+    }
   }
 
   uint16_t rawReg = 0;
@@ -351,15 +580,155 @@ Status ADS1115::readRaw(int16_t& out) {
   }
 
   out = static_cast<int16_t>(rawReg);
-  _lastRawValue = out;
+  _lastSample.timestampUs = micros();
+  _lastSample.seq++;
+  _lastSample.raw = out;
+  _lastSample.mux = _config.mux;
+  _lastSample.gain = _config.gain;
+  _lastSample.flags = _sampleGap ? SampleFlag::GAP : 0;
+  _sampleGap = false;
+  ADS1115_TRACE_EVENT(SAMPLE, cmd::REG_CONVERSION, rawReg, Err::OK, _config.mux);
 
   if (_config.mode == Mode::SINGLE_SHOT) {
     _conversionReady = false;
   }
 
+  if (_config.onSample != nullptr) {
+    _config.onSample(_lastSample, _config.sampleUser);
+  }
+
   return Status::Ok();
 }
 
+Status ADS1115::readBurst(int16_t* out, size_t count, BurstStats& stats, DataRate rate) {
+  stats = BurstStats{};
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
+  }
+  if (out == nullptr || count == 0) {
+    return Status::Error(Err::INVALID_PARAM, "Burst buffer empty");
+  }
+  if (!isValidDataRate(rate)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid data rate");
+  }
+  if (_config.mode == Mode::SINGLE_SHOT && _conversionStarted) {
+    return Status::Error(Err::BUSY, "Conversion already in progress");
+  }
+
+  _energyAccount();
+  const Mode prevMode = _config.mode;
+  const DataRate prevRate = _config.dataRate;
+  _config.mode = Mode::CONTINUOUS;
+  _config.dataRate = rate;
+  Status st = writeRegister16(cmd::REG_CONFIG, _buildConfigRegister());
+  if (!st.ok()) {
+    _config.mode = prevMode;
+    _config.dataRate = prevRate;
+    return st;
+  }
+
+  // Point at the conversion register once; every read then needs no write phase
+  const uint8_t reg = cmd::REG_CONVERSION;
+  const bool reusePointer = _busConfig()->i2cRead != nullptr;
+  if (reusePointer) {
+    st = _i2cWriteRaw(&reg, 1);
+  }
+
+  // First result is ready one period after the mode switch; add 1/8 period of
+  // margin for the internal oscillator and keep the same phase afterwards.
+  // With ALERT/RDY in conversion-ready mode each read waits for the pulse
+  // instead, so the device clock paces the loop and no code is read twice.
+  const uint32_t periodUs = conversionTimeUs(rate);
+  const bool synced = useAlertRdyPin(_config, *_busConfig());
+  const uint32_t switchUs = micros();
+  uint32_t dueUs = switchUs + periodUs + periodUs / 8;
+  uint32_t firstUs = 0;
+  uint32_t lastUs = 0;
+  size_t n = 0;
+  stats.synced = synced;
+  while (st.ok() && n < count) {
+    uint32_t nowUs = 0;
+    if (synced) {
+      // The pin asserted within half a period of the mode switch or of the
+      // previous read is a leftover pulse; reading on it would return a code
+      // that was already read (or one from the previous setting)
+      const uint32_t notBeforeUs = ((n == 0) ? switchUs : lastUs) + periodUs / 2;
+      const uint32_t waitFromUs = micros();
+      bool stalePulse = false;
+      for (;;) {
+        nowUs = micros();
+        if (isAlertRdyAsserted(_config, *_busConfig())) {
+          if (static_cast<int32_t>(nowUs - notBeforeUs) >= 0) {
+            break;
+          }
+          stalePulse = true;
+        }
+        if (nowUs - waitFromUs > 2 * periodUs + periodUs / 8) {
+          st = Status::Error(Err::TIMEOUT, "No ALERT/RDY pulse");
+          break;
+        }
+      }
+      if (!st.ok()) {
+        break;
+      }
+      if (stalePulse && n > 0) {
+        stats.duplicates++;
+      }
+      if (n > 0) {
+        uint32_t periods = (nowUs - lastUs + periodUs / 2) / periodUs;
+        if (periods > 1) {
+          stats.missed += periods - 1;
+        }
+      }
+    } else {
+      while (static_cast<int32_t>(micros() - dueUs) < 0) {
+      }
+      nowUs = micros();
+      uint32_t lateUs = nowUs - dueUs;
+      if (lateUs >= periodUs) {
+        uint32_t skipped = lateUs / periodUs;
+        stats.missed += skipped;
+        dueUs += skipped * periodUs;
+      }
+      dueUs += periodUs;
+    }
+
+    uint8_t rx[2] = {0, 0};
+    st = reusePointer ? _i2cReadRaw(rx, sizeof(rx))
+                      : _i2cWriteReadRaw(&reg, 1, rx, sizeof(rx));
+    if (!st.ok()) {
+      break;
+    }
+    out[n++] = static_cast<int16_t>((static_cast<uint16_t>(rx[0]) << 8) | rx[1]);
+    if (n == 1) {
+      firstUs = nowUs;
+    }
+    lastUs = nowUs;
+  }
+  // One health update for the pointer write and the whole read loop
+  if (st.code != Err::INVALID_CONFIG && st.code != Err::INVALID_PARAM) {
+    st = _updateHealth(st);
+  }
+
+  stats.samples = static_cast<uint32_t>(n);
+  stats.elapsedUs = lastUs - firstUs;
+  if (n > 1 && stats.elapsedUs > 0) {
+    stats.achievedSps = static_cast<float>(n - 1) * 1000000.0f / stats.elapsedUs;
+  }
+  ADS1115_TRACE_EVENT(BURST, cmd::REG_CONVERSION, n, Err::OK, _config.mux);
+
+  _energyAccount();
+  _config.mode = prevMode;
+  _config.dataRate = prevRate;
+  _conversionStarted = false;
+  _conversionReady = false;
+  Status restore = writeRegister16(cmd::REG_CONFIG, _buildConfigRegister());
+  if (restore.ok() && _config.mode == Mode::CONTINUOUS) {
+    _acquisitionPaused = false;
+  }
+  return st.ok() ? restore : st;
+}
+
 Status ADS1115::readVoltage(float& volts) {
   int16_t raw = 0;
   Status st = readRaw(raw);
@@ -375,11 +744,19 @@ Status ADS1115::readBlocking(int16_t& out, uint32_t timeoutMs) {
     return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
   }
   if (_config.mode == Mode::CONTINUOUS) {
-    return readRaw(out);
+    // Only waits after a backpressure restart, until the first new result
+    uint32_t deadlineMs = millis() + timeoutMs;
+    do {
+      Status readSt = readRaw(out);
+      if (readSt.code != Err::CONVERSION_NOT_READY) {
+        return readSt;
+      }
+    } while (static_cast<int32_t>(millis() - deadlineMs) < 0);
+    return Status::Error(Err::TIMEOUT, "Conversion timeout");
   }
 
   Status st = startConversion();
-  if (!(st.code == Err::IN_PROGRESS || st.code == Err::BUSY)) {
+  if (!(st.code == Err::IN_PROGRESS || (st.code == Err::BUSY && _conversionStarted))) {
     return st;
   }
 
@@ -459,6 +836,7 @@ Status ADS1115::setMode(Mode mode) {
   if (!isValidMode(mode)) {
     return Status::Error(Err::INVALID_PARAM, "Invalid mode");
   }
+  _energyAccount();
   _config.mode = mode;
   _conversionStarted = false;
   _conversionReady = false;
@@ -485,6 +863,7 @@ Status ADS1115::writeConfig(uint16_t config) {
     return st;
   }
 
+  _energyAccount();
   _config.mux = static_cast<Mux>((config & cmd::MASK_MUX) >> cmd::BIT_MUX);
   _config.gain = static_cast<Gain>((config & cmd::MASK_PGA) >> cmd::BIT_PGA);
   _config.mode = static_cast<Mode>((config & cmd::MASK_MODE) >> cmd::BIT_MODE);
@@ -494,10 +873,15 @@ Status ADS1115::writeConfig(uint16_t config) {
   _config.compLatch = static_cast<ComparatorLatch>((config & cmd::MASK_COMP_LAT) >> cmd::BIT_COMP_LAT);
   _config.compQueue = static_cast<ComparatorQueue>((config & cmd::MASK_COMP_QUE) >> cmd::BIT_COMP_QUE);
 
+  if (_config.mode == Mode::CONTINUOUS) {
+    _acquisitionPaused = false;
+  }
   if (_config.mode == Mode::SINGLE_SHOT && ((config & cmd::MASK_OS) == cmd::OS_START)) {
     _conversionStarted = true;
     _conversionReady = false;
     _conversionStartMs = millis();
+    _energyConversionStarted();
+    ADS1115_TRACE_EVENT(CONVERSION_START, cmd::REG_CONFIG, config, Err::OK, 0);
   } else {
     _conversionStarted = false;
     _conversionReady = false;
@@ -606,6 +990,10 @@ Status ADS1115::enableConversionReadyPin() {
   return _applyConfig();
 }
 
+bool ADS1115::conversionReadyPinActive() const {
+  return _initialized && useAlertRdyPin(_config, *_busConfig());
+}
+
 Status ADS1115::disableComparator() {
   if (!_initialized) {
     return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
@@ -615,83 +1003,221 @@ Status ADS1115::disableComparator() {
   return _applyConfig();
 }
 
+// ============================================================================
+// Excitation
+// ============================================================================
+
+Status ADS1115::setExcitation(bool level) {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "Driver not initialized");
+  }
+  if (_config.excitationPin < 0) {
+    return Status::Error(Err::INVALID_CONFIG, "Excitation pin not configured");
+  }
+  const BusConfig* bus = _busConfig();
+  bus->gpioWrite(_config.excitationPin, level, bus->gpioUser);
+  return Status::Ok();
+}
+
 // ============================================================================
 // Utility
 // ============================================================================
 
 float ADS1115::rawToVoltage(int16_t raw) const {
-  static constexpr float lsbTable[] = {
-    187.5e-6f,   // FSR_6_144V
-    125.0e-6f,   // FSR_4_096V
-    62.5e-6f,    // FSR_2_048V
-    31.25e-6f,   // FSR_1_024V
-    15.625e-6f,  // FSR_0_512V
-    7.8125e-6f   // FSR_0_256V
-  };
-
-  uint8_t index = static_cast<uint8_t>(_config.gain);
-  if (index >= (sizeof(lsbTable) / sizeof(lsbTable[0]))) {
-    index = static_cast<uint8_t>(Gain::FSR_2_048V);
-  }
-  return raw * lsbTable[index];
+  return raw * lsbVolts(_config.gain);
 }
 
 float ADS1115::getLsbVoltage() const {
-  static constexpr float lsbTable[] = {
-    187.5e-6f,
-    125.0e-6f,
-    62.5e-6f,
-    31.25e-6f,
-    15.625e-6f,
-    7.8125e-6f
-  };
-
-  uint8_t index = static_cast<uint8_t>(_config.gain);
-  if (index >= (sizeof(lsbTable) / sizeof(lsbTable[0]))) {
-    index = static_cast<uint8_t>(Gain::FSR_2_048V);
-  }
-  return lsbTable[index];
+  return lsbVolts(_config.gain);
 }
 
 uint32_t ADS1115::getConversionTimeMs() const {
-  static constexpr uint32_t timeTable[] = {
-    125 + 5,  // 8 SPS
-    63 + 5,   // 16 SPS
-    32 + 5,   // 32 SPS
-    16 + 5,   // 64 SPS
-    8 + 2,    // 128 SPS
-    4 + 2,    // 250 SPS
-    3 + 1,    // 475 SPS
-    2 + 1     // 860 SPS
-  };
+  // Margin over the rounded-up period for internal oscillator tolerance
+  static constexpr uint8_t marginMs[] = {5, 5, 5, 5, 2, 2, 1, 1};
 
   uint8_t index = static_cast<uint8_t>(_config.dataRate);
-  if (index >= (sizeof(timeTable) / sizeof(timeTable[0]))) {
+  if (index >= (sizeof(marginMs) / sizeof(marginMs[0]))) {
     index = static_cast<uint8_t>(DataRate::SPS_128);
   }
-  return timeTable[index];
+  return (conversionTimeUs(_config.dataRate) + 999) / 1000 + marginMs[index];
+}
+
+// ============================================================================
+// Energy Estimate
+// ============================================================================
+
+EnergyStats ADS1115::energyStats() const {
+  EnergyStats stats;
+#if ADS1115_ENERGY
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr || !bus->power.enabled) {
+    return stats;
+  }
+  const PowerModel& pm = bus->power;
+
+  uint64_t pendingUs = _initialized ? static_cast<uint32_t>(micros() - _energyMarkUs) : 0;
+  stats.elapsedUs = _energyElapsedUs + pendingUs;
+  stats.convertingUs = _energyConvertingUs;
+  if (_initialized && _config.mode == Mode::CONTINUOUS) {
+    stats.convertingUs += pendingUs;
+  }
+  if (stats.convertingUs > stats.elapsedUs) {
+    stats.convertingUs = stats.elapsedUs;
+  }
+  stats.powerDownUs = stats.elapsedUs - stats.convertingUs;
+  if (pm.i2cClockHz > 0) {
+    stats.i2cUs = (_energyI2cBits * 1000000ULL) / pm.i2cClockHz;
+  }
+  stats.conversions = _energyConversions;
+
+  // mV * nA * us = 1e-18 J; scale to microjoules
+  double charge = static_cast<double>(pm.convertingCurrentNa) * stats.convertingUs +
+                  static_cast<double>(pm.powerDownCurrentNa) * stats.powerDownUs +
+                  static_cast<double>(pm.i2cCurrentNa) * stats.i2cUs;
+  stats.energyUj = static_cast<float>(charge * pm.supplyMv * 1e-12);
+  if (stats.elapsedUs > 0) {
+    stats.averageCurrentUa = static_cast<float>(charge / stats.elapsedUs * 1e-3);
+  }
+#endif
+  return stats;
+}
+
+void ADS1115::resetEnergyStats() {
+#if ADS1115_ENERGY
+  _energyElapsedUs = 0;
+  _energyConvertingUs = 0;
+  _energyI2cBits = 0;
+  _energyConversions = 0;
+  _energyMarkUs = micros();
+#endif
+}
+
+void ADS1115::_energyAccount() {
+#if ADS1115_ENERGY
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr || !bus->power.enabled) {
+    return;
+  }
+  uint32_t nowUs = micros();
+  uint32_t dtUs = nowUs - _energyMarkUs;
+  _energyMarkUs = nowUs;
+  if (!_initialized) {
+    return;
+  }
+  _energyElapsedUs += dtUs;
+  if (_config.mode == Mode::CONTINUOUS && !_acquisitionPaused) {
+    _energyConvertingUs += dtUs;
+  }
+#endif
+}
+
+void ADS1115::_energyConversionStarted() {
+#if ADS1115_ENERGY
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr || !bus->power.enabled) {
+    return;
+  }
+  _energyConvertingUs += conversionTimeUs(_config.dataRate);
+  if (_energyConversions < UINT32_MAX) {
+    _energyConversions++;
+  }
+#endif
+}
+
+void ADS1115::_energyI2c(size_t txLen, size_t rxLen) {
+#if ADS1115_ENERGY
+  const BusConfig* bus = _busConfig();
+  if (bus != nullptr && bus->power.enabled) {
+    _energyI2cBits += i2cTransactionBits(txLen, rxLen);
+  }
+#else
+  (void)txLen;
+  (void)rxLen;
+#endif
 }
 
 // ============================================================================
 // Transport Wrappers
 // ============================================================================
 
+Status executeI2cBatch(const BusConfig& bus, const I2cOp* ops, size_t count) {
+  if (count == 0) {
+    return Status::Ok();
+  }
+  if (bus.i2cBatch != nullptr) {
+    return bus.i2cBatch(ops, count, bus.i2cTimeoutMs, bus.i2cUser);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const I2cOp& op = ops[i];
+    Status st;
+    switch (op.type) {
+      case I2cOpType::WRITE:
+        if (bus.i2cWrite == nullptr) {
+          return Status::Error(Err::INVALID_CONFIG, "I2C write callback missing");
+        }
+        st = bus.i2cWrite(op.addr, op.tx, op.txLen, bus.i2cTimeoutMs, bus.i2cUser);
+        break;
+      case I2cOpType::WRITE_READ:
+        if (bus.i2cWriteRead == nullptr) {
+          return Status::Error(Err::INVALID_CONFIG, "I2C read callback missing");
+        }
+        st = bus.i2cWriteRead(op.addr, op.tx, op.txLen, op.rx, op.rxLen,
+                              bus.i2cTimeoutMs, bus.i2cUser);
+        break;
+      case I2cOpType::READ:
+        if (bus.i2cRead == nullptr) {
+          return Status::Error(Err::INVALID_CONFIG, "I2C read-only callback missing");
+        }
+        st = bus.i2cRead(op.addr, op.rx, op.rxLen, bus.i2cTimeoutMs, bus.i2cUser);
+        break;
+      default:
+        return Status::Error(Err::INVALID_PARAM, "Invalid I2C operation");
+    }
+    if (!st.ok()) {
+      return st;
+    }
+  }
+  return Status::Ok();
+}
+
 Status ADS1115::_i2cWriteReadRaw(const uint8_t* txBuf, size_t txLen,
                                  uint8_t* rxBuf, size_t rxLen) {
-  if (_config.i2cWriteRead == nullptr) {
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr || bus->i2cWriteRead == nullptr) {
     return Status::Error(Err::INVALID_CONFIG, "I2C read callback missing");
   }
-  return _config.i2cWriteRead(_config.i2cAddress, txBuf, txLen,
-                              rxBuf, rxLen, _config.i2cTimeoutMs,
-                              _config.i2cUser);
+  _energyI2c(txLen, rxLen);
+  Status st = bus->i2cWriteRead(_config.i2cAddress, txBuf, txLen,
+                                rxBuf, rxLen, bus->i2cTimeoutMs,
+                                bus->i2cUser);
+  ADS1115_TRACE_EVENT(REG_READ, txLen > 0 ? txBuf[0] : kTraceNoReg,
+                      rxLen >= 2 ? (rxBuf[0] << 8) | rxBuf[1] : 0, st.code, 0);
+  return st;
 }
 
 Status ADS1115::_i2cWriteRaw(const uint8_t* buf, size_t len) {
-  if (_config.i2cWrite == nullptr) {
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr || bus->i2cWrite == nullptr) {
     return Status::Error(Err::INVALID_CONFIG, "I2C write callback missing");
   }
-  return _config.i2cWrite(_config.i2cAddress, buf, len,
-                          _config.i2cTimeoutMs, _config.i2cUser);
+  _energyI2c(len, 0);
+  Status st = bus->i2cWrite(_config.i2cAddress, buf, len,
+                            bus->i2cTimeoutMs, bus->i2cUser);
+  ADS1115_TRACE_EVENT(REG_WRITE, len > 0 ? buf[0] : kTraceNoReg,
+                      len >= 3 ? (buf[1] << 8) | buf[2] : 0, st.code, 0);
+  return st;
+}
+
+Status ADS1115::_i2cReadRaw(uint8_t* rxBuf, size_t rxLen) {
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr || bus->i2cRead == nullptr) {
+    return Status::Error(Err::INVALID_CONFIG, "I2C read-only callback missing");
+  }
+  _energyI2c(0, rxLen);
+  Status st = bus->i2cRead(_config.i2cAddress, rxBuf, rxLen, bus->i2cTimeoutMs, bus->i2cUser);
+  ADS1115_TRACE_EVENT(REG_READ_CURRENT, kTraceNoReg,
+                      rxLen >= 2 ? (rxBuf[0] << 8) | rxBuf[1] : 0, st.code, 0);
+  return st;
 }
 
 Status ADS1115::_i2cWriteReadTracked(const uint8_t* txBuf, size_t txLen,
@@ -711,6 +1237,39 @@ Status ADS1115::_i2cWriteTracked(const uint8_t* buf, size_t len) {
   return _updateHealth(st);
 }
 
+Status ADS1115::_i2cBatchTracked(const I2cOp* ops, size_t count) {
+  const BusConfig* bus = _busConfig();
+  if (bus == nullptr) {
+    return Status::Error(Err::INVALID_CONFIG, "I2C write callback missing");
+  }
+  for (size_t i = 0; i < count; ++i) {
+    _energyI2c(ops[i].txLen, ops[i].rxLen);
+  }
+  Status st = executeI2cBatch(*bus, ops, count);
+  ADS1115_TRACE_EVENT(BATCH, kTraceNoReg, count, st.code, 0);
+#if ADS1115_TRACE
+  for (size_t i = 0; i < count; ++i) {
+    const I2cOp& op = ops[i];
+    if (op.type == I2cOpType::WRITE) {
+      ADS1115_TRACE_EVENT(REG_WRITE, op.txLen > 0 ? op.tx[0] : kTraceNoReg,
+                          op.txLen >= 3 ? (op.tx[1] << 8) | op.tx[2] : 0, st.code, 1);
+    } else {
+      ADS1115_TRACE_EVENT(REG_READ, op.txLen > 0 ? op.tx[0] : kTraceNoReg,
+                          op.rxLen >= 2 ? (op.rx[0] << 8) | op.rx[1] : 0, st.code, 1);
+    }
+  }
+#endif
+  if (st.code == Err::INVALID_CONFIG || st.code == Err::INVALID_PARAM) {
+    return st;
+  }
+  // Health counts operations, as if each had been its own transaction; a
+  // failed batch counts once since the failing operation is not known
+  for (size_t i = 1; st.ok() && i < count; ++i) {
+    (void)_updateHealth(st);
+  }
+  return _updateHealth(st);
+}
+
 // ============================================================================
 // Register Access
 // ============================================================================
@@ -750,6 +1309,9 @@ Status ADS1115::_readRegister16Raw(uint8_t reg, uint16_t& value) {
 
 Status ADS1115::_updateHealth(const Status& st) {
   uint32_t nowMs = millis();
+#if ADS1115_TRACE
+  const DriverState prevState = _driverState;
+#endif
 
   if (st.ok() || st.inProgress()) {
     _lastOkMs = nowMs;
@@ -781,34 +1343,107 @@ Status ADS1115::_updateHealth(const Status& st) {
     }
   }
 
+#if ADS1115_TRACE
+  if (_driverState != prevState) {
+    ADS1115_TRACE_EVENT(STATE_CHANGE, kTraceNoReg, _driverState, st.code, prevState);
+  }
+#endif
   return st;
 }
 
 // ============================================================================
-// Internal
+// Backpressure
 // ============================================================================
 
-Status ADS1115::_applyConfig() {
-  Status st = writeRegister16(cmd::REG_LO_THRESH,
-                              static_cast<uint16_t>(_config.compThresholdLow));
-  if (!st.ok()) {
-    return st;
+bool ADS1115::_sinkFull() {
+  if (_config.sampleBackpressure == nullptr) {
+    return false;
+  }
+  const bool full = _config.sampleBackpressure(_config.sampleUser);
+  if (full != _acquisitionPaused) {
+    _energyAccount();
+    if (full) {
+      _backpressurePauses++;
+      _sampleGap = true;
+    }
   }
-  st = writeRegister16(cmd::REG_HI_THRESH,
-                       static_cast<uint16_t>(_config.compThresholdHigh));
+  _acquisitionPaused = full;
+  return full;
+}
+
+Status ADS1115::_continuousBackpressure() {
+  const bool wasPaused = _acquisitionPaused;
+  if (_sinkFull()) {
+    if (wasPaused) {
+      return Status::Error(Err::BUSY, "Sample sink full");
+    }
+    // Single-shot without OS_START: the device finishes the current
+    // conversion and powers down
+    const uint16_t configReg =
+        static_cast<uint16_t>((_buildConfigRegister() & ~cmd::MASK_MODE) | cmd::MODE_SINGLE_SHOT);
+    Status st = writeRegister16(cmd::REG_CONFIG, configReg);
+    if (!st.ok()) {
+      _acquisitionPaused = false;
+      return st;
+    }
+    return Status::Error(Err::BUSY, "Sample sink full");
+  }
+  if (!wasPaused) {
+    return Status::Ok();
+  }
+
+  Status st = writeRegister16(cmd::REG_CONFIG, _buildConfigRegister());
   if (!st.ok()) {
+    _acquisitionPaused = true;
     return st;
   }
-  st = writeRegister16(cmd::REG_CONFIG, _buildConfigRegister());
+  // First result after the restart is one period away
+  _conversionStarted = true;
+  _conversionStartMs = millis();
+  return Status::Ok();
+}
+
+// ============================================================================
+// Internal
+// ============================================================================
+
+Status ADS1115::_applyConfig() {
+  const uint16_t low = static_cast<uint16_t>(_config.compThresholdLow);
+  const uint16_t high = static_cast<uint16_t>(_config.compThresholdHigh);
+  const uint16_t config = _buildConfigRegister();
+  const uint8_t tx[3][3] = {
+    {cmd::REG_LO_THRESH, static_cast<uint8_t>(low >> 8), static_cast<uint8_t>(low & 0xFF)},
+    {cmd::REG_HI_THRESH, static_cast<uint8_t>(high >> 8), static_cast<uint8_t>(high & 0xFF)},
+    {cmd::REG_CONFIG, static_cast<uint8_t>(config >> 8), static_cast<uint8_t>(config & 0xFF)}
+  };
+  I2cOp ops[3];
+  for (size_t i = 0; i < 3; ++i) {
+    ops[i].type = I2cOpType::WRITE;
+    ops[i].addr = _config.i2cAddress;
+    ops[i].tx = tx[i];
+    ops[i].txLen = sizeof(tx[i]);
+  }
+  Status st = _i2cBatchTracked(ops, 3);
   if (!st.ok()) {
     return st;
   }
 
   _conversionStarted = false;
   _conversionReady = false;
+  if (_config.mode == Mode::CONTINUOUS) {
+    _acquisitionPaused = false;
+  }
   return Status::Ok();
 }
 
+const BusConfig* ADS1115::_busConfig() const {
+#if ADS1115_SLIM_INSTANCE
+  return _bus;
+#else
+  return _ownsBus ? &_bus.own : _bus.shared;
+#endif
+}
+
 uint16_t ADS1115::_buildConfigRegister() const {
   uint16_t config = 0;
   config |= (static_cast<uint16_t>(_config.mux) << cmd::BIT_MUX) & cmd::MASK_MUX;
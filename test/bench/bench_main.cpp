@@ -0,0 +1,496 @@
+/// @file bench_main.cpp
+/// @brief Host microbenchmarks for the ADS1115 driver hot paths
+/// @note Runs the real driver against the in-memory simulator. Prints one JSON
+///       document to stdout and exits non-zero when a regression limit is hit.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ADS1115/ADS1115.h"
+#include "sim/Ads1115Sim.h"
+#include "sim/ChromeTrace.h"
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+// ============================================================================
+// Instruction Counter
+// ============================================================================
+
+/// Retired user-space instructions via perf_event_open (Linux only)
+class InstructionCounter {
+public:
+  InstructionCounter() {
+#if defined(__linux__)
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  ~InstructionCounter() {
+#if defined(__linux__)
+    if (_fd >= 0) {
+      close(_fd);
+    }
+#endif
+  }
+
+  bool available() const { return _fd >= 0; }
+
+  void start() {
+#if defined(__linux__)
+    if (_fd >= 0) {
+      ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  uint64_t stop() {
+    uint64_t count = 0;
+#if defined(__linux__)
+    if (_fd >= 0) {
+      ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(_fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+        count = 0;
+      }
+    }
+#endif
+    return count;
+  }
+
+private:
+  int _fd = -1;
+};
+
+// ============================================================================
+// Fixture
+// ============================================================================
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+ADS1115::Config baseConfig;
+volatile int32_t sink = 0;
+sim::ChromeTrace* activeTrace = nullptr;
+
+void resetFixture(ADS1115::Mode mode) {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 0;
+  simDevice.reset();
+  simDevice.setInput(0, 1.0f);
+  simDevice.setInput(1, 0.5f);
+  baseConfig = ADS1115::Config{};
+  sim::attachTransport(baseConfig, simBus);
+  baseConfig.mode = mode;
+  device.begin(baseConfig);
+  simBus.resetCounters();
+}
+
+void setupSingleShot() { resetFixture(ADS1115::Mode::SINGLE_SHOT); }
+void setupContinuous() {
+  resetFixture(ADS1115::Mode::CONTINUOUS);
+  stub::nowUs += 10000;
+}
+void setupBatched() {
+  resetFixture(ADS1115::Mode::SINGLE_SHOT);
+  baseConfig.i2cBatch = sim::i2cBatch;
+  device.begin(baseConfig);
+  simBus.resetCounters();
+}
+void setupBlocking() {
+  resetFixture(ADS1115::Mode::SINGLE_SHOT);
+  stub::autoAdvanceUs = 500;
+}
+void setupBurst() {
+  resetFixture(ADS1115::Mode::SINGLE_SHOT);
+  stub::autoAdvanceUs = 50;
+}
+void setupPreempt() {
+  resetFixture(ADS1115::Mode::SINGLE_SHOT);
+  baseConfig.allowGeneralCallReset = true;
+  device.begin(baseConfig);
+  simBus.resetCounters();
+}
+void setupAlertRdy() {
+  resetFixture(ADS1115::Mode::SINGLE_SHOT);
+  device.enableConversionReadyPin();
+  simBus.resetCounters();
+}
+
+// ============================================================================
+// Operations
+// ============================================================================
+
+void opBegin() { sink = sink + device.begin(baseConfig).ok(); }
+void opProbe() { sink = sink + device.probe().ok(); }
+void opTickIdle() { device.tick(millis()); }
+void opReadConfig() {
+  uint16_t config = 0;
+  device.readConfig(config);
+  sink = sink + config;
+}
+void opWriteConfig() { sink = sink + device.writeConfig(0x8583).ok(); }
+void opSetMux() { sink = sink + device.setMux(ADS1115::Mux::AIN1_GND).ok(); }
+void opSetGain() { sink = sink + device.setGain(ADS1115::Gain::FSR_4_096V).ok(); }
+void opSetDataRate() { sink = sink + device.setDataRate(ADS1115::DataRate::SPS_860).ok(); }
+void opSetMode() {
+  static bool continuous = false;
+  continuous = !continuous;
+  sink = sink + device.setMode(continuous ? ADS1115::Mode::CONTINUOUS
+                                          : ADS1115::Mode::SINGLE_SHOT).ok();
+}
+void opSetComparatorMode() {
+  sink = sink + device.setComparatorMode(ADS1115::ComparatorMode::WINDOW).ok();
+}
+void opSetComparatorPolarity() {
+  sink = sink + device.setComparatorPolarity(ADS1115::ComparatorPolarity::ACTIVE_HIGH).ok();
+}
+void opSetComparatorLatch() {
+  sink = sink + device.setComparatorLatch(ADS1115::ComparatorLatch::LATCHING).ok();
+}
+void opSetComparatorQueue() {
+  sink = sink + device.setComparatorQueue(ADS1115::ComparatorQueue::ASSERT_4).ok();
+}
+void opEnableConversionReadyPin() { sink = sink + device.enableConversionReadyPin().ok(); }
+void opDisableComparator() { sink = sink + device.disableComparator().ok(); }
+void opRecover() { sink = sink + device.recover().ok(); }
+void opSetThresholds() { sink = sink + device.setThresholds(-100, 100).ok(); }
+void opGetThresholds() {
+  int16_t low = 0;
+  int16_t high = 0;
+  device.getThresholds(low, high);
+  sink = sink + low + high;
+}
+void opReadRawContinuous() {
+  int16_t raw = 0;
+  device.readRaw(raw);
+  sink = sink + raw;
+}
+void opReadVoltageContinuous() {
+  float volts = 0.0f;
+  device.readVoltage(volts);
+  sink = sink + static_cast<int32_t>(volts * 1000.0f);
+}
+void opConversionReadyPending() {
+  if (!device.conversionReady()) {
+    sink = sink + 1;
+  }
+}
+void opSingleShotCycle() {
+  device.startConversion();
+  stub::nowUs += 10000;
+  int16_t raw = 0;
+  device.readRaw(raw);
+  sink = sink + raw;
+}
+void opReadBlocking() {
+  int16_t raw = 0;
+  device.readBlocking(raw);
+  sink = sink + raw;
+}
+void opReadBlockingVoltage() {
+  float volts = 0.0f;
+  device.readBlockingVoltage(volts);
+  sink = sink + static_cast<int32_t>(volts * 1000.0f);
+}
+void opReadBurst() {
+  int16_t codes[8];
+  ADS1115::BurstStats stats;
+  device.readBurst(codes, 8, stats);
+  sink = sink + codes[7] + static_cast<int32_t>(stats.missed);
+}
+void opStartConversionChannel() {
+  ADS1115::ChannelConfig channel;
+  channel.mux = ADS1115::Mux::AIN1_GND;
+  channel.dataRate = ADS1115::DataRate::SPS_860;
+  device.startConversion(channel);
+  stub::nowUs += 3000;
+  int16_t raw = 0;
+  device.readRaw(raw);
+  sink = sink + raw;
+}
+void opPreemptConversion() {
+  ADS1115::ChannelConfig urgent;
+  urgent.mux = ADS1115::Mux::AIN1_GND;
+  sink = sink + device.preemptConversion(urgent).inProgress();
+}
+void opNotifyConversionReady() {
+  device.startConversion();
+  sink = sink + device.notifyConversionReady();
+  int16_t raw = 0;
+  device.readRaw(raw);
+  sink = sink + raw;
+}
+void opRawToVoltage() {
+  sink = sink + static_cast<int32_t>(device.rawToVoltage(static_cast<int16_t>(sink)) * 1000.0f);
+}
+void opGetConversionTimeMs() { sink = sink + static_cast<int32_t>(device.getConversionTimeMs()); }
+
+void setupPending() {
+  setupSingleShot();
+  device.startConversion();
+  simBus.resetCounters();
+}
+
+// ============================================================================
+// Benchmark Table
+// ============================================================================
+
+/// One benchmark and its regression limits
+/// @note Transaction limits always apply; a zero time/instruction limit is ignored
+struct Benchmark {
+  const char* name;
+  void (*setup)();
+  void (*op)();
+  double maxTransactionsPerOp;
+  double maxNsPerOp;
+  double maxInstructionsPerOp;
+};
+
+// Transaction limits are exact. Time and instruction limits sit roughly 5x above
+// an -O2 x86-64 host build so only real regressions trip them; use --ns-scale
+// on slower hosts.
+const Benchmark kBenchmarks[] = {
+  {"begin", setupSingleShot, opBegin, 4.0, 400.0, 3000.0},
+  {"probe", setupSingleShot, opProbe, 1.0, 100.0, 700.0},
+  {"tick_idle", setupSingleShot, opTickIdle, 0.0, 25.0, 150.0},
+  {"readConfig", setupSingleShot, opReadConfig, 1.0, 150.0, 1000.0},
+  {"writeConfig", setupSingleShot, opWriteConfig, 1.0, 150.0, 1000.0},
+  {"setMux", setupSingleShot, opSetMux, 3.0, 300.0, 2000.0},
+  {"setGain", setupSingleShot, opSetGain, 3.0, 300.0, 2000.0},
+  {"setGain_batched", setupBatched, opSetGain, 3.0, 300.0, 2000.0},
+  {"setDataRate", setupSingleShot, opSetDataRate, 3.0, 300.0, 2000.0},
+  {"setMode", setupSingleShot, opSetMode, 3.0, 300.0, 2000.0},
+  {"setComparatorMode", setupSingleShot, opSetComparatorMode, 3.0, 300.0, 2000.0},
+  {"setComparatorPolarity", setupSingleShot, opSetComparatorPolarity, 3.0, 300.0, 2000.0},
+  {"setComparatorLatch", setupSingleShot, opSetComparatorLatch, 3.0, 300.0, 2000.0},
+  {"setComparatorQueue", setupSingleShot, opSetComparatorQueue, 3.0, 300.0, 2000.0},
+  {"enableConversionReadyPin", setupSingleShot, opEnableConversionReadyPin, 3.0, 300.0, 2000.0},
+  {"disableComparator", setupSingleShot, opDisableComparator, 3.0, 300.0, 2000.0},
+  {"recover", setupSingleShot, opRecover, 1.0, 100.0, 700.0},
+  {"setThresholds", setupSingleShot, opSetThresholds, 2.0, 200.0, 1400.0},
+  {"getThresholds", setupSingleShot, opGetThresholds, 2.0, 250.0, 1800.0},
+  {"readRaw_continuous", setupContinuous, opReadRawContinuous, 1.0, 150.0, 1000.0},
+  {"readVoltage_continuous", setupContinuous, opReadVoltageContinuous, 1.0, 200.0, 1400.0},
+  {"conversionReady_pending", setupPending, opConversionReadyPending, 0.0, 30.0, 200.0},
+  {"single_shot_cycle", setupSingleShot, opSingleShotCycle, 3.0, 400.0, 3000.0},
+  {"readBlocking", setupBlocking, opReadBlocking, 3.0, 500.0, 3500.0},
+  {"readBlockingVoltage", setupBlocking, opReadBlockingVoltage, 3.0, 500.0, 3500.0},
+  {"readBurst_8", setupBurst, opReadBurst, 11.0, 2500.0, 20000.0},
+  {"startConversion_channel", setupSingleShot, opStartConversionChannel, 3.0, 400.0, 3000.0},
+  {"preemptConversion", setupPreempt, opPreemptConversion, 4.0, 500.0, 3500.0},
+  {"notifyConversionReady", setupAlertRdy, opNotifyConversionReady, 2.0, 300.0, 2000.0},
+  {"rawToVoltage", setupSingleShot, opRawToVoltage, 0.0, 60.0, 400.0},
+  {"getConversionTimeMs", setupSingleShot, opGetConversionTimeMs, 0.0, 20.0, 150.0},
+};
+
+struct Result {
+  double nsPerOp = 0.0;
+  double instructionsPerOp = -1.0;
+  double transactionsPerOp = 0.0;
+  double batchesPerOp = 0.0;  ///< i2cBatch calls; each joins its transactions
+  double wireUsPerOp = 0.0;
+  double busUtilizationPct = 0.0;
+};
+
+Result runBenchmark(const Benchmark& bench, uint32_t iterations, InstructionCounter& counter) {
+  bench.setup();
+  for (uint32_t i = 0; i < iterations / 10 + 1; ++i) {
+    bench.op();
+  }
+
+  bench.setup();
+  auto t0 = std::chrono::steady_clock::now();
+  counter.start();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    bench.op();
+  }
+  uint64_t instructions = counter.stop();
+  auto t1 = std::chrono::steady_clock::now();
+
+  Result result;
+  double ns = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+  result.nsPerOp = ns / iterations;
+  if (counter.available()) {
+    result.instructionsPerOp = static_cast<double>(instructions) / iterations;
+  }
+  result.transactionsPerOp =
+      static_cast<double>(simBus.counters().transactions()) / iterations;
+  result.batchesPerOp = static_cast<double>(simBus.counters().batches) / iterations;
+  result.wireUsPerOp = static_cast<double>(simBus.counters().busyNs) / 1000.0 / iterations;
+  result.busUtilizationPct = simBus.utilizationPct();
+  return result;
+}
+
+/// Wire-limited throughput of one operation at a given SCL frequency
+double wireLimitedOpsPerSec(const Benchmark& bench, uint32_t sclHz) {
+  sim::WireTiming timing;
+  timing.sclHz = sclHz;
+  simBus.setTiming(timing);
+  bench.setup();
+  constexpr uint32_t kOps = 1000;
+  for (uint32_t i = 0; i < kOps; ++i) {
+    bench.op();
+  }
+  double busyUs = static_cast<double>(simBus.counters().busyNs) / 1000.0;
+  return busyUs > 0.0 ? kOps * 1.0e6 / busyUs : 0.0;
+}
+
+const Benchmark& findBenchmark(const char* name) {
+  for (const Benchmark& bench : kBenchmarks) {
+    if (std::strcmp(bench.name, name) == 0) {
+      return bench;
+    }
+  }
+  return kBenchmarks[0];
+}
+
+bool exceeds(double value, double limit) { return limit > 0.0 && value > limit; }
+
+/// Timeline of a few operations of every benchmark, one section per case
+bool writeTrace(const char* path, const sim::WireTiming& timing) {
+  constexpr uint32_t kTraceOps = 8;
+  constexpr uint64_t kGapUs = 100;
+  sim::ChromeTrace trace;
+  if (!trace.open(path)) {
+    return false;
+  }
+  simBus.setTiming(timing);
+  trace.addBus(simBus, "sim bus");
+  activeTrace = &trace;
+  for (const Benchmark& bench : kBenchmarks) {
+    trace.setTimeOffsetUs(trace.endUs() + kGapUs);
+    bench.setup();
+    for (uint32_t i = 0; i < kTraceOps; ++i) {
+      bench.op();
+    }
+    uint64_t endUs = stub::nowUs;
+    if (trace.endUs() > trace.timeOffsetUs() + endUs) {
+      endUs = trace.endUs() - trace.timeOffsetUs();
+    }
+    trace.section(bench.name, 0, endUs);
+  }
+  activeTrace = nullptr;
+  trace.close();
+  return true;
+}
+
+} // namespace
+
+#if ADS1115_TRACE
+namespace ADS1115 {
+void traceSink(const TraceRecord& rec) {
+  if (activeTrace != nullptr) {
+    activeTrace->record(rec);
+  }
+}
+} // namespace ADS1115
+#endif
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+  uint32_t iterations = 200000;
+  bool enforceLimits = true;
+  double nsScale = 1.0;
+  sim::WireTiming timing;
+  const char* tracePath = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--no-limits") == 0) {
+      enforceLimits = false;
+    } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      iterations = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--ns-scale") == 0 && i + 1 < argc) {
+      nsScale = std::strtod(argv[++i], nullptr);
+    } else if (std::strcmp(argv[i], "--scl-hz") == 0 && i + 1 < argc) {
+      timing.sclHz = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      tracePath = argv[++i];
+    }
+  }
+  if (iterations == 0) {
+    iterations = 1;
+  }
+
+  simBus.attach(&simDevice);
+  InstructionCounter counter;
+  bool allPassed = true;
+
+  printf("{\n  \"iterations\": %lu,\n  \"scl_hz\": %lu,\n  \"benchmarks\": [\n",
+         static_cast<unsigned long>(iterations), static_cast<unsigned long>(timing.sclHz));
+  const size_t count = sizeof(kBenchmarks) / sizeof(kBenchmarks[0]);
+  for (size_t i = 0; i < count; ++i) {
+    const Benchmark& bench = kBenchmarks[i];
+    simBus.setTiming(timing);
+    Result r = runBenchmark(bench, iterations, counter);
+
+    // Transactions must never exceed the limit, even where the limit is zero.
+    bool pass = r.transactionsPerOp <= bench.maxTransactionsPerOp + 1e-9;
+    pass = pass && !exceeds(r.nsPerOp, bench.maxNsPerOp * nsScale);
+    if (r.instructionsPerOp >= 0.0) {
+      pass = pass && !exceeds(r.instructionsPerOp, bench.maxInstructionsPerOp);
+    }
+    if (enforceLimits && !pass) {
+      allPassed = false;
+    }
+
+    printf("    {\"name\": \"%s\", \"ns_per_op\": %.1f, ", bench.name, r.nsPerOp);
+    if (r.instructionsPerOp >= 0.0) {
+      printf("\"instructions_per_op\": %.1f, ", r.instructionsPerOp);
+    } else {
+      printf("\"instructions_per_op\": null, ");
+    }
+    printf("\"transactions_per_op\": %.3f, \"batches_per_op\": %.3f, ", r.transactionsPerOp,
+           r.batchesPerOp);
+    printf("\"wire_us_per_op\": %.2f, ", r.wireUsPerOp);
+    printf("\"bus_utilization_pct\": %.1f, \"pass\": %s}%s\n", r.busUtilizationPct,
+           pass ? "true" : "false", (i + 1 < count) ? "," : "");
+  }
+  printf("  ],\n");
+
+  // Upper bound on sample throughput imposed by the bus alone
+  static constexpr uint32_t kSclRates[] = {100000, 400000, 1000000, 3400000};
+  const Benchmark& continuous = findBenchmark("readRaw_continuous");
+  const Benchmark& singleShot = findBenchmark("single_shot_cycle");
+  printf("  \"wire_limits\": [\n");
+  for (size_t i = 0; i < sizeof(kSclRates) / sizeof(kSclRates[0]); ++i) {
+    printf("    {\"scl_hz\": %lu, \"%s_ops_per_s\": %.0f, \"%s_ops_per_s\": %.0f}%s\n",
+           static_cast<unsigned long>(kSclRates[i]), continuous.name,
+           wireLimitedOpsPerSec(continuous, kSclRates[i]), singleShot.name,
+           wireLimitedOpsPerSec(singleShot, kSclRates[i]),
+           (i + 1 < sizeof(kSclRates) / sizeof(kSclRates[0])) ? "," : "");
+  }
+  printf("  ],\n  \"pass\": %s\n}\n", allPassed ? "true" : "false");
+
+  if (tracePath != nullptr && !writeTrace(tracePath, timing)) {
+    fprintf(stderr, "cannot write %s\n", tracePath);
+    return 1;
+  }
+
+  return allPassed ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/// @file capacity_main.cpp
+/// @brief Capacity planner: N simulated ADS1115s on M buses against virtual time
+/// @note Runs the real driver and scheduler through sim::System and prints one
+///       JSON document with per-channel SPS, data-age percentiles and bus
+///       utilization.
+///
+///   capacity --buses 2 --devices 4 --channels 4 --scl-hz 400000 --sps 860
+///            --policy scan|edf|continuous [--period-us 10000] [--poll-us 100]
+///            [--alert] [--batch] [--duration-ms 1000] [--trace FILE]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "sim/ChromeTrace.h"
+#include "sim/SystemSim.h"
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::System simSystem;
+sim::ChromeTrace* activeTrace = nullptr;
+
+const char* kPolicyNames[] = {"scan", "edf", "continuous"};
+constexpr unsigned long kRates[] = {8, 16, 32, 64, 128, 250, 475, 860};
+
+bool parseRate(unsigned long sps, ADS1115::DataRate& out) {
+  for (size_t i = 0; i < sizeof(kRates) / sizeof(kRates[0]); ++i) {
+    if (kRates[i] == sps) {
+      out = static_cast<ADS1115::DataRate>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parsePolicy(const char* name, sim::ScanPolicy& out) {
+  for (size_t i = 0; i < sizeof(kPolicyNames) / sizeof(kPolicyNames[0]); ++i) {
+    if (std::strcmp(kPolicyNames[i], name) == 0) {
+      out = static_cast<sim::ScanPolicy>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parseArgs(int argc, char** argv, sim::SystemConfig& cfg, const char*& tracePath) {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    if (std::strcmp(arg, "--alert") == 0) {
+      cfg.alertPin = true;
+      continue;
+    }
+    if (std::strcmp(arg, "--batch") == 0) {
+      cfg.batch = true;
+      continue;
+    }
+    if (value == nullptr) {
+      return false;
+    }
+    ++i;
+    unsigned long n = std::strtoul(value, nullptr, 10);
+    if (std::strcmp(arg, "--buses") == 0) {
+      cfg.buses = static_cast<uint8_t>(n);
+    } else if (std::strcmp(arg, "--devices") == 0) {
+      cfg.devicesPerBus = static_cast<uint8_t>(n);
+    } else if (std::strcmp(arg, "--channels") == 0) {
+      cfg.channelsPerDevice = static_cast<uint8_t>(n);
+    } else if (std::strcmp(arg, "--scl-hz") == 0) {
+      cfg.sclHz = static_cast<uint32_t>(n);
+    } else if (std::strcmp(arg, "--sps") == 0) {
+      if (!parseRate(n, cfg.dataRate)) {
+        return false;
+      }
+    } else if (std::strcmp(arg, "--policy") == 0) {
+      if (!parsePolicy(value, cfg.policy)) {
+        return false;
+      }
+    } else if (std::strcmp(arg, "--period-us") == 0) {
+      cfg.periodUs = static_cast<uint32_t>(n);
+    } else if (std::strcmp(arg, "--poll-us") == 0) {
+      cfg.pollUs = static_cast<uint32_t>(n);
+    } else if (std::strcmp(arg, "--duration-ms") == 0) {
+      cfg.durationMs = static_cast<uint32_t>(n);
+    } else if (std::strcmp(arg, "--trace") == 0) {
+      tracePath = value;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+#if ADS1115_TRACE
+namespace ADS1115 {
+void traceSink(const TraceRecord& rec) {
+  if (activeTrace != nullptr) {
+    activeTrace->record(rec, simSystem.activeBus());
+  }
+}
+} // namespace ADS1115
+#endif
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+  sim::SystemConfig cfg;
+  const char* tracePath = nullptr;
+  if (!parseArgs(argc, argv, cfg, tracePath)) {
+    fprintf(stderr,
+            "usage: %s [--buses M] [--devices N] [--channels C] [--scl-hz HZ] [--sps SPS]\n"
+            "          [--policy scan|edf|continuous] [--period-us US] [--poll-us US]\n"
+            "          [--alert] [--batch] [--duration-ms MS] [--trace FILE]\n",
+            argv[0]);
+    return 2;
+  }
+
+  ADS1115::Status st = simSystem.configure(cfg);
+  if (!st.ok()) {
+    fprintf(stderr, "configure: %s\n", st.msg);
+    return 2;
+  }
+  sim::ChromeTrace trace;
+  if (tracePath != nullptr) {
+    if (!trace.open(tracePath)) {
+      fprintf(stderr, "cannot write %s\n", tracePath);
+      return 1;
+    }
+    simSystem.attachTrace(trace);
+    activeTrace = &trace;
+  }
+  simSystem.run();
+  activeTrace = nullptr;
+  trace.close();
+
+  printf("{\n  \"buses\": %u, \"devices_per_bus\": %u, \"scl_hz\": %lu, \"sps\": %lu,\n",
+         cfg.buses, cfg.devicesPerBus, static_cast<unsigned long>(cfg.sclHz),
+         kRates[static_cast<uint8_t>(cfg.dataRate)]);
+  printf("  \"policy\": \"%s\", \"alert\": %s, \"batch\": %s, \"duration_ms\": %lu,\n",
+         kPolicyNames[static_cast<uint8_t>(cfg.policy)], cfg.alertPin ? "true" : "false",
+         cfg.batch ? "true" : "false", static_cast<unsigned long>(cfg.durationMs));
+
+  printf("  \"bus_report\": [\n");
+  for (size_t b = 0; b < simSystem.busCount(); ++b) {
+    sim::BusReport r = simSystem.busReport(b);
+    printf("    {\"bus\": %u, \"transactions\": %lu, \"bytes\": %lu, \"utilization_pct\": %.1f}%s\n",
+           static_cast<unsigned>(b), static_cast<unsigned long>(r.transactions),
+           static_cast<unsigned long>(r.bytes), static_cast<double>(r.utilizationPct),
+           (b + 1 < simSystem.busCount()) ? "," : "");
+  }
+  printf("  ],\n  \"channels\": [\n");
+
+  double totalSps = 0.0;
+  double minSps = 0.0;
+  uint32_t worstP99 = 0;
+  const size_t count = simSystem.channelCount();
+  for (size_t i = 0; i < count; ++i) {
+    sim::ChannelReport r = simSystem.channelReport(i);
+    totalSps += r.sps;
+    minSps = (i == 0 || r.sps < minSps) ? r.sps : minSps;
+    worstP99 = r.p99Us > worstP99 ? r.p99Us : worstP99;
+    printf("    {\"bus\": %u, \"addr\": \"0x%02X\", \"ain\": %u, \"sps\": %.1f, "
+           "\"p50_us\": %lu, \"p90_us\": %lu, \"p99_us\": %lu, \"max_us\": %lu, "
+           "\"stale\": %lu, \"released\": %lu, \"overruns\": %lu, \"misses\": %lu}%s\n",
+           r.bus, r.addr, r.channel, static_cast<double>(r.sps),
+           static_cast<unsigned long>(r.p50Us), static_cast<unsigned long>(r.p90Us),
+           static_cast<unsigned long>(r.p99Us), static_cast<unsigned long>(r.maxUs),
+           static_cast<unsigned long>(r.stale), static_cast<unsigned long>(r.released),
+           static_cast<unsigned long>(r.overruns), static_cast<unsigned long>(r.misses),
+           (i + 1 < count) ? "," : "");
+  }
+  printf("  ],\n  \"total_sps\": %.1f, \"min_channel_sps\": %.1f, \"worst_p99_us\": %lu\n}\n",
+         totalSps, minSps, static_cast<unsigned long>(worstP99));
+  return 0;
+}
@@ -0,0 +1,170 @@
+/// @file test_main.cpp
+/// @brief Energy estimate (Config::power) against the simulator clock
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+
+bool sinkFull = false;
+bool fakeSink(void* user) {
+  (void)user;
+  return sinkFull;
+}
+
+void startDriver(Mode mode, bool power = true) {
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  config.mode = mode;
+  config.dataRate = DataRate::SPS_128;
+  config.power.enabled = power;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  device.resetEnergyStats();
+}
+
+/// One reading every @p periodUs for @p count periods
+void sampleEvery(uint32_t periodUs, uint32_t count) {
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint64_t startUs = stub::nowUs;
+    int16_t raw = 0;
+    TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+    stub::nowUs = startUs + periodUs;
+  }
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 10;
+  simDevice.reset();
+  simDevice.setInput(0, 0.5f);
+  sinkFull = false;
+}
+
+void tearDown() {}
+
+void test_disabled_reports_nothing() {
+  startDriver(Mode::SINGLE_SHOT, false);
+  sampleEvery(100000, 3);
+  EnergyStats e = device.energyStats();
+  TEST_ASSERT_TRUE(e.elapsedUs == 0);
+  TEST_ASSERT_EQUAL_UINT32(0, e.conversions);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, e.energyUj);
+}
+
+void test_single_shot_counts_conversion_time_only() {
+  startDriver(Mode::SINGLE_SHOT);
+  sampleEvery(100000, 10);  // 128 SPS at 10 Hz: ~8 % duty cycle
+
+  EnergyStats e = device.energyStats();
+  TEST_ASSERT_EQUAL_UINT32(10, e.conversions);
+  TEST_ASSERT_TRUE(e.convertingUs == 10ull * conversionTimeUs(DataRate::SPS_128));
+  TEST_ASSERT_TRUE(e.elapsedUs >= 1000000 && e.elapsedUs < 1001000);
+  TEST_ASSERT_TRUE(e.powerDownUs == e.elapsedUs - e.convertingUs);
+}
+
+void test_continuous_counts_all_elapsed_time() {
+  startDriver(Mode::CONTINUOUS);
+  sampleEvery(100000, 10);
+
+  EnergyStats e = device.energyStats();
+  TEST_ASSERT_EQUAL_UINT32(0, e.conversions);  // Only single-shot starts are counted
+  TEST_ASSERT_TRUE(e.convertingUs == e.elapsedUs);
+  TEST_ASSERT_TRUE(e.powerDownUs == 0);
+}
+
+void test_single_shot_low_duty_uses_less_energy() {
+  startDriver(Mode::SINGLE_SHOT);
+  sampleEvery(100000, 10);
+  EnergyStats single = device.energyStats();
+
+  stub::nowUs = 0;
+  startDriver(Mode::CONTINUOUS);
+  sampleEvery(100000, 10);
+  EnergyStats continuous = device.energyStats();
+
+  // Same window, same rate: about 8 % of the converting charge plus power-down
+  TEST_ASSERT_TRUE(single.energyUj < continuous.energyUj * 0.15f);
+  TEST_ASSERT_TRUE(single.averageCurrentUa < continuous.averageCurrentUa);
+  TEST_ASSERT_FLOAT_WITHIN(5.0f, 150.0f, continuous.averageCurrentUa);
+}
+
+void test_i2c_bits_follow_transaction_shape() {
+  startDriver(Mode::SINGLE_SHOT);
+  uint16_t reg = 0;
+  TEST_ASSERT_TRUE(device.readConfig(reg).ok());
+  // START + addr/W + pointer + Sr + addr/R + 2 data + STOP = 48 bits at 400 kHz
+  TEST_ASSERT_TRUE(device.energyStats().i2cUs == 120);
+
+  TEST_ASSERT_TRUE(device.writeConfig(reg).ok());
+  // + START + addr/W + pointer + 2 data + STOP = 38 bits
+  TEST_ASSERT_TRUE(device.energyStats().i2cUs == (48 + 38) * 1000000ull / 400000);
+}
+
+void test_reset_clears_counters() {
+  startDriver(Mode::SINGLE_SHOT);
+  sampleEvery(50000, 4);
+  TEST_ASSERT_TRUE(device.energyStats().conversions == 4);
+
+  device.resetEnergyStats();
+  EnergyStats e = device.energyStats();
+  TEST_ASSERT_EQUAL_UINT32(0, e.conversions);
+  TEST_ASSERT_TRUE(e.convertingUs == 0);
+  TEST_ASSERT_TRUE(e.i2cUs == 0);
+  TEST_ASSERT_TRUE(e.elapsedUs < 100);
+}
+
+void test_backpressure_pause_is_not_converting() {
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  config.mode = Mode::CONTINUOUS;
+  config.power.enabled = true;
+  config.sampleBackpressure = fakeSink;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  device.resetEnergyStats();
+
+  int16_t raw = 0;
+  stub::nowUs += 100000;
+  TEST_ASSERT_TRUE(device.readRaw(raw).ok());
+  sinkFull = true;
+  TEST_ASSERT_EQUAL(Err::BUSY, device.readRaw(raw).code);
+  stub::nowUs += 400000;
+  device.tick(millis());
+  sinkFull = false;
+  (void)device.readRaw(raw);  // Restarts; first result is one period away
+
+  EnergyStats e = device.energyStats();
+  TEST_ASSERT_TRUE(e.elapsedUs >= 500000);
+  TEST_ASSERT_TRUE(e.convertingUs >= 100000 && e.convertingUs < 101000);
+  TEST_ASSERT_TRUE(e.powerDownUs >= 400000);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_disabled_reports_nothing);
+  RUN_TEST(test_single_shot_counts_conversion_time_only);
+  RUN_TEST(test_continuous_counts_all_elapsed_time);
+  RUN_TEST(test_single_shot_low_duty_uses_less_energy);
+  RUN_TEST(test_i2c_bits_follow_transaction_shape);
+  RUN_TEST(test_reset_clears_counters);
+  RUN_TEST(test_backpressure_pause_is_not_converting);
+  return UNITY_END();
+}
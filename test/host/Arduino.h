@@ -0,0 +1,163 @@
+/// @file Arduino.h
+/// @brief Arduino API on a Linux host for running examples against the simulator
+/// @note NOT part of the library. Put test/host first on the include path:
+///       real CLOCK_MONOTONIC timing, Serial on stdin/stdout, and a String
+///       with the subset of methods the examples use.
+#pragma once
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../../examples/common/linux/Arduino.h"
+
+using byte = uint8_t;
+
+// The simulator reads the device clock from here; the host Wire shim sets it
+// from host::monotonicUs() before every transaction.
+namespace stub {
+inline uint64_t nowUs = 0;
+inline uint32_t autoAdvanceUs = 0;
+} // namespace stub
+
+// ============================================================================
+// GPIO (no pins on the host)
+// ============================================================================
+
+static constexpr uint8_t INPUT = 0x01;
+static constexpr uint8_t OUTPUT = 0x03;
+static constexpr uint8_t INPUT_PULLUP = 0x05;
+static constexpr uint8_t LOW = 0;
+static constexpr uint8_t HIGH = 1;
+
+inline void pinMode(int pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+inline int digitalRead(int pin) {
+  (void)pin;
+  return HIGH;
+}
+inline void digitalWrite(int pin, uint8_t level) {
+  (void)pin;
+  (void)level;
+}
+
+// ============================================================================
+// Serial on stdin / stdout
+// ============================================================================
+
+class SerialClass {
+public:
+  void begin(uint32_t baud) { (void)baud; }
+  void print(const char* s) { fputs(s, stdout); }
+  void println(const char* s = "") {
+    fputs(s, stdout);
+    fputc('\n', stdout);
+  }
+  void printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stdout, fmt, args);
+    va_end(args);
+  }
+
+  /// Bytes buffered from stdin; never blocks
+  int available() {
+    if (_head == _tail && !_eof) {
+      _fill(0);
+    }
+    return static_cast<int>(_tail - _head);
+  }
+
+  int read() {
+    if (available() == 0) {
+      return -1;
+    }
+    return static_cast<unsigned char>(_buf[_head++]);
+  }
+
+  /// Flush stdout and wait up to @p timeoutMs for input
+  void waitInput(int timeoutMs) {
+    fflush(stdout);
+    if (_head == _tail && !_eof) {
+      _fill(timeoutMs);
+    }
+  }
+
+  /// stdin closed and everything read
+  bool finished() const { return _eof && _head == _tail; }
+
+  operator bool() { return true; }
+
+private:
+  void _fill(int timeoutMs) {
+    pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    if (::poll(&pfd, 1, timeoutMs) <= 0) {
+      return;
+    }
+    ssize_t n = ::read(STDIN_FILENO, _buf, sizeof(_buf));
+    if (n <= 0) {
+      _eof = true;
+      return;
+    }
+    _head = 0;
+    _tail = static_cast<size_t>(n);
+  }
+
+  char _buf[256];
+  size_t _head = 0;
+  size_t _tail = 0;
+  bool _eof = false;
+};
+
+extern SerialClass Serial;
+
+// ============================================================================
+// String
+// ============================================================================
+
+class String {
+public:
+  String() = default;
+  String(const char* s) : _data(s ? s : "") {}
+
+  const char* c_str() const { return _data.c_str(); }
+  size_t length() const { return _data.length(); }
+
+  void trim() {
+    size_t start = _data.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+      _data.clear();
+      return;
+    }
+    size_t end = _data.find_last_not_of(" \t\r\n");
+    _data = _data.substr(start, end - start + 1);
+  }
+
+  bool startsWith(const char* prefix) const { return _data.rfind(prefix, 0) == 0; }
+
+  String substring(size_t start) const {
+    return String(start < _data.size() ? _data.c_str() + start : "");
+  }
+
+  /// Leading integer, 0 when there is none (like Arduino)
+  long toInt() const { return std::strtol(_data.c_str(), nullptr, 10); }
+
+  String& operator+=(char c) {
+    _data += c;
+    return *this;
+  }
+  bool operator==(const char* s) const { return _data == s; }
+  bool operator!=(const char* s) const { return _data != s; }
+
+private:
+  std::string _data;
+};
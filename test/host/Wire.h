@@ -0,0 +1,121 @@
+/// @file Wire.h
+/// @brief Wire API on a Linux host, routed into a simulated I2C bus
+/// @note NOT part of the library. Transactions reach a sim::Bus at the real
+///       (monotonic) time, so conversions complete in wall-clock time.
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sim/Ads1115Sim.h"
+
+class TwoWire {
+public:
+  /// Route transactions to @p bus; the bus must not advance the clock itself
+  void attach(sim::Bus* bus) {
+    _bus = bus;
+    sim::WireTiming timing = bus->timing();
+    timing.advanceClock = false;
+    bus->setTiming(timing);
+  }
+
+  void begin(int sda = -1, int scl = -1) {
+    (void)sda;
+    (void)scl;
+  }
+
+  void setClock(uint32_t freq) {
+    if (_bus != nullptr) {
+      sim::WireTiming timing = _bus->timing();
+      timing.sclHz = freq;
+      _bus->setTiming(timing);
+    }
+  }
+
+  void setTimeOut(uint32_t timeoutMs) { (void)timeoutMs; }
+
+  void beginTransmission(uint8_t addr) {
+    _addr = addr;
+    _txLen = 0;
+    _pending = false;
+  }
+
+  size_t write(uint8_t data) {
+    if (_txLen >= sizeof(_txBuf)) {
+      return 0;
+    }
+    _txBuf[_txLen++] = data;
+    return 1;
+  }
+
+  size_t write(const uint8_t* data, size_t len) {
+    size_t n = 0;
+    while (n < len && write(data[n]) == 1) {
+      ++n;
+    }
+    return n;
+  }
+
+  /// 0 = ok, 2 = address NACK, 3 = data NACK, 4 = no bus attached
+  /// @note With @p stop false the write is held and sent together with the
+  ///       next requestFrom() as one write-then-read transaction.
+  uint8_t endTransmission(bool stop = true) {
+    if (_bus == nullptr) {
+      return 4;
+    }
+    if (!stop) {
+      _pending = true;
+      return 0;
+    }
+    stub::nowUs = host::monotonicUs();
+    return _result(_bus->write(_addr, _txBuf, _txLen));
+  }
+
+  size_t requestFrom(uint8_t addr, size_t len) {
+    _rxLen = 0;
+    _rxIdx = 0;
+    if (_bus == nullptr || len > sizeof(_rxBuf)) {
+      return 0;
+    }
+    stub::nowUs = host::monotonicUs();
+    ADS1115::Status st = _pending && addr == _addr
+                           ? _bus->writeRead(addr, _txBuf, _txLen, _rxBuf, len)
+                           : _bus->read(addr, _rxBuf, len);
+    _pending = false;
+    if (!st.ok()) {
+      return 0;
+    }
+    _rxLen = len;
+    return len;
+  }
+
+  int available() { return static_cast<int>(_rxLen - _rxIdx); }
+
+  int read() {
+    if (_rxIdx < _rxLen) {
+      return _rxBuf[_rxIdx++];
+    }
+    return -1;
+  }
+
+private:
+  static uint8_t _result(const ADS1115::Status& st) {
+    if (st.ok()) {
+      return 0;
+    }
+    return st.detail == 3 ? 3 : 2;
+  }
+
+  sim::Bus* _bus = nullptr;
+  uint8_t _addr = 0;
+  uint8_t _txBuf[32] = {};
+  size_t _txLen = 0;
+  uint8_t _rxBuf[32] = {};
+  size_t _rxLen = 0;
+  size_t _rxIdx = 0;
+  bool _pending = false;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,79 @@
+/// @file host_main.cpp
+/// @brief Runs an Arduino-style example on a Linux host against the simulator
+/// @note Provides main(), the Serial and Wire objects and one simulated
+///       ADS1115. Commands come from stdin, so sessions can be scripted:
+///
+///   printf 'read 100\nstress 500\n' | .pio/build/ex_bringup_native/program
+///   perf record -g .pio/build/ex_bringup_native/program < commands.txt
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "sim/Ads1115Sim.h"
+
+SerialClass Serial;
+TwoWire Wire;
+
+void setup();
+void loop();
+
+namespace {
+
+static constexpr int IDLE_WAIT_MS = 1;
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+
+bool parseArgs(int argc, char** argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const char* arg = argv[i];
+    const char* value = argv[++i];
+    if (std::strncmp(arg, "--ain", 5) == 0 && arg[5] >= '0' && arg[5] <= '3' && arg[6] == '\0') {
+      simDevice.setInput(static_cast<uint8_t>(arg[5] - '0'), std::strtof(value, nullptr));
+    } else if (std::strcmp(arg, "--scl-hz") == 0) {
+      sim::WireTiming timing = simBus.timing();
+      timing.sclHz = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+      simBus.setTiming(timing);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  simDevice.setInput(0, 1.0f);
+  simDevice.setInput(1, 0.5f);
+  simDevice.setInput(2, 0.25f);
+  simDevice.setInput(3, 0.125f);
+  if (!parseArgs(argc, argv)) {
+    fprintf(stderr, "usage: %s [--ain0..3 volts] [--scl-hz hz] < commands\n", argv[0]);
+    return 2;
+  }
+  simBus.attach(&simDevice);
+  Wire.attach(&simBus);
+
+  setup();
+  while (!Serial.finished()) {
+    loop();
+    if (Serial.available() == 0) {
+      Serial.waitInput(IDLE_WAIT_MS);
+    }
+  }
+  fflush(stdout);
+
+  const sim::BusCounters& c = simBus.counters();
+  fprintf(stderr, "\nsim bus: %lu transactions (%lu nack), %.1f us wire time\n",
+          static_cast<unsigned long>(c.transactions()), static_cast<unsigned long>(c.nacks),
+          static_cast<double>(c.busyNs) / 1000.0);
+  return 0;
+}
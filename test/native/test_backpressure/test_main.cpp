@@ -0,0 +1,421 @@
+/// @file test_main.cpp
+/// @brief Overflow policies, PAUSE hysteresis and driver backpressure
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "ADS1115/Pipeline.h"
+#include "ADS1115/Scheduler.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+
+bool sinkFull = false;
+
+bool fakeSink(void* user) {
+  (void)user;
+  return sinkFull;
+}
+
+Sample makeSample(uint32_t seq) {
+  Sample s;
+  s.seq = seq;
+  s.timestampUs = seq * 1000;
+  s.raw = static_cast<int16_t>(seq);
+  return s;
+}
+
+struct Collector {
+  uint32_t seqs[64] = {};
+  uint8_t flags[64] = {};
+  size_t count = 0;
+};
+
+size_t collect(Sample* samples, size_t count, void* ctx) {
+  Collector* c = static_cast<Collector*>(ctx);
+  for (size_t i = 0; i < count && c->count < 64; ++i) {
+    c->seqs[c->count] = samples[i].seq;
+    c->flags[c->count] = samples[i].flags;
+    c->count++;
+  }
+  return count;
+}
+
+void startDriver(Mode mode) {
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  config.mode = mode;
+  config.sampleBackpressure = fakeSink;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  simBus.resetCounters();
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 50;
+  simDevice.reset();
+  simDevice.setInput(0, 0.5f);
+  sinkFull = false;
+}
+
+void tearDown() {}
+
+// ============================================================================
+// SampleRing
+// ============================================================================
+
+void test_ring_keeps_every_field() {
+  SampleRing<4> ring;
+  Sample in = makeSample(7);
+  in.raw = -12345;
+  in.mux = Mux::AIN2_AIN3;
+  in.gain = Gain::FSR_0_256V;
+  in.flags = SampleFlag::HEARTBEAT;
+  TEST_ASSERT_TRUE(ring.push(in));
+  Sample out;
+  TEST_ASSERT_EQUAL(1, ring.pop(&out, 1));
+  TEST_ASSERT_EQUAL_UINT32(7000, out.timestampUs);
+  TEST_ASSERT_EQUAL_UINT32(7, out.seq);
+  TEST_ASSERT_EQUAL_INT16(-12345, out.raw);
+  TEST_ASSERT_EQUAL(Mux::AIN2_AIN3, out.mux);
+  TEST_ASSERT_EQUAL(Gain::FSR_0_256V, out.gain);
+  TEST_ASSERT_EQUAL_UINT8(SampleFlag::HEARTBEAT, out.flags);
+}
+
+void test_ring_overwrite_reports_lost() {
+  SampleRing<4> ring;
+  uint32_t discarded = 0;
+  for (uint32_t i = 0; i < 6; ++i) {
+    discarded += ring.pushOverwrite(makeSample(i)) ? 1 : 0;
+  }
+  TEST_ASSERT_EQUAL_UINT32(2, discarded);
+
+  Sample out[4];
+  uint32_t lost = 0;
+  TEST_ASSERT_EQUAL(4, ring.pop(out, 4, &lost));
+  TEST_ASSERT_EQUAL_UINT32(2, lost);
+  TEST_ASSERT_EQUAL_UINT32(2, out[0].seq);
+  TEST_ASSERT_TRUE(out[0].flags & SampleFlag::GAP);
+  TEST_ASSERT_FALSE(out[1].flags & SampleFlag::GAP);
+
+  ring.pushOverwrite(makeSample(6));
+  TEST_ASSERT_EQUAL(1, ring.pop(out, 4, &lost));
+  TEST_ASSERT_EQUAL_UINT32(0, lost);
+  TEST_ASSERT_FALSE(out[0].flags & SampleFlag::GAP);
+}
+
+// ============================================================================
+// Overflow policies
+// ============================================================================
+
+void test_drop_newest_counts_and_marks_gap() {
+  Pipeline<8, 2, 8> pipeline;
+  Collector c;
+  pipeline.addStage("collect", collect, &c);
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    TEST_ASSERT_EQUAL(i < 8, pipeline.push(makeSample(i)));
+  }
+  TEST_ASSERT_EQUAL_UINT32(2, pipeline.dropped());
+  TEST_ASSERT_EQUAL(8, pipeline.process());
+  TEST_ASSERT_TRUE(pipeline.push(makeSample(10)));
+  TEST_ASSERT_EQUAL(1, pipeline.process());
+
+  TEST_ASSERT_EQUAL(9, c.count);
+  TEST_ASSERT_EQUAL_UINT32(7, c.seqs[7]);
+  TEST_ASSERT_FALSE(c.flags[7] & SampleFlag::GAP);
+  TEST_ASSERT_EQUAL_UINT32(10, c.seqs[8]);
+  TEST_ASSERT_TRUE(c.flags[8] & SampleFlag::GAP);
+  TEST_ASSERT_EQUAL_UINT32(1, pipeline.gaps());
+}
+
+void test_drop_oldest_counts_and_marks_gap() {
+  Pipeline<8, 2, 8> pipeline;
+  pipeline.setOverflowPolicy(OverflowPolicy::DROP_OLDEST);
+  Collector c;
+  pipeline.addStage("collect", collect, &c);
+
+  for (uint32_t i = 0; i < 11; ++i) {
+    TEST_ASSERT_TRUE(pipeline.push(makeSample(i)));
+  }
+  TEST_ASSERT_EQUAL_UINT32(3, pipeline.dropped());
+  TEST_ASSERT_EQUAL(8, pipeline.process());
+  TEST_ASSERT_EQUAL_UINT32(3, c.seqs[0]);
+  TEST_ASSERT_TRUE(c.flags[0] & SampleFlag::GAP);
+  TEST_ASSERT_EQUAL_UINT32(10, c.seqs[7]);
+  TEST_ASSERT_EQUAL_UINT32(1, pipeline.gaps());
+}
+
+void test_pause_refuses_full_ring_like_drop_newest() {
+  Pipeline<8, 2, 8> pipeline;
+  pipeline.setOverflowPolicy(OverflowPolicy::PAUSE);
+  Collector c;
+  pipeline.addStage("collect", collect, &c);
+
+  for (uint32_t i = 0; i < 9; ++i) {
+    pipeline.push(makeSample(i));
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, pipeline.dropped());
+  pipeline.process();
+  pipeline.push(makeSample(9));
+  pipeline.process();
+  TEST_ASSERT_TRUE(c.flags[8] & SampleFlag::GAP);
+  TEST_ASSERT_EQUAL_UINT32(1, pipeline.gaps());
+}
+
+void test_pause_hysteresis_seven_eighths_to_half() {
+  using Pipe = Pipeline<16, 1, 1>;  // process() pops one sample at a time
+  Pipe pipeline;
+  pipeline.setOverflowPolicy(OverflowPolicy::PAUSE);
+
+  for (uint32_t i = 0; i < 13; ++i) {
+    pipeline.push(makeSample(i));
+  }
+  TEST_ASSERT_FALSE(Pipe::backpressure(&pipeline));
+  pipeline.push(makeSample(13));  // 14 = 7/8 of 16
+  TEST_ASSERT_TRUE(Pipe::backpressure(&pipeline));
+  TEST_ASSERT_EQUAL_UINT32(1, pipeline.pauses());
+
+  while (pipeline.backlog() > 9) {
+    pipeline.process();
+  }
+  TEST_ASSERT_TRUE(Pipe::backpressure(&pipeline));
+  pipeline.process();  // 8 = half
+  TEST_ASSERT_FALSE(Pipe::backpressure(&pipeline));
+
+  // Refilling to 7/8 starts a second pause
+  for (uint32_t i = 0; i < 6; ++i) {
+    pipeline.push(makeSample(20 + i));
+  }
+  TEST_ASSERT_TRUE(Pipe::backpressure(&pipeline));
+  TEST_ASSERT_EQUAL_UINT32(2, pipeline.pauses());
+}
+
+void test_backpressure_only_under_pause_policy() {
+  using Pipe = Pipeline<8, 1, 8>;
+  Pipe pipeline;
+  for (uint32_t i = 0; i < 8; ++i) {
+    pipeline.push(makeSample(i));
+  }
+  TEST_ASSERT_FALSE(Pipe::backpressure(&pipeline));
+  pipeline.setOverflowPolicy(OverflowPolicy::DROP_OLDEST);
+  TEST_ASSERT_FALSE(Pipe::backpressure(&pipeline));
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+void test_single_shot_pause_and_resume() {
+  startDriver(Mode::SINGLE_SHOT);
+
+  sinkFull = true;
+  TEST_ASSERT_EQUAL(Err::BUSY, device.startConversion().code);
+  TEST_ASSERT_TRUE(device.acquisitionPaused());
+  TEST_ASSERT_EQUAL_UINT32(1, device.backpressurePauses());
+  int16_t raw = 0;
+  TEST_ASSERT_EQUAL(Err::BUSY, device.readRaw(raw).code);
+  TEST_ASSERT_EQUAL(Err::BUSY, device.readBlocking(raw).code);
+  TEST_ASSERT_EQUAL_UINT32(0, simBus.counters().transactions());
+  TEST_ASSERT_EQUAL_UINT32(1, device.backpressurePauses());  // Still the same pause
+
+  sinkFull = false;
+  TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+  TEST_ASSERT_FALSE(device.acquisitionPaused());
+  TEST_ASSERT_TRUE(device.lastSample().flags & SampleFlag::GAP);
+  TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+  TEST_ASSERT_FALSE(device.lastSample().flags & SampleFlag::GAP);
+}
+
+void test_continuous_pause_powers_down_and_resumes() {
+  startDriver(Mode::CONTINUOUS);
+
+  int16_t raw = 0;
+  TEST_ASSERT_TRUE(device.readRaw(raw).ok());
+  TEST_ASSERT_EQUAL_UINT16(0, simDevice.reg(0x01) & cmd::MASK_MODE);
+
+  sinkFull = true;
+  TEST_ASSERT_EQUAL(Err::BUSY, device.readRaw(raw).code);
+  TEST_ASSERT_EQUAL_UINT16(cmd::MODE_SINGLE_SHOT, simDevice.reg(0x01) & cmd::MASK_MODE);
+  uint32_t transactions = simBus.counters().transactions();
+  TEST_ASSERT_EQUAL(Err::BUSY, device.readRaw(raw).code);
+  device.tick(millis());
+  TEST_ASSERT_EQUAL_UINT32(transactions, simBus.counters().transactions());
+
+  sinkFull = false;
+  TEST_ASSERT_EQUAL(Err::CONVERSION_NOT_READY, device.readRaw(raw).code);
+  TEST_ASSERT_EQUAL_UINT16(0, simDevice.reg(0x01) & cmd::MASK_MODE);
+  TEST_ASSERT_FALSE(device.acquisitionPaused());
+  TEST_ASSERT_EQUAL_UINT32(1, device.backpressurePauses());
+}
+
+void test_continuous_read_blocking_after_resume() {
+  startDriver(Mode::CONTINUOUS);
+
+  int16_t raw = 0;
+  sinkFull = true;
+  TEST_ASSERT_EQUAL(Err::BUSY, device.readBlocking(raw).code);
+  sinkFull = false;
+
+  const uint32_t seq = device.lastSample().seq;
+  const uint64_t resumedUs = stub::nowUs;
+  TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+  // Waited for the first result after the restart (millis() resolution)
+  TEST_ASSERT_TRUE(stub::nowUs - resumedUs >= 1000u * (device.getConversionTimeMs() - 1));
+  TEST_ASSERT_EQUAL_UINT32(seq + 1, device.lastSample().seq);
+  TEST_ASSERT_TRUE(device.lastSample().flags & SampleFlag::GAP);
+  TEST_ASSERT_TRUE(raw > 7990 && raw < 8010);  // 0.5 V on the 2.048 V range
+}
+
+void test_preempt_while_sink_full_keeps_conversion() {
+  startDriver(Mode::SINGLE_SHOT);
+  config.allowGeneralCallReset = true;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+
+  TEST_ASSERT_EQUAL(Err::IN_PROGRESS, device.startConversion().code);
+  simBus.resetCounters();
+
+  sinkFull = true;
+  ChannelConfig urgent;
+  urgent.mux = Mux::AIN1_GND;
+  TEST_ASSERT_EQUAL(Err::BUSY, device.preemptConversion(urgent).code);
+  TEST_ASSERT_EQUAL_UINT32(0, simBus.counters().transactions());  // No general call
+
+  // The original conversion still completes and can be read
+  sinkFull = false;
+  int16_t raw = 0;
+  TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+  TEST_ASSERT_EQUAL(Mux::AIN0_GND, device.lastSample().mux);
+}
+
+void test_scheduler_waits_while_sink_full() {
+  startDriver(Mode::SINGLE_SHOT);
+  EdfScheduler<2> sched;
+  ChannelConfig ain0;
+  ain0.mux = Mux::AIN0_GND;
+  ain0.dataRate = DataRate::SPS_860;
+  ChannelConfig ain1 = ain0;
+  ain1.mux = Mux::AIN1_GND;
+  sched.addChannel(ain0, 20000);
+  sched.addChannel(ain1, 20000);
+
+  sinkFull = true;
+  sched.start(micros());
+  while (stub::nowUs < 50000) {
+    TEST_ASSERT_TRUE(sched.poll(device, micros()).ok());
+    stub::nowUs += 100;
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, simBus.counters().transactions());  // Nothing started
+  TEST_ASSERT_EQUAL_UINT32(0, sched.stats(micros()).errors);
+  TEST_ASSERT_EQUAL_UINT32(2, sched.channelStats(0).paused);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(0).overruns);
+
+  // The waiting jobs run once the sink drains
+  sinkFull = false;
+  while (stub::nowUs < 60000) {
+    TEST_ASSERT_TRUE(sched.poll(device, micros()).ok());
+    stub::nowUs += 100;
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(0).completed);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(1).completed);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.stats(micros()).errors);
+}
+
+void test_scheduler_preempt_while_sink_full_is_not_an_error() {
+  startDriver(Mode::SINGLE_SHOT);
+  config.allowGeneralCallReset = true;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  EdfScheduler<2> sched;
+  sched.setPreemption(true);
+  ChannelConfig slow;
+  slow.mux = Mux::AIN0_GND;
+  slow.dataRate = DataRate::SPS_8;
+  ChannelConfig urgent;
+  urgent.mux = Mux::AIN1_GND;
+  urgent.dataRate = DataRate::SPS_860;
+  sched.addChannel(slow, 1000000);
+  sched.addChannel(urgent, 20000, 5000, true);
+
+  // The urgent job runs first, then the slow one is in flight at the next release
+  sched.start(micros());
+  while (stub::nowUs < 10000) {
+    TEST_ASSERT_TRUE(sched.poll(device, micros()).ok());
+    stub::nowUs += 100;
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(1).completed);
+
+  sinkFull = true;
+  simBus.resetCounters();
+  while (stub::nowUs < 30000) {
+    TEST_ASSERT_TRUE(sched.poll(device, micros()).ok());
+    stub::nowUs += 100;
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, simBus.counters().writes);  // No general call, no start
+  TEST_ASSERT_EQUAL_UINT32(0, sched.stats(micros()).preemptions);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.stats(micros()).errors);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(0).preempted);
+}
+
+void test_pipeline_pause_drives_driver() {
+  using Pipe = Pipeline<16, 1, 4>;
+  Pipe pipeline;
+  pipeline.setOverflowPolicy(OverflowPolicy::PAUSE);
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  config.onSample = Pipe::onSample;
+  config.sampleBackpressure = Pipe::backpressure;
+  config.sampleUser = &pipeline;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+
+  int16_t raw = 0;
+  uint32_t read = 0;
+  while (device.readBlocking(raw).ok()) {
+    read++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(14, read);  // Paused at 7/8, nothing dropped
+  TEST_ASSERT_EQUAL_UINT32(0, pipeline.dropped());
+  TEST_ASSERT_EQUAL_UINT32(1, device.backpressurePauses());
+
+  while (pipeline.backlog() > 8) {
+    pipeline.process();
+  }
+  TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+  TEST_ASSERT_FALSE(device.acquisitionPaused());
+  TEST_ASSERT_TRUE(device.lastSample().flags & SampleFlag::GAP);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_ring_keeps_every_field);
+  RUN_TEST(test_ring_overwrite_reports_lost);
+  RUN_TEST(test_drop_newest_counts_and_marks_gap);
+  RUN_TEST(test_drop_oldest_counts_and_marks_gap);
+  RUN_TEST(test_pause_refuses_full_ring_like_drop_newest);
+  RUN_TEST(test_pause_hysteresis_seven_eighths_to_half);
+  RUN_TEST(test_backpressure_only_under_pause_policy);
+  RUN_TEST(test_single_shot_pause_and_resume);
+  RUN_TEST(test_continuous_pause_powers_down_and_resumes);
+  RUN_TEST(test_continuous_read_blocking_after_resume);
+  RUN_TEST(test_preempt_while_sink_full_keeps_conversion);
+  RUN_TEST(test_scheduler_waits_while_sink_full);
+  RUN_TEST(test_scheduler_preempt_while_sink_full_is_not_an_error);
+  RUN_TEST(test_pipeline_pause_drives_driver);
+  return UNITY_END();
+}
@@ -0,0 +1,184 @@
+/// @file test_main.cpp
+/// @brief executeI2cBatch() dispatch and per-operation fallback
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+/// Records per-operation callbacks; call number @p failAt (1-based) fails
+struct Recorder {
+  char calls[8] = {};
+  size_t count = 0;
+  size_t failAt = 0;
+  uint32_t batches = 0;
+
+  Status record(char kind) {
+    if (count < sizeof(calls)) {
+      calls[count] = kind;
+    }
+    count++;
+    if (count == failAt) {
+      return Status::Error(Err::I2C_ERROR, "NACK", static_cast<int32_t>(count));
+    }
+    return Status::Ok();
+  }
+};
+
+Recorder rec;
+
+Status recWrite(uint8_t, const uint8_t*, size_t, uint32_t, void* user) {
+  return static_cast<Recorder*>(user)->record('W');
+}
+
+Status recWriteRead(uint8_t, const uint8_t*, size_t, uint8_t*, size_t, uint32_t, void* user) {
+  return static_cast<Recorder*>(user)->record('X');
+}
+
+Status recRead(uint8_t, uint8_t*, size_t, uint32_t, void* user) {
+  return static_cast<Recorder*>(user)->record('R');
+}
+
+Status recBatch(const I2cOp*, size_t, uint32_t, void* user) {
+  static_cast<Recorder*>(user)->batches++;
+  return Status::Ok();
+}
+
+uint8_t tx[3] = {0x01, 0x85, 0x83};
+uint8_t rx[2] = {};
+
+/// WRITE, WRITE_READ, READ, WRITE
+void makeOps(I2cOp* ops) {
+  const I2cOpType types[4] = {I2cOpType::WRITE, I2cOpType::WRITE_READ, I2cOpType::READ,
+                              I2cOpType::WRITE};
+  for (size_t i = 0; i < 4; ++i) {
+    ops[i] = I2cOp{};
+    ops[i].type = types[i];
+    ops[i].addr = 0x48;
+    if (types[i] != I2cOpType::READ) {
+      ops[i].tx = tx;
+      ops[i].txLen = types[i] == I2cOpType::WRITE ? 3 : 1;
+    }
+    if (types[i] != I2cOpType::WRITE) {
+      ops[i].rx = rx;
+      ops[i].rxLen = 2;
+    }
+  }
+}
+
+BusConfig fallbackBus() {
+  BusConfig bus;
+  bus.i2cWrite = recWrite;
+  bus.i2cWriteRead = recWriteRead;
+  bus.i2cRead = recRead;
+  bus.i2cUser = &rec;
+  return bus;
+}
+
+} // namespace
+
+void setUp() { rec = Recorder{}; }
+
+void tearDown() {}
+
+void test_fallback_runs_ops_in_order() {
+  I2cOp ops[4];
+  makeOps(ops);
+  TEST_ASSERT_TRUE(executeI2cBatch(fallbackBus(), ops, 4).ok());
+  TEST_ASSERT_EQUAL(4, rec.count);
+  TEST_ASSERT_EQUAL_STRING("WXRW", rec.calls);
+}
+
+void test_fallback_stops_at_first_failure() {
+  I2cOp ops[4];
+  makeOps(ops);
+  rec.failAt = 2;
+  Status st = executeI2cBatch(fallbackBus(), ops, 4);
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, st.code);
+  TEST_ASSERT_EQUAL_INT32(2, st.detail);  // The failing operation's own status
+  TEST_ASSERT_EQUAL(2, rec.count);        // READ and the last WRITE never issued
+}
+
+void test_fallback_missing_callback_is_invalid_config() {
+  I2cOp ops[4];
+  makeOps(ops);
+  BusConfig bus = fallbackBus();
+  bus.i2cRead = nullptr;
+  Status st = executeI2cBatch(bus, ops, 4);
+  TEST_ASSERT_EQUAL(Err::INVALID_CONFIG, st.code);
+  TEST_ASSERT_EQUAL(2, rec.count);  // Operations before the READ already ran
+}
+
+void test_batch_callback_takes_precedence() {
+  I2cOp ops[4];
+  makeOps(ops);
+  BusConfig bus = fallbackBus();
+  bus.i2cBatch = recBatch;
+  TEST_ASSERT_TRUE(executeI2cBatch(bus, ops, 4).ok());
+  TEST_ASSERT_EQUAL_UINT32(1, rec.batches);
+  TEST_ASSERT_EQUAL(0, rec.count);
+}
+
+void test_empty_batch_is_noop() {
+  BusConfig bus = fallbackBus();
+  bus.i2cBatch = recBatch;
+  TEST_ASSERT_TRUE(executeI2cBatch(bus, nullptr, 0).ok());
+  TEST_ASSERT_EQUAL_UINT32(0, rec.batches);
+  TEST_ASSERT_EQUAL(0, rec.count);
+}
+
+void test_driver_health_counts_each_operation() {
+  // A configuration change is three register writes with or without i2cBatch
+  sim::Device dev(0x48);
+  sim::Bus simBus;
+  simBus.attach(&dev);
+  for (int batched = 0; batched < 2; ++batched) {
+    Config config;
+    sim::attachTransport(config, simBus);
+    config.i2cBatch = batched ? sim::i2cBatch : nullptr;
+    ADS1115::ADS1115 device;
+    TEST_ASSERT_TRUE(device.begin(config).ok());
+    const uint32_t before = device.totalSuccess();
+    simBus.resetCounters();
+    TEST_ASSERT_TRUE(device.setGain(Gain::FSR_4_096V).ok());
+    TEST_ASSERT_EQUAL_UINT32(before + 3, device.totalSuccess());
+    TEST_ASSERT_EQUAL_UINT32(batched ? 1 : 0, simBus.counters().batches);
+  }
+}
+
+void test_sim_batch_stops_at_first_failure() {
+  // Device 0x49 is not attached, so the second operation NACKs
+  sim::Device dev(0x48);
+  sim::Bus simBus;
+  simBus.attach(&dev);
+  I2cOp ops[4];
+  makeOps(ops);
+  ops[1].addr = 0x49;
+  Status st = simBus.batch(ops, 4);
+  TEST_ASSERT_FALSE(st.ok());
+  TEST_ASSERT_EQUAL_UINT32(1, simBus.counters().writes);
+  TEST_ASSERT_EQUAL_UINT32(1, simBus.counters().writeReads);
+  TEST_ASSERT_EQUAL_UINT32(0, simBus.counters().reads);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_fallback_runs_ops_in_order);
+  RUN_TEST(test_fallback_stops_at_first_failure);
+  RUN_TEST(test_fallback_missing_callback_is_invalid_config);
+  RUN_TEST(test_batch_callback_takes_precedence);
+  RUN_TEST(test_empty_batch_is_noop);
+  RUN_TEST(test_driver_health_counts_each_operation);
+  RUN_TEST(test_sim_batch_stops_at_first_failure);
+  return UNITY_END();
+}
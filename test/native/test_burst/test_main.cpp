@@ -0,0 +1,207 @@
+/// @file test_main.cpp
+/// @brief readBurst() pacing, missed and duplicate accounting against the simulator
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+
+constexpr size_t kCount = 64;
+int16_t codes[kCount];
+
+/// Every finished conversion raises AIN0 by one LSB (2.048 V range), so each
+/// new conversion has a distinct code and a re-read shows up as a repeat
+uint32_t windows = 0;
+void stepInput(const sim::ConversionInfo& info, void* user) {
+  (void)info;
+  (void)user;
+  windows++;
+  simDevice.setInput(0, static_cast<float>(windows) * 62.5e-6f);
+}
+
+/// ALERT/RDY (active low): one low reading per finished conversion
+uint64_t seenResultUs = 0;
+bool alertPin(int pin, void* user) {
+  (void)pin;
+  (void)user;
+  simDevice.conversionDone(stub::nowUs);
+  if (simDevice.resultUs() != seenResultUs) {
+    seenResultUs = simDevice.resultUs();
+    return false;
+  }
+  return true;
+}
+
+/// ALERT/RDY held low for 400 us after each result, longer than one read
+bool alertSticky(int pin, void* user) {
+  (void)pin;
+  (void)user;
+  simDevice.conversionDone(stub::nowUs);
+  return !(simDevice.resultUs() != 0 && stub::nowUs - simDevice.resultUs() < 400);
+}
+
+bool alertNever(int pin, void* user) {
+  (void)pin;
+  (void)user;
+  return true;
+}
+
+uint32_t countRepeats(size_t n) {
+  uint32_t repeats = 0;
+  for (size_t i = 1; i < n; ++i) {
+    if (codes[i] == codes[i - 1]) {
+      repeats++;
+    }
+  }
+  return repeats;
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 5;
+  simDevice.reset();
+  simDevice.setClockErrorPpm(0);
+  simDevice.setInput(0, 0.0f);
+  simDevice.setObserver(stepInput, nullptr);
+  windows = 0;
+  seenResultUs = 0;
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  device.begin(config);
+}
+
+void tearDown() { simDevice.setObserver(nullptr, nullptr); }
+
+void test_nominal_clock_reads_each_conversion_once() {
+  BurstStats stats;
+  TEST_ASSERT_TRUE(device.readBurst(codes, kCount, stats).ok());
+  TEST_ASSERT_EQUAL_UINT32(kCount, stats.samples);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+  TEST_ASSERT_FALSE(stats.synced);
+  TEST_ASSERT_EQUAL_UINT32(0, countRepeats(kCount));
+}
+
+void test_late_reads_count_missed() {
+  stub::autoAdvanceUs = 1500;  // > one 860 SPS period per micros() call
+  BurstStats stats;
+  TEST_ASSERT_TRUE(device.readBurst(codes, 8, stats).ok());
+  TEST_ASSERT_EQUAL_UINT32(8, stats.samples);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, stats.missed);
+}
+
+void test_slow_oscillator_rereads_are_not_guessed() {
+  // Unsynced reads cannot tell a re-read from a steady input, so nothing is
+  // counted even though the schedule does read some conversions twice
+  simDevice.setClockErrorPpm(100000);  // conversions take 10% longer
+  BurstStats stats;
+  TEST_ASSERT_TRUE(device.readBurst(codes, kCount, stats).ok());
+  TEST_ASSERT_FALSE(stats.synced);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, countRepeats(kCount));
+  TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+}
+
+void test_steady_input_is_not_a_duplicate() {
+  simDevice.setObserver(nullptr, nullptr);
+  simDevice.setInput(0, 0.5f);
+  BurstStats stats;
+  TEST_ASSERT_TRUE(device.readBurst(codes, 16, stats).ok());
+  TEST_ASSERT_EQUAL_UINT32(15, countRepeats(16));
+  TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+}
+
+void test_alert_rdy_sync_avoids_duplicates() {
+  simDevice.setClockErrorPpm(100000);
+  config.alertRdyPin = 4;
+  config.gpioRead = alertPin;
+  device.begin(config);
+  TEST_ASSERT_TRUE(device.enableConversionReadyPin().ok());
+
+  BurstStats stats;
+  TEST_ASSERT_TRUE(device.readBurst(codes, kCount, stats).ok());
+  TEST_ASSERT_TRUE(stats.synced);
+  TEST_ASSERT_EQUAL_UINT32(kCount, stats.samples);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.duplicates);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+  TEST_ASSERT_EQUAL_UINT32(0, countRepeats(kCount));
+  for (size_t i = 1; i < kCount; ++i) {
+    TEST_ASSERT_EQUAL_INT16(codes[i - 1] + 1, codes[i]);
+  }
+  // 860 SPS slowed by 10%
+  TEST_ASSERT_FLOAT_WITHIN(10.0f, 860.0f / 1.1f, stats.achievedSps);
+}
+
+void test_alert_rdy_stale_level_is_not_read_twice() {
+  config.alertRdyPin = 4;
+  config.gpioRead = alertSticky;
+  device.begin(config);
+  TEST_ASSERT_TRUE(device.enableConversionReadyPin().ok());
+
+  BurstStats stats;
+  TEST_ASSERT_TRUE(device.readBurst(codes, kCount, stats).ok());
+  TEST_ASSERT_TRUE(stats.synced);
+  TEST_ASSERT_EQUAL_UINT32(kCount, stats.samples);
+  TEST_ASSERT_EQUAL_UINT32(0, countRepeats(kCount));
+  TEST_ASSERT_GREATER_THAN_UINT32(0, stats.duplicates);  // Level seen again after each read
+  TEST_ASSERT_EQUAL_UINT32(0, stats.missed);
+}
+
+void test_alert_rdy_missing_pulse_times_out() {
+  config.alertRdyPin = 4;
+  config.gpioRead = alertNever;
+  device.begin(config);
+  TEST_ASSERT_TRUE(device.enableConversionReadyPin().ok());
+
+  BurstStats stats;
+  Status st = device.readBurst(codes, 4, stats);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::TIMEOUT), static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT32(0, stats.samples);
+}
+
+void test_burst_leaves_sample_sequence_alone() {
+  int16_t raw = 0;
+  device.startConversion();
+  stub::nowUs += 10000;
+  TEST_ASSERT_TRUE(device.readRaw(raw).ok());
+  const uint32_t seq = device.lastSample().seq;
+
+  BurstStats stats;
+  TEST_ASSERT_TRUE(device.readBurst(codes, 16, stats).ok());
+  TEST_ASSERT_EQUAL_UINT32(seq, device.lastSample().seq);
+
+  device.startConversion();
+  stub::nowUs += 10000;
+  TEST_ASSERT_TRUE(device.readRaw(raw).ok());
+  TEST_ASSERT_EQUAL_UINT32(seq + 1, device.lastSample().seq);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+  UNITY_BEGIN();
+  RUN_TEST(test_nominal_clock_reads_each_conversion_once);
+  RUN_TEST(test_late_reads_count_missed);
+  RUN_TEST(test_slow_oscillator_rereads_are_not_guessed);
+  RUN_TEST(test_steady_input_is_not_a_duplicate);
+  RUN_TEST(test_alert_rdy_sync_avoids_duplicates);
+  RUN_TEST(test_alert_rdy_stale_level_is_not_read_twice);
+  RUN_TEST(test_alert_rdy_missing_pulse_times_out);
+  RUN_TEST(test_burst_leaves_sample_sequence_alone);
+  return UNITY_END();
+}
@@ -0,0 +1,177 @@
+/// @file test_main.cpp
+/// @brief Noise accumulator and characterization sweep against the simulator
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/Characterize.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+
+/// Alternates AIN0 between 0 and +2 LSB (2.048 V range) per conversion
+uint32_t windows = 0;
+void toggleInput(const sim::ConversionInfo& info, void* user) {
+  (void)info;
+  (void)user;
+  windows++;
+  simDevice.setInput(0, (windows & 1U) ? 125e-6f : 0.0f);
+}
+
+/// AIN0 is +1 LSB for every tenth conversion and 0 otherwise
+void sparseStep(const sim::ConversionInfo& info, void* user) {
+  (void)info;
+  (void)user;
+  windows++;
+  simDevice.setInput(0, (windows % 10 == 0) ? 62.5e-6f : 0.0f);
+}
+
+uint64_t seenResultUs = 0;
+bool alertPin(int pin, void* user) {
+  (void)pin;
+  (void)user;
+  simDevice.conversionDone(stub::nowUs);
+  if (simDevice.resultUs() != seenResultUs) {
+    seenResultUs = simDevice.resultUs();
+    return false;
+  }
+  return true;
+}
+
+constexpr uint8_t kRate860 = 1u << static_cast<uint8_t>(DataRate::SPS_860);
+constexpr uint8_t kGain2V = 1u << static_cast<uint8_t>(Gain::FSR_2_048V);
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 5;
+  simDevice.reset();
+  simDevice.setClockErrorPpm(0);
+  simDevice.setInput(0, 0.0f);
+  simDevice.setObserver(toggleInput, nullptr);
+  windows = 0;
+  seenResultUs = 0;
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  device.begin(config);
+}
+
+void tearDown() { simDevice.setObserver(nullptr, nullptr); }
+
+void test_accumulator_statistics() {
+  NoiseAccumulator<16> acc;
+  acc.reset();
+  const int16_t codes[] = {100, 102, 98, 100, 101, 99};
+  for (int16_t c : codes) {
+    acc.add(c);
+  }
+  NoiseStats stats;
+  acc.summarize(Gain::FSR_2_048V, stats);
+  TEST_ASSERT_EQUAL_UINT32(6, stats.samples);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 100.0f, stats.meanCodes);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.4142f, stats.rmsCodes);  // sqrt(10 / 5)
+  TEST_ASSERT_EQUAL_UINT16(4, stats.peakToPeakCodes);
+  TEST_ASSERT_EQUAL_INT16(98, stats.minRaw);
+  TEST_ASSERT_EQUAL_INT16(102, stats.maxRaw);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.4142f * 62.5f, stats.rmsUv);
+  TEST_ASSERT_EQUAL_UINT32(2, acc.bin(8));    // code 100 at the centre bin
+  TEST_ASSERT_EQUAL_INT32(100, acc.binCode(8));
+}
+
+void test_sweep_fills_table_and_restores_gain() {
+  NoiseStats table[4];
+  size_t written = 0;
+  const uint8_t gains = kGain2V | (1u << static_cast<uint8_t>(Gain::FSR_1_024V));
+  const uint8_t rates = kRate860 | (1u << static_cast<uint8_t>(DataRate::SPS_475));
+  TEST_ASSERT_TRUE(device.setGain(Gain::FSR_4_096V).ok());
+  TEST_ASSERT_TRUE(characterizeNoise(device, gains, rates, 40, table, 4, written).ok());
+  TEST_ASSERT_EQUAL_UINT32(4, written);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_4_096V),
+                          static_cast<uint8_t>(device.getGain()));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_2_048V),
+                          static_cast<uint8_t>(table[0].gain));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(DataRate::SPS_475),
+                          static_cast<uint8_t>(table[0].dataRate));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_1_024V),
+                          static_cast<uint8_t>(table[3].gain));
+  for (const NoiseStats& s : table) {
+    TEST_ASSERT_EQUAL_UINT32(40, s.samples);
+  }
+}
+
+void test_sweep_table_too_small() {
+  NoiseStats table[1];
+  size_t written = 0;
+  const uint8_t rates = kRate860 | (1u << static_cast<uint8_t>(DataRate::SPS_475));
+  Status st = characterizeNoise(device, kGain2V, rates, 8, table, 1, written);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::INVALID_PARAM),
+                          static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT32(1, written);
+}
+
+void test_unpaced_sweep_reads_each_conversion_once() {
+  simDevice.setClockErrorPpm(100000);  // A nominal burst schedule would re-read codes
+  TEST_ASSERT_TRUE(device.setMode(Mode::CONTINUOUS).ok());
+  NoiseStats stats;
+  size_t written = 0;
+  TEST_ASSERT_TRUE(characterizeNoise(device, kGain2V, kRate860, 256, &stats, 1, written).ok());
+  // One single-shot conversion per sample (the simulator reports the last one
+  // lazily); a burst re-reading every tenth code would see ~233
+  TEST_ASSERT_TRUE(windows >= 255);
+  TEST_ASSERT_EQUAL_UINT16(2, stats.peakToPeakCodes);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 1.0f, stats.rmsCodes);  // Alternating 0 / 2 codes
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Mode::CONTINUOUS),
+                          static_cast<uint8_t>(device.getMode()));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(DataRate::SPS_128),
+                          static_cast<uint8_t>(device.getDataRate()));
+}
+
+void test_quiet_input_is_not_inflated() {
+  // One conversion in ten is 1 LSB high: the code sequence repeats a lot,
+  // and its standard deviation is sqrt(0.1 * 0.9) ~= 0.30 LSB
+  simDevice.setObserver(sparseStep, nullptr);
+  NoiseStats stats;
+  size_t written = 0;
+  TEST_ASSERT_TRUE(characterizeNoise(device, kGain2V, kRate860, 250, &stats, 1, written).ok());
+  TEST_ASSERT_EQUAL_UINT16(1, stats.peakToPeakCodes);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.3006f, stats.rmsCodes);  // sqrt(25 * 225 / 250 / 249)
+}
+
+void test_alert_rdy_paced_sweep_reads_bursts() {
+  simDevice.setClockErrorPpm(100000);
+  config.alertRdyPin = 4;
+  config.gpioRead = alertPin;
+  device.begin(config);
+  TEST_ASSERT_TRUE(device.enableConversionReadyPin().ok());
+
+  NoiseStats stats;
+  size_t written = 0;
+  TEST_ASSERT_TRUE(characterizeNoise(device, kGain2V, kRate860, 256, &stats, 1, written).ok());
+  TEST_ASSERT_EQUAL_UINT16(2, stats.peakToPeakCodes);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f, 1.0f, stats.rmsCodes);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+  UNITY_BEGIN();
+  RUN_TEST(test_accumulator_statistics);
+  RUN_TEST(test_sweep_fills_table_and_restores_gain);
+  RUN_TEST(test_sweep_table_too_small);
+  RUN_TEST(test_unpaced_sweep_reads_each_conversion_once);
+  RUN_TEST(test_quiet_input_is_not_inflated);
+  RUN_TEST(test_alert_rdy_paced_sweep_reads_bursts);
+  return UNITY_END();
+}
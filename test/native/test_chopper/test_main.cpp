@@ -0,0 +1,160 @@
+/// @file test_main.cpp
+/// @brief Excitation-synchronous demodulation against a simulated bridge
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/Chopper.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+
+constexpr float kLsb = 7.8125e-6f;  // FSR 0.256 V
+float signalCodes = 0.0f;           ///< Bridge output with excitation HIGH
+float offsetCodes = 0.0f;           ///< Excitation-independent term
+
+bool levels[16];
+size_t levelCount = 0;
+
+/// Bridge on AIN0/AIN1: the signal follows the excitation, the offset does not
+void excite(int pin, bool level, void* user) {
+  (void)pin;
+  (void)user;
+  if (levelCount < 16) {
+    levels[levelCount++] = level;
+  }
+  float diff = (level ? signalCodes : -signalCodes) + offsetCodes;
+  simDevice.setInput(0, 1.0f + diff * kLsb);
+  simDevice.setInput(1, 1.0f);
+}
+
+ChopConfig chopConfig() {
+  ChopConfig chop;
+  chop.channel = {Mux::AIN0_AIN1, Gain::FSR_0_256V, DataRate::SPS_860};
+  chop.settleUs = 200;
+  chop.samplesPerOutput = 4;
+  return chop;
+}
+
+/// Poll every 100 us until @p outputs are complete (or @p limitUs elapses)
+void runUntil(Chopper& chopper, uint32_t outputs, uint64_t limitUs = 1000000) {
+  const uint64_t endUs = stub::nowUs + limitUs;
+  while (chopper.outputs() < outputs && stub::nowUs < endUs) {
+    chopper.poll(device, micros());
+    stub::nowUs += 100;
+  }
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 0;
+  simDevice.reset();
+  levelCount = 0;
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  config.excitationPin = 5;
+  config.gpioWrite = excite;
+  device.begin(config);
+}
+
+void tearDown() {}
+
+void test_phase_pattern_is_plus_minus_minus_plus() {
+  signalCodes = 100.0f;
+  offsetCodes = 0.0f;
+  Chopper chopper;
+  chopper.start(chopConfig());
+  runUntil(chopper, 2);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(8, levelCount);
+  const bool expected[8] = {true, false, false, true, true, false, false, true};
+  for (size_t i = 0; i < 8; ++i) {
+    TEST_ASSERT_EQUAL(expected[i], levels[i]);
+  }
+}
+
+void test_demodulated_sign_follows_excitation() {
+  signalCodes = 1000.0f;
+  offsetCodes = 200.0f;
+  Chopper chopper;
+  chopper.start(chopConfig());
+  runUntil(chopper, 1);
+  TEST_ASSERT_EQUAL_UINT32(1, chopper.outputs());
+  const ChopOutput& out = chopper.lastOutput();
+  TEST_ASSERT_EQUAL_INT32(1000, out.value);
+  TEST_ASSERT_EQUAL_INT32(200, out.offset);
+  TEST_ASSERT_EQUAL_INT32(4000, out.sum);
+  TEST_ASSERT_EQUAL_UINT16(4, out.samples);
+}
+
+void test_reversed_bridge_gives_negative_value() {
+  signalCodes = -750.0f;
+  offsetCodes = -40.0f;
+  Chopper chopper;
+  chopper.start(chopConfig());
+  runUntil(chopper, 1);
+  const ChopOutput& out = chopper.lastOutput();
+  TEST_ASSERT_EQUAL_INT32(-750, out.value);
+  TEST_ASSERT_EQUAL_INT32(-40, out.offset);
+}
+
+void test_samples_rounded_up_to_groups_of_four() {
+  signalCodes = 10.0f;
+  offsetCodes = 0.0f;
+  ChopConfig chop = chopConfig();
+  chop.samplesPerOutput = 5;
+  Chopper chopper;
+  chopper.start(chop);
+  runUntil(chopper, 1);
+  TEST_ASSERT_EQUAL_UINT16(8, chopper.lastOutput().samples);
+  TEST_ASSERT_EQUAL_INT32(10, chopper.lastOutput().value);
+}
+
+void test_samples_clamped_below_uint16_wrap() {
+  signalCodes = 10.0f;
+  offsetCodes = 0.0f;
+  ChopConfig chop = chopConfig();
+  chop.samplesPerOutput = 65535;  // Rounding up would wrap to 0
+  Chopper chopper;
+  chopper.start(chop);
+  runUntil(chopper, 1, 200000000);  // ~1.6 ms per phase
+  TEST_ASSERT_EQUAL_UINT16(65532, chopper.lastOutput().samples);
+  TEST_ASSERT_EQUAL_INT32(10, chopper.lastOutput().value);
+}
+
+void test_stop_parks_excitation() {
+  signalCodes = 10.0f;
+  ChopConfig chop = chopConfig();
+  chop.excitationIdle = false;
+  Chopper chopper;
+  chopper.start(chop);
+  runUntil(chopper, 1);
+  TEST_ASSERT_TRUE(chopper.stop(device).ok());
+  TEST_ASSERT_FALSE(chopper.running());
+  TEST_ASSERT_FALSE(levels[levelCount - 1]);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+  UNITY_BEGIN();
+  RUN_TEST(test_phase_pattern_is_plus_minus_minus_plus);
+  RUN_TEST(test_demodulated_sign_follows_excitation);
+  RUN_TEST(test_reversed_bridge_gives_negative_value);
+  RUN_TEST(test_samples_rounded_up_to_groups_of_four);
+  RUN_TEST(test_samples_clamped_below_uint16_wrap);
+  RUN_TEST(test_stop_parks_excitation);
+  return UNITY_END();
+}
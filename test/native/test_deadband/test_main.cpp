@@ -0,0 +1,135 @@
+/// @file test_main.cpp
+/// @brief Dead-band report-by-exception filter
+
+#include <unity.h>
+
+#include "ADS1115/DeadBand.h"
+
+using namespace ADS1115;
+
+void setUp() {}
+void tearDown() {}
+
+Sample makeSample(int16_t raw, uint32_t timestampUs, uint8_t flags = 0) {
+  Sample s;
+  s.raw = raw;
+  s.timestampUs = timestampUs;
+  s.mux = Mux::AIN0_GND;
+  s.flags = flags;
+  return s;
+}
+
+void test_first_sample_reported() {
+  DeadBand band;
+  band.setThreshold(Mux::AIN0_GND, 10);
+  Sample s = makeSample(100, 0);
+  TEST_ASSERT_TRUE(band.accept(s));
+  TEST_ASSERT_EQUAL_UINT32(1, band.stats(Mux::AIN0_GND).reported);
+}
+
+void test_threshold_is_exclusive() {
+  DeadBand band;
+  band.setThreshold(Mux::AIN0_GND, 10);
+  Sample s = makeSample(100, 0);
+  band.accept(s);
+
+  Sample inside = makeSample(110, 1000);
+  TEST_ASSERT_FALSE(band.accept(inside));
+  Sample below = makeSample(90, 2000);
+  TEST_ASSERT_FALSE(band.accept(below));
+  Sample outside = makeSample(111, 3000);
+  TEST_ASSERT_TRUE(band.accept(outside));
+  // The band follows the last reported value, not the first one
+  Sample back = makeSample(101, 4000);
+  TEST_ASSERT_FALSE(band.accept(back));
+  Sample down = makeSample(100, 5000);
+  TEST_ASSERT_TRUE(band.accept(down));
+
+  DeadBandStats st = band.stats(Mux::AIN0_GND);
+  TEST_ASSERT_EQUAL_UINT32(3, st.reported);
+  TEST_ASSERT_EQUAL_UINT32(3, st.suppressed);
+}
+
+void test_threshold_volts_uses_gain_lsb() {
+  DeadBand band;
+  band.setThresholdVolts(Mux::AIN0_GND, 0.00064f, Gain::FSR_2_048V);  // 10.24 codes
+  Sample s = makeSample(0, 0);
+  band.accept(s);
+  Sample inside = makeSample(10, 1);
+  TEST_ASSERT_FALSE(band.accept(inside));
+  Sample outside = makeSample(11, 2);
+  TEST_ASSERT_TRUE(band.accept(outside));
+}
+
+void test_gain_change_always_reported() {
+  DeadBand band;
+  band.setThreshold(Mux::AIN0_GND, 1000);
+  Sample s = makeSample(0, 0);
+  band.accept(s);
+  Sample other = makeSample(0, 1);
+  other.gain = Gain::FSR_0_256V;
+  TEST_ASSERT_TRUE(band.accept(other));
+}
+
+void test_heartbeat_after_silence() {
+  DeadBand band;
+  band.setThreshold(Mux::AIN0_GND, 100);
+  band.setMaxSilenceUs(Mux::AIN0_GND, 10000);
+  Sample s = makeSample(0, 0);
+  band.accept(s);
+
+  Sample quiet = makeSample(1, 9999);
+  TEST_ASSERT_FALSE(band.accept(quiet));
+  Sample beat = makeSample(1, 10000);
+  TEST_ASSERT_TRUE(band.accept(beat));
+  TEST_ASSERT_TRUE(beat.flags & SampleFlag::HEARTBEAT);
+
+  // Silence restarts from the heartbeat
+  Sample next = makeSample(2, 15000);
+  TEST_ASSERT_FALSE(band.accept(next));
+  TEST_ASSERT_EQUAL_UINT32(1, band.stats(Mux::AIN0_GND).heartbeats);
+}
+
+void test_gap_on_suppressed_sample_carried_forward() {
+  DeadBand band;
+  band.setThreshold(Mux::AIN0_GND, 10);
+  Sample s = makeSample(0, 0);
+  band.accept(s);
+
+  Sample gap = makeSample(1, 1000, SampleFlag::GAP);
+  TEST_ASSERT_FALSE(band.accept(gap));
+  Sample quiet = makeSample(2, 2000);
+  TEST_ASSERT_FALSE(band.accept(quiet));
+  Sample moved = makeSample(50, 3000);
+  TEST_ASSERT_TRUE(band.accept(moved));
+  TEST_ASSERT_TRUE(moved.flags & SampleFlag::GAP);
+
+  Sample after = makeSample(100, 4000);
+  TEST_ASSERT_TRUE(band.accept(after));
+  TEST_ASSERT_FALSE(after.flags & SampleFlag::GAP);
+}
+
+void test_stage_compacts_and_rearm() {
+  DeadBand band;
+  band.setThreshold(Mux::AIN0_GND, 10);
+  Sample batch[4] = {makeSample(0, 0), makeSample(5, 1), makeSample(50, 2), makeSample(52, 3)};
+  TEST_ASSERT_EQUAL(2, DeadBand::stage(batch, 4, &band));
+  TEST_ASSERT_EQUAL_INT16(0, batch[0].raw);
+  TEST_ASSERT_EQUAL_INT16(50, batch[1].raw);
+
+  band.rearm();
+  Sample again = makeSample(52, 4);
+  TEST_ASSERT_TRUE(band.accept(again));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_sample_reported);
+  RUN_TEST(test_threshold_is_exclusive);
+  RUN_TEST(test_threshold_volts_uses_gain_lsb);
+  RUN_TEST(test_gain_change_always_reported);
+  RUN_TEST(test_heartbeat_after_silence);
+  RUN_TEST(test_gap_on_suppressed_sample_carried_forward);
+  RUN_TEST(test_stage_compacts_and_rearm);
+  return UNITY_END();
+}
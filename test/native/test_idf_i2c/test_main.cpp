@@ -0,0 +1,205 @@
+/// @file test_main.cpp
+/// @brief ESP-IDF i2c_master transport (host shim) against the simulator
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "common/EspIdfI2cTransport.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+using transport::IdfI2cBus;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+IdfI2cBus bus;
+
+uint32_t failWrites = 0;  ///< Next N shim writes NACK
+
+bool simWrite(uint16_t addr, const uint8_t* data, size_t len, void* user) {
+  if (failWrites > 0) {
+    failWrites--;
+    return false;
+  }
+  return static_cast<sim::Bus*>(user)->write(static_cast<uint8_t>(addr), data, len).ok();
+}
+
+bool simWriteRead(uint16_t addr, const uint8_t* tx, size_t txLen, uint8_t* rx, size_t rxLen,
+                  void* user) {
+  return static_cast<sim::Bus*>(user)
+      ->writeRead(static_cast<uint8_t>(addr), tx, txLen, rx, rxLen)
+      .ok();
+}
+
+bool simRead(uint16_t addr, uint8_t* rx, size_t rxLen, void* user) {
+  return static_cast<sim::Bus*>(user)->read(static_cast<uint8_t>(addr), rx, rxLen).ok();
+}
+
+/// Start @p bus in blocking (asyncDepth 0) or queued mode and point the driver at it
+void startBus(size_t asyncDepth) {
+  TEST_ASSERT_TRUE(bus.begin(0, 21, 22, asyncDepth).ok());
+  TEST_ASSERT_TRUE(bus.addDevice(0x48).ok());
+  config = Config{};
+  bus.attach(config);
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  bus.resetCounters();
+  idf_shim::counters = idf_shim::Counters{};
+  simBus.resetCounters();
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 5;
+  simDevice.reset();
+  simDevice.setInput(0, 0.0f);
+  failWrites = 0;
+  idf_shim::counters = idf_shim::Counters{};
+}
+
+void tearDown() { bus.end(); }
+
+void test_blocking_register_access() {
+  startBus(0);
+
+  TEST_ASSERT_TRUE(device.setThresholds(-1000, 2000).ok());
+  int16_t low = 0;
+  int16_t high = 0;
+  TEST_ASSERT_TRUE(device.getThresholds(low, high).ok());
+  TEST_ASSERT_EQUAL_INT16(-1000, low);
+  TEST_ASSERT_EQUAL_INT16(2000, high);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(-1000), simDevice.reg(0x02));
+
+  // Each register read is one repeated-START transfer; nothing is queued
+  TEST_ASSERT_EQUAL_UINT32(2, idf_shim::counters.transmitReceives);
+  TEST_ASSERT_EQUAL_UINT32(idf_shim::counters.transmits, simBus.counters().writes);
+  TEST_ASSERT_EQUAL_UINT32(0, bus.counters().queued);
+  TEST_ASSERT_EQUAL_UINT32(0, idf_shim::counters.callbacks);
+  TEST_ASSERT_EQUAL_UINT32(0, bus.counters().errors);
+}
+
+void test_blocking_single_shot_read() {
+  startBus(0);
+
+  simDevice.setInput(0, 1.0f);
+  TEST_ASSERT_TRUE(device.setMux(Mux::AIN0_GND).ok());
+  int16_t raw = 0;
+  TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+  TEST_ASSERT_TRUE(raw > 15990 && raw < 16010);  // 1 V on the 2.048 V range
+}
+
+void test_blocking_write_failure_is_immediate() {
+  startBus(0);
+
+  failWrites = 1;
+  Status st = device.setThresholds(100, 200);
+  TEST_ASSERT_FALSE(st.ok());
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, st.code);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.counters().errors);
+  TEST_ASSERT_EQUAL_UINT32(0, bus.counters().queuedFailures);
+}
+
+void test_async_writes_queue_until_read() {
+  startBus(2);
+
+  TEST_ASSERT_TRUE(device.setThresholds(-500, 500).ok());
+  TEST_ASSERT_TRUE(bus.counters().queued >= 2);
+  TEST_ASSERT_EQUAL_UINT32(0, idf_shim::counters.waitAllDone);
+  TEST_ASSERT_EQUAL_UINT32(bus.counters().queued, idf_shim::counters.callbacks);
+
+  uint16_t reg = 0;
+  TEST_ASSERT_TRUE(device.readConfig(reg).ok());
+  TEST_ASSERT_EQUAL_UINT16(simDevice.reg(0x01) & 0x7FFF, reg & 0x7FFF);
+  TEST_ASSERT_TRUE(idf_shim::counters.waitAllDone >= 1);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(-500), simDevice.reg(0x02));
+  TEST_ASSERT_EQUAL_UINT16(500, simDevice.reg(0x03));
+}
+
+void test_async_queued_failure_reported_by_next_call() {
+  startBus(2);
+
+  // The NACK only arrives through the done callback, so the write itself succeeds
+  failWrites = 1;
+  const uint8_t data[3] = {0x02, 0x00, 0x10};
+  TEST_ASSERT_TRUE(bus.write(0x48, data, 3, 10).ok());
+  TEST_ASSERT_EQUAL_UINT32(0, bus.counters().errors);
+
+  uint16_t reg = 0;
+  Status st = device.readConfig(reg);
+  TEST_ASSERT_FALSE(st.ok());
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, st.code);
+  TEST_ASSERT_EQUAL_INT32(1, st.detail);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.counters().queuedFailures);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.counters().errors);
+
+  // Reported once; the bus is usable again
+  TEST_ASSERT_TRUE(device.readConfig(reg).ok());
+  TEST_ASSERT_TRUE(bus.flush(10).ok());
+}
+
+void test_async_queued_failure_blocks_next_write() {
+  startBus(2);
+
+  failWrites = 1;
+  const uint8_t first[3] = {0x02, 0x00, 0x10};
+  const uint8_t second[3] = {0x03, 0x00, 0x20};
+  TEST_ASSERT_TRUE(bus.write(0x48, first, 3, 10).ok());
+  uint32_t transmits = idf_shim::counters.transmits;
+  Status st = bus.write(0x48, second, 3, 10);
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, st.code);
+  TEST_ASSERT_EQUAL_UINT32(transmits, idf_shim::counters.transmits);  // Not sent
+  TEST_ASSERT_TRUE(bus.write(0x48, second, 3, 10).ok());
+  TEST_ASSERT_TRUE(bus.flush(10).ok());
+  TEST_ASSERT_EQUAL_UINT16(0x0020, simDevice.reg(0x03));
+}
+
+void test_async_flush_reports_failure() {
+  startBus(2);
+
+  failWrites = 1;
+  const uint8_t data[3] = {0x02, 0x00, 0x10};
+  TEST_ASSERT_TRUE(bus.write(0x48, data, 3, 10).ok());
+  Status st = bus.flush(10);
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, st.code);
+  TEST_ASSERT_TRUE(bus.flush(10).ok());
+}
+
+void test_unknown_address_rejected() {
+  startBus(0);
+
+  const uint8_t data[1] = {0x00};
+  uint8_t rx[2] = {};
+  TEST_ASSERT_EQUAL(Err::INVALID_PARAM, bus.write(0x49, data, 1, 10).code);
+  TEST_ASSERT_EQUAL(Err::INVALID_PARAM, bus.writeRead(0x49, data, 1, rx, 2, 10).code);
+  TEST_ASSERT_EQUAL_UINT32(0, idf_shim::counters.transmits);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+  idf_shim::backend.write = simWrite;
+  idf_shim::backend.writeRead = simWriteRead;
+  idf_shim::backend.read = simRead;
+  idf_shim::backend.user = &simBus;
+
+  UNITY_BEGIN();
+  RUN_TEST(test_blocking_register_access);
+  RUN_TEST(test_blocking_single_shot_read);
+  RUN_TEST(test_blocking_write_failure_is_immediate);
+  RUN_TEST(test_async_writes_queue_until_read);
+  RUN_TEST(test_async_queued_failure_reported_by_next_call);
+  RUN_TEST(test_async_queued_failure_blocks_next_write);
+  RUN_TEST(test_async_flush_reports_failure);
+  RUN_TEST(test_unknown_address_rejected);
+  return UNITY_END();
+}
@@ -0,0 +1,163 @@
+/// @file test_main.cpp
+/// @brief IntervalStats / JitterMonitor statistics and GAP handling
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/JitterStats.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+Sample sampleAt(uint32_t timestampUs, Mux mux = Mux::AIN0_GND, uint8_t flags = 0) {
+  Sample s;
+  s.timestampUs = timestampUs;
+  s.mux = mux;
+  s.flags = flags;
+  return s;
+}
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_empty_summary_is_zero() {
+  IntervalStats<> stats;
+  stats.reset();
+  JitterSummary s = stats.summary();
+  TEST_ASSERT_EQUAL_UINT32(0, s.count);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, s.meanUs);
+  TEST_ASSERT_EQUAL_UINT32(0, s.maxUs);
+}
+
+void test_mean_stddev_min_max() {
+  IntervalStats<> stats;
+  stats.reset(10, 1000);
+  const uint32_t intervals[4] = {1000, 1010, 990, 1000};
+  for (uint32_t us : intervals) {
+    stats.add(us);
+  }
+  JitterSummary s = stats.summary();
+  TEST_ASSERT_EQUAL_UINT32(4, s.count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 1000.0f, s.meanUs);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 8.165f, s.stddevUs);  // sqrt(200 / 3)
+  TEST_ASSERT_EQUAL_UINT32(990, s.minUs);
+  TEST_ASSERT_EQUAL_UINT32(1010, s.maxUs);
+}
+
+void test_p99_ignores_single_outlier() {
+  IntervalStats<> stats;
+  stats.reset(10, 1000);
+  for (int i = 0; i < 99; ++i) {
+    stats.add(1000);
+  }
+  stats.add(5000);
+  JitterSummary s = stats.summary();
+  TEST_ASSERT_EQUAL_UINT32(1010, s.p99Us);  // Upper edge of the 1000 us bin
+  TEST_ASSERT_EQUAL_UINT32(5000, s.maxUs);
+}
+
+void test_p99_of_late_tail() {
+  IntervalStats<> stats;
+  stats.reset(10, 1000);
+  for (int i = 0; i < 90; ++i) {
+    stats.add(1000);
+  }
+  for (int i = 0; i < 10; ++i) {
+    stats.add(1100);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1100, stats.summary().p99Us);  // Clamped to max
+}
+
+void test_histogram_centred_on_nominal_period() {
+  // A startup outlier first: with the nominal period the histogram still
+  // covers the steady-state intervals
+  IntervalStats<> centred;
+  centred.reset(10, 1000);
+  centred.add(3000);
+  for (int i = 0; i < 200; ++i) {
+    centred.add(1000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1010, centred.summary().p99Us);
+
+  // Without it the first interval is the centre and every later one falls
+  // below the histogram, so p99 only resolves to its bottom edge
+  IntervalStats<> firstSeen;
+  firstSeen.reset(10, 0);
+  firstSeen.add(3000);
+  for (int i = 0; i < 200; ++i) {
+    firstSeen.add(1000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(3000 - 16 * 10, firstSeen.summary().p99Us);
+}
+
+void test_far_outliers_do_not_overflow() {
+  IntervalStats<> stats;
+  stats.reset(10, 1000);
+  stats.add(1000);
+  stats.add(4000001000u);  // Deviation squared exceeds INT64_MAX
+  JitterSummary s = stats.summary();
+  TEST_ASSERT_FLOAT_WITHIN(1000.0f, 2000001000.0f, s.meanUs);
+  TEST_ASSERT_FLOAT_WITHIN(1e4f, 2828427125.0f, s.stddevUs);  // 4e9 / sqrt(2)
+  TEST_ASSERT_EQUAL_UINT32(4000001000u, s.maxUs);
+}
+
+void test_monitor_skips_gap_intervals() {
+  JitterMonitor<> monitor;
+  monitor.reset(10, 1000);
+  monitor.record(sampleAt(0));
+  monitor.record(sampleAt(1000));
+  monitor.record(sampleAt(2000));
+  monitor.record(sampleAt(9000, Mux::AIN0_GND, SampleFlag::GAP));  // Pause: not an interval
+  monitor.record(sampleAt(10000));
+
+  JitterSummary s = monitor.summary(Mux::AIN0_GND);
+  TEST_ASSERT_EQUAL_UINT32(3, s.count);
+  TEST_ASSERT_EQUAL_UINT32(1000, s.maxUs);
+}
+
+void test_monitor_tracks_channels_separately() {
+  JitterMonitor<> monitor;
+  monitor.reset(10, 0);
+  // Interleaved scan: each channel sees its own 2000 us period
+  for (uint32_t i = 0; i < 5; ++i) {
+    ADS1115::JitterMonitor<>::onSample(sampleAt(i * 2000, Mux::AIN0_GND), &monitor);
+    ADS1115::JitterMonitor<>::onSample(sampleAt(i * 2000 + 1000, Mux::AIN1_GND), &monitor);
+  }
+  TEST_ASSERT_EQUAL_UINT32(4, monitor.summary(Mux::AIN0_GND).count);
+  TEST_ASSERT_EQUAL_UINT32(4, monitor.summary(Mux::AIN1_GND).count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 2000.0f, monitor.summary(Mux::AIN1_GND).meanUs);
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.summary(Mux::AIN2_GND).count);
+}
+
+void test_monitor_handles_timestamp_wrap() {
+  JitterMonitor<> monitor;
+  monitor.reset(10, 1000);
+  monitor.record(sampleAt(0xFFFFFE00u));
+  monitor.record(sampleAt(0x000001E8u));  // 1000 us later across the wrap
+  JitterSummary s = monitor.summary(Mux::AIN0_GND);
+  TEST_ASSERT_EQUAL_UINT32(1, s.count);
+  TEST_ASSERT_EQUAL_UINT32(1000, s.maxUs);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_summary_is_zero);
+  RUN_TEST(test_mean_stddev_min_max);
+  RUN_TEST(test_p99_ignores_single_outlier);
+  RUN_TEST(test_p99_of_late_tail);
+  RUN_TEST(test_histogram_centred_on_nominal_period);
+  RUN_TEST(test_far_outliers_do_not_overflow);
+  RUN_TEST(test_monitor_skips_gap_intervals);
+  RUN_TEST(test_monitor_tracks_channels_separately);
+  RUN_TEST(test_monitor_handles_timestamp_wrap);
+  return UNITY_END();
+}
@@ -0,0 +1,184 @@
+/// @file test_main.cpp
+/// @brief LatestSamples seqlock board: slots, packing, versions and torn reads
+
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "ADS1115/LatestSamples.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+/// Every field derived from @p k, so a mix of two publishes is detectable
+Sample sampleFor(uint32_t k) {
+  Sample s;
+  s.timestampUs = k;
+  s.seq = k;
+  s.raw = static_cast<int16_t>(k & 0x7FFF);
+  s.mux = Mux::AIN1_GND;
+  s.gain = static_cast<Gain>(k % 6);
+  s.flags = static_cast<uint8_t>(k & 0x03);
+  return s;
+}
+
+bool consistent(const Sample& s) {
+  const Sample expect = sampleFor(s.timestampUs);
+  return s.seq == expect.seq && s.raw == expect.raw && s.mux == expect.mux &&
+         s.gain == expect.gain && s.flags == expect.flags;
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 10;
+  simDevice.reset();
+}
+
+void tearDown() {}
+
+void test_empty_slot_reads_false() {
+  LatestSamples latest;
+  Sample s;
+  TEST_ASSERT_FALSE(latest.read(Mux::AIN0_GND, s));
+  TEST_ASSERT_EQUAL_UINT32(0, latest.version(Mux::AIN0_GND));
+
+  latest.publish(sampleFor(1));  // AIN1 only
+  TEST_ASSERT_FALSE(latest.read(Mux::AIN0_GND, s));
+  TEST_ASSERT_TRUE(latest.read(Mux::AIN1_GND, s));
+}
+
+void test_out_of_range_mux_is_ignored() {
+  LatestSamples latest;
+  const Mux bad = static_cast<Mux>(LatestSamples::kChannels);
+  Sample s = sampleFor(7);
+  s.mux = bad;
+  latest.publish(s);
+  TEST_ASSERT_FALSE(latest.read(bad, s));
+  TEST_ASSERT_EQUAL_UINT32(0, latest.version(bad));
+}
+
+void test_pack_round_trip() {
+  LatestSamples latest;
+  Sample in;
+  in.timestampUs = 0xDEADBEEF;
+  in.seq = 123456789;
+  in.raw = -12345;
+  in.mux = Mux::AIN3_GND;
+  in.gain = Gain::FSR_0_256V;
+  in.flags = SampleFlag::HEARTBEAT | SampleFlag::GAP;
+  latest.publish(in);
+
+  Sample out;
+  TEST_ASSERT_TRUE(latest.read(Mux::AIN3_GND, out));
+  TEST_ASSERT_EQUAL_UINT32(in.timestampUs, out.timestampUs);
+  TEST_ASSERT_EQUAL_UINT32(in.seq, out.seq);
+  TEST_ASSERT_EQUAL_INT16(in.raw, out.raw);
+  TEST_ASSERT_EQUAL(in.mux, out.mux);
+  TEST_ASSERT_EQUAL(in.gain, out.gain);
+  TEST_ASSERT_EQUAL_UINT8(in.flags, out.flags);
+}
+
+void test_version_counts_publishes_per_channel() {
+  LatestSamples latest;
+  for (uint32_t k = 1; k <= 3; ++k) {
+    latest.publish(sampleFor(k));
+  }
+  Sample other = sampleFor(9);
+  other.mux = Mux::AIN2_GND;
+  latest.publish(other);
+
+  TEST_ASSERT_EQUAL_UINT32(3, latest.version(Mux::AIN1_GND));
+  TEST_ASSERT_EQUAL_UINT32(1, latest.version(Mux::AIN2_GND));
+  Sample s;
+  TEST_ASSERT_TRUE(latest.read(Mux::AIN1_GND, s));
+  TEST_ASSERT_EQUAL_UINT32(3, s.seq);  // Latest wins
+}
+
+void test_driver_hook_publishes_samples() {
+  LatestSamples latest;
+  Config config;
+  sim::attachTransport(config, simBus);
+  config.mux = Mux::AIN2_GND;
+  config.onSample = LatestSamples::onSample;
+  config.sampleUser = &latest;
+  simDevice.setInput(2, 0.25f);
+  ADS1115::ADS1115 device;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+
+  int16_t raw = 0;
+  TEST_ASSERT_TRUE(device.readBlocking(raw).ok());
+  Sample s;
+  TEST_ASSERT_TRUE(latest.read(Mux::AIN2_GND, s));
+  TEST_ASSERT_EQUAL_INT16(raw, s.raw);
+  TEST_ASSERT_EQUAL_UINT32(device.lastSample().seq, s.seq);
+  TEST_ASSERT_EQUAL_UINT32(device.lastSample().timestampUs, s.timestampUs);
+}
+
+void test_no_torn_read_while_publishing() {
+  LatestSamples latest;
+  constexpr uint32_t kReads = 20000;
+  constexpr uint32_t kMaxAttempts = 50000000;
+  latest.publish(sampleFor(1));
+  std::atomic<bool> stop{false};
+  std::atomic<uint32_t> published{1};
+  std::thread writer([&]() {
+    for (uint32_t k = 2; !stop.load(std::memory_order_relaxed); ++k) {
+      latest.publish(sampleFor(k));
+      published.store(k, std::memory_order_relaxed);
+    }
+  });
+
+  // Read until enough reads ran and the writer has visibly moved on (bounded,
+  // so a starved reader fails the test instead of hanging it)
+  uint32_t reads = 0;
+  uint32_t torn = 0;
+  uint32_t lastSeen = 0;
+  bool backwards = false;
+  for (uint32_t attempt = 0; attempt < kMaxAttempts && (reads < kReads || lastSeen < kReads); ++attempt) {
+    Sample s;
+    if (latest.read(Mux::AIN1_GND, s)) {
+      reads++;
+      torn += consistent(s) ? 0 : 1;
+      backwards = backwards || s.seq < lastSeen;
+      lastSeen = s.seq;
+    }
+  }
+  stop.store(true);
+  writer.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn);
+  TEST_ASSERT_FALSE(backwards);
+  TEST_ASSERT_TRUE(reads >= kReads);
+  TEST_ASSERT_TRUE(lastSeen >= kReads);
+  Sample s;
+  TEST_ASSERT_TRUE(latest.read(Mux::AIN1_GND, s));
+  TEST_ASSERT_EQUAL_UINT32(published.load(), s.seq);
+  TEST_ASSERT_EQUAL_UINT32(published.load(), latest.version(Mux::AIN1_GND));
+}
+
+int main() {
+  simBus.attach(&simDevice);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_slot_reads_false);
+  RUN_TEST(test_out_of_range_mux_is_ignored);
+  RUN_TEST(test_pack_round_trip);
+  RUN_TEST(test_version_counts_publishes_per_channel);
+  RUN_TEST(test_driver_hook_publishes_samples);
+  RUN_TEST(test_no_torn_read_while_publishing);
+  return UNITY_END();
+}
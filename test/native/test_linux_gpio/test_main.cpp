@@ -0,0 +1,216 @@
+/// @file test_main.cpp
+/// @brief Linux GPIO ALERT/RDY events through a fake event fd (pipe)
+
+#include <unity.h>
+
+#if defined(__linux__)
+
+#include <cstring>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "common/LinuxGpioAlert.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+using transport::LinuxGpioAlert;
+using transport::LinuxGpioSyscalls;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+constexpr int kChipFd = 40;
+
+struct Mock {
+  int pipeFds[2] = {-1, -1};
+  uint64_t flags = 0;
+  uint32_t line = 0;
+  uint64_t clockNs = 0;
+  uint32_t nextSeq = 1;
+};
+
+Mock mock;
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+
+int fakeOpen(const char* path, int flags, void* ctx) {
+  (void)path;
+  (void)flags;
+  (void)ctx;
+  return kChipFd;
+}
+
+/// Hands back the pipe's read end as the line event fd
+int fakeIoctl(int fd, unsigned long request, void* arg, void* ctx) {
+  Mock* m = static_cast<Mock*>(ctx);
+  if (fd != kChipFd || request != GPIO_V2_GET_LINE_IOCTL) {
+    errno = ENOTTY;
+    return -1;
+  }
+  auto* req = static_cast<gpio_v2_line_request*>(arg);
+  m->flags = req->config.flags;
+  m->line = req->offsets[0];
+  req->fd = m->pipeFds[0];
+  return 0;
+}
+
+int fakeClose(int fd, void* ctx) {
+  (void)ctx;
+  return (fd == kChipFd) ? 0 : ::close(fd);
+}
+
+uint64_t fakeClock(void* ctx) { return static_cast<Mock*>(ctx)->clockNs; }
+
+LinuxGpioSyscalls fakeSyscalls() {
+  LinuxGpioSyscalls sys;
+  sys.open = fakeOpen;
+  sys.ioctl = fakeIoctl;
+  sys.close = fakeClose;
+  sys.clockNs = fakeClock;
+  sys.ctx = &mock;
+  return sys;
+}
+
+/// Queue one falling edge stamped @p timestampNs
+void pushEdge(uint64_t timestampNs, uint32_t skipSeq = 0) {
+  gpio_v2_line_event ev;
+  std::memset(&ev, 0, sizeof(ev));
+  ev.timestamp_ns = timestampNs;
+  ev.id = GPIO_V2_LINE_EVENT_FALLING_EDGE;
+  ev.offset = mock.line;
+  mock.nextSeq += skipSeq;
+  ev.seqno = mock.nextSeq;
+  ev.line_seqno = mock.nextSeq;
+  mock.nextSeq++;
+  TEST_ASSERT_EQUAL_INT(static_cast<int>(sizeof(ev)), ::write(mock.pipeFds[1], &ev, sizeof(ev)));
+}
+
+} // namespace
+
+void setUp() {
+  mock = Mock{};
+  TEST_ASSERT_EQUAL_INT(0, ::pipe(mock.pipeFds));
+  stub::nowUs = 0;
+  simDevice.reset();
+  Config cfg;
+  sim::attachTransport(cfg, simBus);
+  device.begin(cfg);
+  device.enableConversionReadyPin();
+}
+
+void tearDown() {
+  if (mock.pipeFds[1] >= 0) {
+    ::close(mock.pipeFds[1]);
+  }
+}
+
+void test_line_requested_for_falling_edges_with_pull_up() {
+  LinuxGpioAlert alert(fakeSyscalls());
+  TEST_ASSERT_TRUE(alert.open("/dev/gpiochip0", 17).ok());
+  TEST_ASSERT_EQUAL_UINT32(17, mock.line);
+  TEST_ASSERT_TRUE((mock.flags & GPIO_V2_LINE_FLAG_EDGE_FALLING) != 0);
+  TEST_ASSERT_TRUE((mock.flags & GPIO_V2_LINE_FLAG_EDGE_RISING) == 0);
+  TEST_ASSERT_TRUE((mock.flags & GPIO_V2_LINE_FLAG_BIAS_PULL_UP) != 0);
+  TEST_ASSERT_EQUAL_INT(mock.pipeFds[0], alert.fd());
+}
+
+void test_edge_completes_conversion() {
+  LinuxGpioAlert alert(fakeSyscalls());
+  alert.open("/dev/gpiochip0", 17);
+  alert.attach(device);
+
+  mock.clockNs = 1000;
+  alert.arm();
+  TEST_ASSERT_TRUE(device.startConversion().inProgress());
+  TEST_ASSERT_EQUAL_INT(0, alert.wait(0));
+  TEST_ASSERT_FALSE(device.conversionReady());
+
+  pushEdge(2000);
+  TEST_ASSERT_EQUAL_INT(1, alert.wait(100));
+  TEST_ASSERT_TRUE(device.conversionReady());
+  TEST_ASSERT_EQUAL_UINT32(1, alert.counters().notified);
+  TEST_ASSERT_TRUE(alert.lastEdgeNs() == 2000);
+  TEST_ASSERT_TRUE(alert.takeEdge());
+  TEST_ASSERT_FALSE(alert.takeEdge());
+}
+
+void test_queued_stale_edge_is_discarded_by_arm() {
+  LinuxGpioAlert alert(fakeSyscalls());
+  alert.open("/dev/gpiochip0", 17);
+  alert.attach(device);
+
+  pushEdge(500);  // left over from an earlier conversion
+  mock.clockNs = 1000;
+  TEST_ASSERT_EQUAL_UINT32(1, alert.arm());
+  TEST_ASSERT_TRUE(device.startConversion().inProgress());
+  TEST_ASSERT_EQUAL_INT(0, alert.wait(0));
+  TEST_ASSERT_FALSE(device.conversionReady());
+  TEST_ASSERT_EQUAL_UINT32(1, alert.counters().stale);
+  TEST_ASSERT_EQUAL_UINT32(0, alert.counters().notified);
+  TEST_ASSERT_FALSE(alert.takeEdge());
+}
+
+void test_late_delivered_old_edge_is_ignored() {
+  LinuxGpioAlert alert(fakeSyscalls());
+  alert.open("/dev/gpiochip0", 17);
+  alert.attach(device);
+
+  mock.clockNs = 1000;
+  alert.arm();
+  TEST_ASSERT_TRUE(device.startConversion().inProgress());
+  // Stamped before the start but only readable now
+  pushEdge(900);
+  TEST_ASSERT_EQUAL_INT(1, alert.wait(0));
+  TEST_ASSERT_FALSE(device.conversionReady());
+  TEST_ASSERT_EQUAL_UINT32(1, alert.counters().stale);
+
+  pushEdge(1500);
+  TEST_ASSERT_EQUAL_INT(1, alert.wait(0));
+  TEST_ASSERT_TRUE(device.conversionReady());
+}
+
+void test_line_seqno_gaps_count_lost_edges() {
+  LinuxGpioAlert alert(fakeSyscalls());
+  alert.open("/dev/gpiochip0", 17);
+  pushEdge(100);
+  pushEdge(200, 3);
+  TEST_ASSERT_EQUAL_UINT32(2, alert.drain());
+  TEST_ASSERT_EQUAL_UINT32(3, alert.counters().lost);
+  TEST_ASSERT_EQUAL_UINT32(2, alert.counters().edges);
+}
+
+void test_wait_times_out_without_events() {
+  LinuxGpioAlert alert(fakeSyscalls());
+  alert.open("/dev/gpiochip0", 17);
+  TEST_ASSERT_EQUAL_INT(0, alert.wait(1));
+  TEST_ASSERT_EQUAL_UINT32(1, alert.counters().timeouts);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+  UNITY_BEGIN();
+  RUN_TEST(test_line_requested_for_falling_edges_with_pull_up);
+  RUN_TEST(test_edge_completes_conversion);
+  RUN_TEST(test_queued_stale_edge_is_discarded_by_arm);
+  RUN_TEST(test_late_delivered_old_edge_is_ignored);
+  RUN_TEST(test_line_seqno_gaps_count_lost_edges);
+  RUN_TEST(test_wait_times_out_without_events);
+  return UNITY_END();
+}
+
+#else
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();  // GPIO character device is Linux only
+  return UNITY_END();
+}
+
+#endif
@@ -0,0 +1,318 @@
+/// @file test_main.cpp
+/// @brief Linux i2c-dev transport against mocked open/ioctl/close
+
+#include <unity.h>
+
+#if defined(__linux__)
+
+#include <cstring>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "common/LinuxI2cTransport.h"
+
+using namespace ADS1115;
+using transport::LinuxI2cBus;
+using transport::LinuxI2cSyscalls;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+constexpr int kFd = 7;
+
+/// One recorded I2C_RDWR call
+struct Call {
+  size_t count = 0;
+  uint16_t addr[I2C_RDWR_IOCTL_MAX_MSGS] = {};
+  uint16_t flags[I2C_RDWR_IOCTL_MAX_MSGS] = {};
+  uint16_t len[I2C_RDWR_IOCTL_MAX_MSGS] = {};
+  uint8_t firstByte[I2C_RDWR_IOCTL_MAX_MSGS] = {};
+};
+
+struct Mock {
+  Call calls[16];
+  size_t callCount = 0;
+  unsigned long timeoutTicks = 0;
+  int failErrno = 0;     ///< Non-zero: next I2C_RDWR fails with this errno
+  bool openFails = false;
+  int closes = 0;
+  uint16_t readValue = 0x8583;
+};
+
+Mock mock;
+
+int mockOpen(const char* path, int flags, void* ctx) {
+  (void)flags;
+  Mock* m = static_cast<Mock*>(ctx);
+  if (m->openFails || std::strcmp(path, "/dev/i2c-1") != 0) {
+    errno = ENOENT;
+    return -1;
+  }
+  return kFd;
+}
+
+int mockIoctl(int fd, unsigned long request, void* arg, void* ctx) {
+  Mock* m = static_cast<Mock*>(ctx);
+  if (fd != kFd) {
+    errno = EBADF;
+    return -1;
+  }
+  if (request == I2C_TIMEOUT) {
+    m->timeoutTicks = reinterpret_cast<unsigned long>(arg);
+    return 0;
+  }
+  if (request != I2C_RDWR) {
+    errno = ENOTTY;
+    return -1;
+  }
+  if (m->failErrno != 0) {
+    errno = m->failErrno;
+    m->failErrno = 0;
+    return -1;
+  }
+  auto* data = static_cast<i2c_rdwr_ioctl_data*>(arg);
+  Call& call = m->calls[m->callCount < 16 ? m->callCount : 15];
+  call = Call{};
+  call.count = data->nmsgs;
+  for (size_t i = 0; i < data->nmsgs; ++i) {
+    i2c_msg& msg = data->msgs[i];
+    call.addr[i] = msg.addr;
+    call.flags[i] = msg.flags;
+    call.len[i] = msg.len;
+    if (msg.flags & I2C_M_RD) {
+      for (size_t b = 0; b < msg.len; ++b) {
+        msg.buf[b] = (b & 1U) ? static_cast<uint8_t>(m->readValue & 0xFF)
+                              : static_cast<uint8_t>(m->readValue >> 8);
+      }
+    } else if (msg.len > 0) {
+      call.firstByte[i] = msg.buf[0];
+    }
+  }
+  m->callCount++;
+  return 0;
+}
+
+int mockClose(int fd, void* ctx) {
+  (void)fd;
+  static_cast<Mock*>(ctx)->closes++;
+  return 0;
+}
+
+LinuxI2cSyscalls mockSyscalls() {
+  LinuxI2cSyscalls sys;
+  sys.open = mockOpen;
+  sys.ioctl = mockIoctl;
+  sys.close = mockClose;
+  sys.ctx = &mock;
+  return sys;
+}
+
+uint8_t txBytes[64][3];
+uint8_t rxBytes[64][2];
+
+/// @p count WRITE_READ operations (two messages each)
+void fillWriteReads(I2cOp* ops, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    txBytes[i][0] = cmd::REG_CONVERSION;
+    ops[i].type = I2cOpType::WRITE_READ;
+    ops[i].addr = 0x48;
+    ops[i].tx = txBytes[i];
+    ops[i].txLen = 1;
+    ops[i].rx = rxBytes[i];
+    ops[i].rxLen = 2;
+  }
+}
+
+} // namespace
+
+void setUp() {
+  mock = Mock{};
+  stub::nowUs = 0;
+}
+
+void tearDown() {}
+
+void test_open_timeout_and_close() {
+  LinuxI2cBus bus(mockSyscalls());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::NOT_INITIALIZED),
+                          static_cast<uint8_t>(bus.setTimeoutMs(50).code));
+  TEST_ASSERT_TRUE(bus.open(1).ok());
+  TEST_ASSERT_EQUAL_INT(kFd, bus.fd());
+  TEST_ASSERT_TRUE(bus.setTimeoutMs(45).ok());
+  TEST_ASSERT_EQUAL_UINT32(5, mock.timeoutTicks);  // 10 ms units, rounded up
+  bus.close();
+  TEST_ASSERT_EQUAL_INT(1, mock.closes);
+  TEST_ASSERT_FALSE(bus.isOpen());
+}
+
+void test_open_failure_maps_to_device_not_found() {
+  mock.openFails = true;
+  LinuxI2cBus bus(mockSyscalls());
+  Status st = bus.open(1);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::DEVICE_NOT_FOUND),
+                          static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_INT32(ENOENT, st.detail);
+}
+
+void test_register_read_is_one_combined_ioctl() {
+  LinuxI2cBus bus(mockSyscalls());
+  bus.open(1);
+  Config cfg;
+  bus.attach(cfg);
+  ADS1115::ADS1115 device;
+  TEST_ASSERT_TRUE(device.begin(cfg).ok());
+
+  mock.callCount = 0;
+  bus.resetCounters();
+  uint16_t config = 0;
+  TEST_ASSERT_TRUE(device.readConfig(config).ok());
+  TEST_ASSERT_EQUAL_HEX16(0x8583, config);
+
+  TEST_ASSERT_EQUAL_UINT32(1, mock.callCount);
+  const Call& call = mock.calls[0];
+  TEST_ASSERT_EQUAL_UINT32(2, call.count);
+  // Pointer write, then a read on the same address: repeated START, no STOP
+  TEST_ASSERT_EQUAL_UINT16(0x48, call.addr[0]);
+  TEST_ASSERT_EQUAL_UINT16(0, call.flags[0]);
+  TEST_ASSERT_EQUAL_UINT16(1, call.len[0]);
+  TEST_ASSERT_EQUAL_UINT8(cmd::REG_CONFIG, call.firstByte[0]);
+  TEST_ASSERT_EQUAL_UINT16(0x48, call.addr[1]);
+  TEST_ASSERT_EQUAL_UINT16(I2C_M_RD, call.flags[1]);
+  TEST_ASSERT_EQUAL_UINT16(2, call.len[1]);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.counters().ioctls);
+  TEST_ASSERT_EQUAL_UINT32(2, bus.counters().messages);
+}
+
+void test_config_writes_packed_into_one_ioctl() {
+  LinuxI2cBus bus(mockSyscalls());
+  bus.open(1);
+  Config cfg;
+  bus.attach(cfg);
+  ADS1115::ADS1115 device;
+  TEST_ASSERT_TRUE(device.begin(cfg).ok());
+
+  mock.callCount = 0;
+  TEST_ASSERT_TRUE(device.enableConversionReadyPin().ok());
+  TEST_ASSERT_EQUAL_UINT32(1, mock.callCount);
+  const Call& call = mock.calls[0];
+  TEST_ASSERT_EQUAL_UINT32(3, call.count);
+  TEST_ASSERT_EQUAL_UINT8(cmd::REG_LO_THRESH, call.firstByte[0]);
+  TEST_ASSERT_EQUAL_UINT8(cmd::REG_HI_THRESH, call.firstByte[1]);
+  TEST_ASSERT_EQUAL_UINT8(cmd::REG_CONFIG, call.firstByte[2]);
+  for (size_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_EQUAL_UINT16(0, call.flags[i]);
+    TEST_ASSERT_EQUAL_UINT16(3, call.len[i]);
+  }
+}
+
+void test_batch_splits_at_ioctl_message_limit() {
+  LinuxI2cBus bus(mockSyscalls());
+  bus.open(1);
+  I2cOp ops[30];
+  fillWriteReads(ops, 30);  // 60 messages
+  TEST_ASSERT_TRUE(bus.batch(ops, 30).ok());
+  TEST_ASSERT_EQUAL_UINT32(2, mock.callCount);
+  TEST_ASSERT_EQUAL_UINT32(I2C_RDWR_IOCTL_MAX_MSGS, mock.calls[0].count);
+  TEST_ASSERT_EQUAL_UINT32(60 - I2C_RDWR_IOCTL_MAX_MSGS, mock.calls[1].count);
+  TEST_ASSERT_EQUAL_UINT32(60, bus.counters().messages);
+}
+
+void test_batch_keeps_write_read_pairs_together() {
+  LinuxI2cBus bus(mockSyscalls());
+  bus.open(1);
+  I2cOp ops[22];
+  ops[0].type = I2cOpType::WRITE;
+  ops[0].addr = 0x48;
+  txBytes[0][0] = cmd::REG_CONFIG;
+  ops[0].tx = txBytes[0];
+  ops[0].txLen = 3;
+  fillWriteReads(ops + 1, 21);  // 1 + 42 messages; the last pair must not straddle
+  TEST_ASSERT_TRUE(bus.batch(ops, 22).ok());
+  TEST_ASSERT_EQUAL_UINT32(2, mock.callCount);
+  TEST_ASSERT_EQUAL_UINT32(I2C_RDWR_IOCTL_MAX_MSGS - 1, mock.calls[0].count);
+  TEST_ASSERT_EQUAL_UINT32(2, mock.calls[1].count);
+  TEST_ASSERT_EQUAL_UINT16(0, mock.calls[1].flags[0]);
+  TEST_ASSERT_EQUAL_UINT16(I2C_M_RD, mock.calls[1].flags[1]);
+}
+
+void test_batch_stops_after_failed_ioctl() {
+  LinuxI2cBus bus(mockSyscalls());
+  bus.open(1);
+  I2cOp ops[30];
+  fillWriteReads(ops, 30);
+  mock.failErrno = EREMOTEIO;
+  Status st = bus.batch(ops, 30);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::I2C_ERROR), static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT32(0, mock.callCount);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.counters().ioctls);
+  TEST_ASSERT_EQUAL_UINT32(1, bus.counters().errors);
+}
+
+void test_errno_maps_to_status() {
+  LinuxI2cBus bus(mockSyscalls());
+  uint8_t rx[2];
+  const uint8_t reg = cmd::REG_CONVERSION;
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::NOT_INITIALIZED),
+                          static_cast<uint8_t>(bus.writeRead(0x48, &reg, 1, rx, 2).code));
+  bus.open(1);
+
+  mock.failErrno = ETIMEDOUT;
+  Status st = bus.writeRead(0x48, &reg, 1, rx, 2);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::TIMEOUT), static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_INT32(ETIMEDOUT, st.detail);
+
+  mock.failErrno = ENXIO;  // address NACK on most adapters
+  st = bus.write(0x48, &reg, 1);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::I2C_ERROR), static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_INT32(ENXIO, st.detail);
+
+  TEST_ASSERT_EQUAL_UINT32(2, bus.counters().errors);
+  TEST_ASSERT_TRUE(bus.writeRead(0x48, &reg, 1, rx, 2).ok());
+}
+
+void test_driver_health_sees_ioctl_failure() {
+  LinuxI2cBus bus(mockSyscalls());
+  bus.open(1);
+  Config cfg;
+  bus.attach(cfg);
+  ADS1115::ADS1115 device;
+  TEST_ASSERT_TRUE(device.begin(cfg).ok());
+
+  mock.failErrno = EREMOTEIO;
+  uint16_t config = 0;
+  Status st = device.readConfig(config);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::I2C_ERROR), static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_INT32(EREMOTEIO, st.detail);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(DriverState::DEGRADED),
+                          static_cast<uint8_t>(device.state()));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_open_timeout_and_close);
+  RUN_TEST(test_open_failure_maps_to_device_not_found);
+  RUN_TEST(test_register_read_is_one_combined_ioctl);
+  RUN_TEST(test_config_writes_packed_into_one_ioctl);
+  RUN_TEST(test_batch_splits_at_ioctl_message_limit);
+  RUN_TEST(test_batch_keeps_write_read_pairs_together);
+  RUN_TEST(test_batch_stops_after_failed_ioctl);
+  RUN_TEST(test_errno_maps_to_status);
+  RUN_TEST(test_driver_health_sees_ioctl_failure);
+  return UNITY_END();
+}
+
+#else
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();  // i2c-dev is Linux only
+  return UNITY_END();
+}
+
+#endif
@@ -0,0 +1,170 @@
+/// @file test_main.cpp
+/// @brief SampleRing and Pipeline stage chain
+
+#include <unity.h>
+
+#include "ADS1115/Pipeline.h"
+
+using namespace ADS1115;
+
+void setUp() {}
+void tearDown() {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+Sample makeSample(uint32_t seq) {
+  Sample s;
+  s.seq = seq;
+  s.timestampUs = seq * 1000;
+  s.raw = static_cast<int16_t>(seq);
+  return s;
+}
+
+/// Keeps odd sequence numbers
+size_t keepOdd(Sample* samples, size_t count, void* ctx) {
+  (void)ctx;
+  size_t kept = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (samples[i].seq % 2) {
+      samples[kept++] = samples[i];
+    }
+  }
+  return kept;
+}
+
+struct Collector {
+  uint32_t seqs[64] = {};
+  size_t count = 0;
+};
+
+size_t collect(Sample* samples, size_t count, void* ctx) {
+  Collector* c = static_cast<Collector*>(ctx);
+  for (size_t i = 0; i < count && c->count < 64; ++i) {
+    c->seqs[c->count++] = samples[i].seq;
+  }
+  return count;
+}
+
+uint32_t fakeCycles() {
+  static uint32_t cycles = 0;
+  return cycles += 10;
+}
+
+// ============================================================================
+// SampleRing
+// ============================================================================
+
+void test_ring_fifo_order() {
+  SampleRing<8> ring;
+  for (uint32_t i = 1; i <= 5; ++i) {
+    TEST_ASSERT_TRUE(ring.push(makeSample(i)));
+  }
+  TEST_ASSERT_EQUAL(5, ring.size());
+  Sample out[8];
+  TEST_ASSERT_EQUAL(3, ring.pop(out, 3));
+  TEST_ASSERT_EQUAL_UINT32(1, out[0].seq);
+  TEST_ASSERT_EQUAL_UINT32(3, out[2].seq);
+  TEST_ASSERT_EQUAL(2, ring.pop(out, 8));
+  TEST_ASSERT_EQUAL_UINT32(4, out[0].seq);
+  TEST_ASSERT_EQUAL_UINT32(5, out[1].seq);
+  TEST_ASSERT_EQUAL(0, ring.pop(out, 8));
+}
+
+void test_ring_full_refuses_push() {
+  SampleRing<4> ring;
+  for (uint32_t i = 1; i <= 4; ++i) {
+    TEST_ASSERT_TRUE(ring.push(makeSample(i)));
+  }
+  TEST_ASSERT_FALSE(ring.push(makeSample(5)));
+  Sample out[4];
+  TEST_ASSERT_EQUAL(4, ring.pop(out, 4));
+  TEST_ASSERT_EQUAL_UINT32(4, out[3].seq);
+}
+
+void test_ring_wraps_index() {
+  SampleRing<4> ring;
+  Sample out[4];
+  for (uint32_t i = 1; i <= 100; ++i) {
+    TEST_ASSERT_TRUE(ring.push(makeSample(i)));
+    TEST_ASSERT_EQUAL(1, ring.pop(out, 4));
+    TEST_ASSERT_EQUAL_UINT32(i, out[0].seq);
+  }
+}
+
+// ============================================================================
+// Pipeline
+// ============================================================================
+
+void test_pipeline_runs_stages_in_order() {
+  Pipeline<16, 4, 4> pipeline;
+  Collector collector;
+  TEST_ASSERT_TRUE(pipeline.addStage("odd", keepOdd, nullptr).ok());
+  TEST_ASSERT_TRUE(pipeline.addStage("collect", collect, &collector).ok());
+  pipeline.setCycleCounter(fakeCycles);
+  for (uint32_t i = 1; i <= 10; ++i) {
+    TEST_ASSERT_TRUE(pipeline.push(makeSample(i)));
+  }
+  while (pipeline.process() > 0) {
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(10, pipeline.processed());
+  TEST_ASSERT_EQUAL(5, collector.count);
+  TEST_ASSERT_EQUAL_UINT32(1, collector.seqs[0]);
+  TEST_ASSERT_EQUAL_UINT32(9, collector.seqs[4]);
+
+  StageStats odd = pipeline.stageStats(0);
+  StageStats col = pipeline.stageStats(1);
+  TEST_ASSERT_EQUAL_UINT32(3, odd.calls);  // batches of 4, 4, 2
+  TEST_ASSERT_EQUAL_UINT32(10, odd.samples);
+  TEST_ASSERT_EQUAL_UINT32(5, col.samples);
+  TEST_ASSERT_EQUAL_UINT32(30, odd.cycles);
+  TEST_ASSERT_EQUAL_STRING("collect", pipeline.stageName(1));
+}
+
+void test_pipeline_rejects_too_many_stages() {
+  Pipeline<16, 2, 4> pipeline;
+  TEST_ASSERT_TRUE(pipeline.addStage("a", keepOdd, nullptr).ok());
+  TEST_ASSERT_TRUE(pipeline.addStage("b", keepOdd, nullptr).ok());
+  TEST_ASSERT_EQUAL(Err::INVALID_CONFIG, pipeline.addStage("c", keepOdd, nullptr).code);
+  TEST_ASSERT_EQUAL(Err::INVALID_PARAM, pipeline.addStage("d", nullptr, nullptr).code);
+}
+
+void test_pipeline_counts_drops_when_full() {
+  Pipeline<8, 1, 4> pipeline;
+  for (uint32_t i = 1; i <= 12; ++i) {
+    pipeline.push(makeSample(i));
+  }
+  TEST_ASSERT_EQUAL(8, pipeline.backlog());
+  TEST_ASSERT_EQUAL_UINT32(4, pipeline.dropped());
+
+  Sample block[6];
+  for (uint32_t i = 0; i < 6; ++i) {
+    block[i] = makeSample(20 + i);
+  }
+  TEST_ASSERT_EQUAL(0, pipeline.push(block, 6));
+  TEST_ASSERT_EQUAL_UINT32(10, pipeline.dropped());
+
+  pipeline.resetStats();
+  TEST_ASSERT_EQUAL_UINT32(0, pipeline.dropped());
+}
+
+void test_pipeline_onsample_adapter() {
+  Pipeline<8, 1, 4> pipeline;
+  SampleFn fn = Pipeline<8, 1, 4>::onSample;
+  fn(makeSample(7), &pipeline);
+  TEST_ASSERT_EQUAL(1, pipeline.backlog());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_ring_fifo_order);
+  RUN_TEST(test_ring_full_refuses_push);
+  RUN_TEST(test_ring_wraps_index);
+  RUN_TEST(test_pipeline_runs_stages_in_order);
+  RUN_TEST(test_pipeline_rejects_too_many_stages);
+  RUN_TEST(test_pipeline_counts_drops_when_full);
+  RUN_TEST(test_pipeline_onsample_adapter);
+  return UNITY_END();
+}
@@ -0,0 +1,108 @@
+/// @file test_main.cpp
+/// @brief Data rate planner: gain selection, noise table and budget
+
+#include <unity.h>
+
+#include "ADS1115/Planner.h"
+
+using namespace ADS1115;
+
+void setUp() {}
+void tearDown() {}
+
+void test_datasheet_noise_by_fsr_and_rate() {
+  TEST_ASSERT_EQUAL_FLOAT(187.5f, plan::datasheetNoiseUvRms(Gain::FSR_6_144V, DataRate::SPS_8));
+  TEST_ASSERT_EQUAL_FLOAT(62.5f, plan::datasheetNoiseUvRms(Gain::FSR_2_048V, DataRate::SPS_860));
+  TEST_ASSERT_EQUAL_FLOAT(7.81f, plan::datasheetNoiseUvRms(Gain::FSR_0_256V, DataRate::SPS_128));
+}
+
+void test_gain_for_input_range() {
+  Gain gain = Gain::FSR_2_048V;
+  TEST_ASSERT_TRUE(plan::gainFor(0.2f, gain));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_0_256V), static_cast<uint8_t>(gain));
+  TEST_ASSERT_TRUE(plan::gainFor(-2.048f, gain));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_2_048V), static_cast<uint8_t>(gain));
+  TEST_ASSERT_TRUE(plan::gainFor(6.144f, gain));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_6_144V), static_cast<uint8_t>(gain));
+}
+
+void test_gain_for_above_6v144_is_infeasible() {
+  Gain gain = Gain::FSR_0_256V;
+  TEST_ASSERT_FALSE(plan::gainFor(7.0f, gain));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_6_144V), static_cast<uint8_t>(gain));
+
+  ChannelRequirement req;
+  req.maxInputV = 7.0f;
+  req.bandwidthHz = 1.0f;
+  ChannelPlan out;
+  PlanBudget budget;
+  TEST_ASSERT_TRUE(planChannels(&req, 1, &out, budget).ok());
+  TEST_ASSERT_FALSE(out.feasible);
+  TEST_ASSERT_FALSE(budget.feasible);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Gain::FSR_6_144V),
+                          static_cast<uint8_t>(out.config.gain));
+}
+
+void test_plan_prefers_least_adc_time() {
+  ChannelRequirement req;
+  req.maxInputV = 2.0f;
+  req.bandwidthHz = 10.0f;
+  ChannelPlan out;
+  PlanBudget budget;
+  TEST_ASSERT_TRUE(planChannels(&req, 1, &out, budget).ok());
+  TEST_ASSERT_TRUE(out.feasible);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(DataRate::SPS_860),
+                          static_cast<uint8_t>(out.config.dataRate));
+  TEST_ASSERT_EQUAL_UINT16(1, out.oversample);
+  TEST_ASSERT_TRUE(out.bandwidthHz >= req.bandwidthHz);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 10.0f / plan::kSincBandwidth, budget.conversionsPerSec);
+}
+
+void test_noise_target_adds_oversampling() {
+  ChannelRequirement req;
+  req.maxInputV = 2.0f;
+  req.bandwidthHz = 1.0f;
+  req.noiseUvRms = 20.0f;  // 62.5 uV / sqrt(N) <= 20 needs N >= 16
+  ChannelPlan out;
+  PlanBudget budget;
+  TEST_ASSERT_TRUE(planChannels(&req, 1, &out, budget).ok());
+  TEST_ASSERT_TRUE(out.feasible);
+  TEST_ASSERT_EQUAL_UINT16(16, out.oversample);
+  TEST_ASSERT_TRUE(out.noiseUvRms <= 20.0f);
+}
+
+void test_measured_noise_overrides_datasheet() {
+  NoiseStats measured;
+  measured.gain = Gain::FSR_2_048V;
+  measured.dataRate = DataRate::SPS_860;
+  measured.samples = 256;
+  measured.rmsUv = 250.0f;
+  PlannerOptions opt;
+  opt.measured = &measured;
+  opt.measuredCount = 1;
+  TEST_ASSERT_EQUAL_FLOAT(250.0f, plan::noiseUvRms(Gain::FSR_2_048V, DataRate::SPS_860, opt));
+  TEST_ASSERT_EQUAL_FLOAT(62.5f, plan::noiseUvRms(Gain::FSR_2_048V, DataRate::SPS_475, opt));
+}
+
+void test_invalid_requests() {
+  ChannelRequirement req;
+  req.bandwidthHz = 0.0f;
+  ChannelPlan out;
+  PlanBudget budget;
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::INVALID_PARAM),
+                          static_cast<uint8_t>(planChannels(&req, 1, &out, budget).code));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::INVALID_PARAM),
+                          static_cast<uint8_t>(planChannels(nullptr, 1, &out, budget).code));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_datasheet_noise_by_fsr_and_rate);
+  RUN_TEST(test_gain_for_input_range);
+  RUN_TEST(test_gain_for_above_6v144_is_infeasible);
+  RUN_TEST(test_plan_prefers_least_adc_time);
+  RUN_TEST(test_noise_target_adds_oversampling);
+  RUN_TEST(test_measured_noise_overrides_datasheet);
+  RUN_TEST(test_invalid_requests);
+  return UNITY_END();
+}
@@ -0,0 +1,253 @@
+/// @file test_main.cpp
+/// @brief EDF scheduler ordering, timeouts and errors against the simulator
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/Scheduler.h"
+#include "sim/Ads1115Sim.h"
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+
+constexpr ChannelConfig kFast{Mux::AIN0_GND, Gain::FSR_2_048V, DataRate::SPS_860};
+constexpr ChannelConfig kSlow{Mux::AIN1_GND, Gain::FSR_4_096V, DataRate::SPS_128};
+
+size_t order[16];
+size_t orderCount = 0;
+void record(size_t channel, const Sample& sample, void* user) {
+  (void)sample;
+  (void)user;
+  if (orderCount < 16) {
+    order[orderCount++] = channel;
+  }
+}
+
+bool failReads = false;
+Status flakyWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen, uint8_t* rxData,
+                      size_t rxLen, uint32_t timeoutMs, void* user) {
+  if (failReads && txLen == 1 && txData[0] == cmd::REG_CONVERSION) {
+    return Status::Error(Err::I2C_ERROR, "Injected read failure", 5);
+  }
+  return sim::i2cWriteRead(addr, txData, txLen, rxData, rxLen, timeoutMs, user);
+}
+
+bool alertNever(int pin, void* user) {
+  (void)pin;
+  (void)user;
+  return true;  // active low: never asserted
+}
+
+/// Poll every 100 us of virtual time until @p untilUs; returns the last error
+template <size_t N>
+Status run(EdfScheduler<N>& sched, uint32_t untilUs) {
+  Status last = Status::Ok();
+  while (static_cast<int32_t>(stub::nowUs - untilUs) < 0) {
+    Status st = sched.poll(device, micros());
+    if (!st.ok()) {
+      last = st;
+    }
+    stub::nowUs += 100;
+  }
+  return last;
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 0;
+  simDevice.reset();
+  simDevice.setInput(0, 1.0f);
+  simDevice.setInput(1, 2.0f);
+  failReads = false;
+  orderCount = 0;
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  config.i2cWriteRead = flakyWriteRead;
+  device.begin(config);
+}
+
+void tearDown() {}
+
+void test_earliest_deadline_runs_first() {
+  EdfScheduler<4> sched;
+  sched.addChannel(kSlow, 100000);          // deadline 100 ms
+  sched.addChannel(kFast, 100000, 20000);   // deadline 20 ms
+  sched.addChannel(kFast, 100000, 50000);   // deadline 50 ms
+  sched.setOnSample(record, nullptr);
+  sched.start(micros());
+  TEST_ASSERT_TRUE(run(sched, 60000).ok());
+
+  TEST_ASSERT_EQUAL_UINT32(3, orderCount);
+  TEST_ASSERT_EQUAL_UINT32(1, order[0]);
+  TEST_ASSERT_EQUAL_UINT32(2, order[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, order[2]);
+  for (size_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(i).completed);
+    TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(i).misses);
+  }
+}
+
+void test_periodic_release_and_miss_accounting() {
+  EdfScheduler<2> sched;
+  sched.addChannel(kFast, 10000);
+  sched.addChannel(kSlow, 30000, 1000);  // 7.8 ms conversion, 1 ms deadline
+  sched.start(micros());
+  TEST_ASSERT_TRUE(run(sched, 100000).ok());
+
+  ChannelSchedStats fast = sched.channelStats(0);
+  ChannelSchedStats slow = sched.channelStats(1);
+  TEST_ASSERT_EQUAL_UINT32(10, fast.released);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(9, fast.completed);
+  TEST_ASSERT_EQUAL_UINT32(4, slow.released);
+  TEST_ASSERT_EQUAL_UINT32(slow.completed, slow.misses);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, slow.maxLatenessUs);
+  SchedulerStats st = sched.stats(micros());
+  TEST_ASSERT_EQUAL_UINT32(0, st.errors);
+  TEST_ASSERT_TRUE(st.measuredUtilization > 0.5f);
+}
+
+void test_stuck_conversion_times_out() {
+  config.alertRdyPin = 4;
+  config.gpioRead = alertNever;
+  device.begin(config);
+  TEST_ASSERT_TRUE(device.enableConversionReadyPin().ok());
+
+  EdfScheduler<1> sched;
+  sched.addChannel(kFast, 50000);
+  sched.start(micros());
+  TEST_ASSERT_TRUE(sched.poll(device, micros()).ok());  // starts the job
+
+  // 1163 us + 1/8 + 10 ms margin: still waiting at 11 ms
+  stub::nowUs += 11000;
+  TEST_ASSERT_TRUE(sched.poll(device, micros()).ok());
+  stub::nowUs += 1000;
+  Status st = sched.poll(device, micros());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::TIMEOUT), static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(0).timeouts);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats(micros()).errors);
+
+  // The driver no longer holds the abandoned conversion: the next release starts
+  stub::nowUs += 50000;
+  TEST_ASSERT_TRUE(sched.poll(device, micros()).ok());
+  TEST_ASSERT_EQUAL_UINT32(2, sched.channelStats(0).released);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats(micros()).errors);
+}
+
+void test_timeout_margin_is_configurable() {
+  config.alertRdyPin = 4;
+  config.gpioRead = alertNever;
+  device.begin(config);
+  TEST_ASSERT_TRUE(device.enableConversionReadyPin().ok());
+
+  EdfScheduler<1> sched;
+  sched.addChannel(kFast, 50000);
+  sched.setTimeoutMarginUs(0);
+  sched.start(micros());
+  sched.poll(device, micros());
+  stub::nowUs += 1400;
+  Status st = sched.poll(device, micros());
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::TIMEOUT), static_cast<uint8_t>(st.code));
+}
+
+void test_read_failure_counts_error_and_moves_on() {
+  EdfScheduler<2> sched;
+  sched.addChannel(kFast, 100000, 10000);
+  sched.addChannel(kFast, 100000, 20000);
+  sched.setOnSample(record, nullptr);
+  sched.start(micros());
+
+  failReads = true;
+  Status st = run(sched, 5000);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::I2C_ERROR), static_cast<uint8_t>(st.code));
+  failReads = false;
+  TEST_ASSERT_TRUE(run(sched, 20000).ok());
+
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats(micros()).errors);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(0).completed);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(1).completed);
+  TEST_ASSERT_EQUAL_UINT32(1, orderCount);
+  TEST_ASSERT_EQUAL_UINT32(1, order[0]);
+}
+
+void test_critical_job_preempts_long_conversion() {
+  config.allowGeneralCallReset = true;
+  config.compThresholdLow = -1000;
+  config.compThresholdHigh = 1000;
+  device.begin(config);
+
+  EdfScheduler<2> sched;
+  sched.addChannel(kSlow, 100000);               // ~10 ms per conversion
+  sched.addChannel(kFast, 5000, 4000, true);     // critical; ~3 ms with the ready gate
+  sched.setPreemption(true);
+  sched.setOnSample(record, nullptr);
+  sched.start(micros());
+  TEST_ASSERT_TRUE(run(sched, 10000).ok());
+
+  // Critical job first (earlier deadline), slow started, then aborted at 5 ms
+  SchedulerStats st = sched.stats(micros());
+  TEST_ASSERT_EQUAL_UINT32(1, st.preemptions);
+  TEST_ASSERT_EQUAL_UINT32(0, st.errors);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(0).preempted);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(0).completed);
+  TEST_ASSERT_EQUAL_UINT32(2, sched.channelStats(1).completed);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(1).misses);
+  // The general-call reset cleared the thresholds; preemptConversion restored them
+  TEST_ASSERT_EQUAL_HEX16(static_cast<uint16_t>(-1000), simDevice.reg(cmd::REG_LO_THRESH));
+  TEST_ASSERT_EQUAL_HEX16(1000, simDevice.reg(cmd::REG_HI_THRESH));
+}
+
+void test_no_preemption_when_waiting_meets_deadline() {
+  config.allowGeneralCallReset = true;
+  device.begin(config);
+
+  EdfScheduler<2> sched;
+  sched.addChannel(kSlow, 100000);
+  sched.addChannel(kFast, 5000, 15000, true);  // released mid-conversion, loose deadline
+  sched.setPreemption(true);
+  sched.start(micros());
+  TEST_ASSERT_TRUE(run(sched, 30000).ok());
+
+  TEST_ASSERT_EQUAL_UINT32(0, sched.stats(micros()).preemptions);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.channelStats(0).completed);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(1).misses);
+}
+
+void test_preemption_needs_general_call_reset() {
+  EdfScheduler<2> sched;
+  sched.addChannel(kSlow, 100000);
+  sched.addChannel(kFast, 5000, 2500, true);
+  sched.setPreemption(true);
+  sched.start(micros());
+  Status st = run(sched, 7000);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Err::BUSY), static_cast<uint8_t>(st.code));
+  TEST_ASSERT_EQUAL_UINT32(0, sched.stats(micros()).preemptions);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, sched.stats(micros()).errors);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.channelStats(0).preempted);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+  UNITY_BEGIN();
+  RUN_TEST(test_earliest_deadline_runs_first);
+  RUN_TEST(test_periodic_release_and_miss_accounting);
+  RUN_TEST(test_stuck_conversion_times_out);
+  RUN_TEST(test_timeout_margin_is_configurable);
+  RUN_TEST(test_read_failure_counts_error_and_moves_on);
+  RUN_TEST(test_critical_job_preempts_long_conversion);
+  RUN_TEST(test_no_preemption_when_waiting_meets_deadline);
+  RUN_TEST(test_preemption_needs_general_call_reset);
+  return UNITY_END();
+}
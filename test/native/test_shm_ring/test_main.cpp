@@ -0,0 +1,193 @@
+/// @file test_main.cpp
+/// @brief POSIX shared-memory sample ring: ordering, loss, wakeup and consumer reaping
+
+#include <unity.h>
+
+#if defined(__linux__)
+
+#include <sys/wait.h>
+
+#include <cstdio>
+#include <thread>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "common/LinuxShmRing.h"
+
+using namespace ADS1115;
+using transport::ShmSampleReader;
+using transport::ShmSampleWriter;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+char ringName[48];
+ShmSampleWriter writer;
+
+Sample sampleFor(uint32_t k) {
+  Sample s;
+  s.timestampUs = 1000 * k;
+  s.seq = k;
+  s.raw = static_cast<int16_t>(k * 3 - 100);
+  s.mux = Mux::AIN2_GND;
+  s.gain = Gain::FSR_1_024V;
+  s.flags = static_cast<uint8_t>(k & SampleFlag::GAP);
+  return s;
+}
+
+void publishRange(uint32_t first, uint32_t count) {
+  for (uint32_t k = first; k < first + count; ++k) {
+    writer.publish(sampleFor(k));
+  }
+}
+
+uint32_t elapsedMs(const timespec& since) {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint32_t>((now.tv_sec - since.tv_sec) * 1000 +
+                               (now.tv_nsec - since.tv_nsec) / 1000000);
+}
+
+} // namespace
+
+void setUp() {
+  TEST_ASSERT_TRUE(writer.create(ringName, 8).ok());
+}
+
+void tearDown() { writer.close(); }
+
+void test_publish_then_read_in_order() {
+  ShmSampleReader reader;
+  TEST_ASSERT_TRUE(reader.open(ringName).ok());
+  publishRange(0, 5);
+  TEST_ASSERT_TRUE(reader.available() == 5);
+
+  Sample batch[16];
+  TEST_ASSERT_EQUAL(5, reader.read(batch, 16));
+  for (uint32_t k = 0; k < 5; ++k) {
+    const Sample expect = sampleFor(k);
+    TEST_ASSERT_EQUAL_UINT32(expect.seq, batch[k].seq);
+    TEST_ASSERT_EQUAL_UINT32(expect.timestampUs, batch[k].timestampUs);
+    TEST_ASSERT_EQUAL_INT16(expect.raw, batch[k].raw);
+    TEST_ASSERT_EQUAL(expect.mux, batch[k].mux);
+    TEST_ASSERT_EQUAL(expect.gain, batch[k].gain);
+    TEST_ASSERT_EQUAL_UINT8(expect.flags, batch[k].flags);
+  }
+  TEST_ASSERT_TRUE(reader.available() == 0);
+  TEST_ASSERT_EQUAL(0, reader.read(batch, 16));
+  TEST_ASSERT_TRUE(reader.lost() == 0);
+}
+
+void test_lapped_reader_counts_lost() {
+  ShmSampleReader reader;
+  TEST_ASSERT_TRUE(reader.open(ringName).ok());
+  publishRange(0, 20);  // Capacity 8: the oldest 12 are overwritten
+
+  Sample batch[16];
+  TEST_ASSERT_EQUAL(8, reader.read(batch, 16));
+  TEST_ASSERT_EQUAL_UINT32(12, batch[0].seq);
+  TEST_ASSERT_EQUAL_UINT32(19, batch[7].seq);
+  TEST_ASSERT_TRUE(reader.lost() == 12);
+}
+
+void test_open_from_oldest_retained_sample() {
+  publishRange(0, 10);
+  ShmSampleReader reader;
+  TEST_ASSERT_TRUE(reader.open(ringName, true).ok());
+  Sample batch[16];
+  TEST_ASSERT_EQUAL(8, reader.read(batch, 16));
+  TEST_ASSERT_EQUAL_UINT32(2, batch[0].seq);
+  TEST_ASSERT_TRUE(reader.lost() == 0);
+}
+
+void test_wait_times_out_without_samples() {
+  ShmSampleReader reader;
+  TEST_ASSERT_TRUE(reader.open(ringName).ok());
+  timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  TEST_ASSERT_FALSE(reader.wait(30));
+  TEST_ASSERT_TRUE(elapsedMs(start) >= 25);
+}
+
+void test_wait_wakes_on_publish() {
+  ShmSampleReader reader;
+  TEST_ASSERT_TRUE(reader.open(ringName).ok());
+  timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  std::thread publisher([]() {
+    usleep(20000);
+    writer.publish(sampleFor(1));
+  });
+  TEST_ASSERT_TRUE(reader.wait(5000));
+  publisher.join();
+  TEST_ASSERT_TRUE(elapsedMs(start) < 2000);
+  Sample s;
+  TEST_ASSERT_EQUAL(1, reader.read(&s, 1));
+  TEST_ASSERT_EQUAL_UINT32(1, s.seq);
+}
+
+void test_writer_close_is_visible_to_reader() {
+  ShmSampleReader reader;
+  TEST_ASSERT_TRUE(reader.open(ringName).ok());
+  TEST_ASSERT_TRUE(reader.writerAlive());
+  writer.close();
+  TEST_ASSERT_FALSE(reader.writerAlive());
+  TEST_ASSERT_FALSE(reader.wait(1000));  // Returns at once: nothing will be published
+
+  ShmSampleReader late;
+  TEST_ASSERT_EQUAL(Err::DEVICE_NOT_FOUND, late.open(ringName).code);
+}
+
+void test_reap_frees_dead_consumer_cursor() {
+  ShmSampleReader reader;
+  TEST_ASSERT_TRUE(reader.open(ringName).ok());  // Slot 0, this process
+
+  pid_t child = fork();
+  if (child == 0) {
+    // Claim slot 1 and exit without releasing it
+    ShmSampleReader orphan;
+    _exit(orphan.open(ringName).ok() ? 0 : 1);
+  }
+  TEST_ASSERT_TRUE(child > 0);
+  int status = 0;
+  TEST_ASSERT_EQUAL(child, waitpid(child, &status, 0));
+  TEST_ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  publishRange(0, 3);
+  TEST_ASSERT_TRUE(writer.consumerLag(0) == 3);
+  TEST_ASSERT_TRUE(writer.consumerLag(1) == 3);  // Dead reader still holds its cursor
+
+  TEST_ASSERT_EQUAL(1, writer.reapConsumers());
+  TEST_ASSERT_TRUE(writer.consumerLag(1) == 0);  // Slot free again
+  TEST_ASSERT_TRUE(writer.consumerLag(0) == 3);  // Live reader untouched
+  TEST_ASSERT_EQUAL(0, writer.reapConsumers());
+}
+
+int main() {
+  std::snprintf(ringName, sizeof(ringName), "/ads1115_test_%d", static_cast<int>(getpid()));
+
+  UNITY_BEGIN();
+  RUN_TEST(test_publish_then_read_in_order);
+  RUN_TEST(test_lapped_reader_counts_lost);
+  RUN_TEST(test_open_from_oldest_retained_sample);
+  RUN_TEST(test_wait_times_out_without_samples);
+  RUN_TEST(test_wait_wakes_on_publish);
+  RUN_TEST(test_writer_close_is_visible_to_reader);
+  RUN_TEST(test_reap_frees_dead_consumer_cursor);
+  return UNITY_END();
+}
+
+#else
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+  UNITY_BEGIN();  // POSIX shared memory and futex are Linux only
+  return UNITY_END();
+}
+
+#endif
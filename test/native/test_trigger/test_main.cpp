@@ -0,0 +1,142 @@
+/// @file test_main.cpp
+/// @brief Triggered capture with a pre-trigger buffer
+
+#include <unity.h>
+
+#include "ADS1115/TriggerCapture.h"
+
+using namespace ADS1115;
+
+void setUp() {}
+void tearDown() {}
+
+Sample makeSample(int16_t raw, uint32_t seq) {
+  Sample s;
+  s.raw = raw;
+  s.seq = seq;
+  s.timestampUs = seq * 1000;
+  return s;
+}
+
+void test_rising_level_pre_and_post_counts() {
+  TriggerCapture<8> scope;
+  TriggerConfig trig;
+  trig.mode = TriggerMode::RISING_LEVEL;
+  trig.level = 100;
+  trig.postSamples = 2;
+  scope.arm(trig);
+
+  const int16_t stream[] = {0, 10, 20, 30, 40, 50, 150, 160, 170, 180};
+  uint32_t seq = 0;
+  for (int16_t raw : stream) {
+    scope.feed(makeSample(raw, seq++));
+  }
+
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(CaptureState::FROZEN),
+                          static_cast<uint8_t>(scope.state()));
+  TEST_ASSERT_EQUAL_UINT16(5, scope.info().preSamples);
+  TEST_ASSERT_EQUAL_UINT16(2, scope.info().postSamples);
+  TEST_ASSERT_EQUAL_UINT32(6, scope.info().triggerSeq);
+  TEST_ASSERT_EQUAL_UINT32(8, scope.size());
+  TEST_ASSERT_EQUAL_INT16(10, scope.at(0));
+  TEST_ASSERT_EQUAL_INT16(150, scope.at(scope.info().preSamples));
+  TEST_ASSERT_EQUAL_INT16(170, scope.at(7));
+}
+
+void test_pre_samples_limited_by_fill() {
+  TriggerCapture<16> scope;
+  TriggerConfig trig;
+  trig.mode = TriggerMode::RISING_LEVEL;
+  trig.level = 100;
+  trig.postSamples = 3;
+  scope.arm(trig);
+
+  scope.feed(makeSample(0, 0));
+  scope.feed(makeSample(200, 1));
+  for (uint32_t seq = 2; seq < 5; ++seq) {
+    scope.feed(makeSample(200, seq));
+  }
+
+  TEST_ASSERT_EQUAL_UINT16(1, scope.info().preSamples);
+  TEST_ASSERT_EQUAL_UINT16(3, scope.info().postSamples);
+  TEST_ASSERT_EQUAL_UINT32(5, scope.size());
+}
+
+void test_post_samples_clamped_to_capacity() {
+  TriggerCapture<4> scope;
+  TriggerConfig trig;
+  trig.mode = TriggerMode::WINDOW;
+  trig.low = -10;
+  trig.high = 10;
+  trig.postSamples = 100;
+  scope.arm(trig);
+
+  scope.feed(makeSample(50, 0));
+  for (uint32_t seq = 1; seq < 4; ++seq) {
+    scope.feed(makeSample(0, seq));
+  }
+
+  TEST_ASSERT_EQUAL_UINT16(0, scope.info().preSamples);
+  TEST_ASSERT_EQUAL_UINT16(3, scope.info().postSamples);
+  TEST_ASSERT_EQUAL_UINT32(4, scope.size());
+}
+
+void test_gaps_counted() {
+  TriggerCapture<8> scope;
+  TriggerConfig trig;
+  trig.mode = TriggerMode::EXTERNAL;
+  scope.arm(trig);
+
+  scope.feed(makeSample(0, 0));
+  scope.feed(makeSample(0, 3));
+  scope.trigger();
+  scope.feed(makeSample(0, 4));
+
+  TEST_ASSERT_EQUAL_UINT16(1, scope.info().gaps);
+  TEST_ASSERT_EQUAL_UINT32(4, scope.info().triggerSeq);
+}
+
+void test_forced_trigger_cleared_by_arm() {
+  TriggerCapture<8> scope;
+  TriggerConfig trig;
+  trig.mode = TriggerMode::EXTERNAL;
+  scope.arm(trig);
+  scope.disarm();
+  scope.trigger();  // lands while idle; must not fire the next capture
+  scope.arm(trig);
+
+  scope.feed(makeSample(0, 0));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(CaptureState::ARMED),
+                          static_cast<uint8_t>(scope.state()));
+
+  scope.trigger();
+  scope.feed(makeSample(0, 1));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(CaptureState::FROZEN),
+                          static_cast<uint8_t>(scope.state()));
+  TEST_ASSERT_EQUAL_UINT32(1, scope.info().triggerSeq);
+}
+
+void test_forced_trigger_cleared_by_disarm() {
+  TriggerCapture<8> scope;
+  TriggerConfig trig;
+  trig.mode = TriggerMode::EXTERNAL;
+  scope.arm(trig);
+  scope.trigger();
+  scope.disarm();
+  scope.arm(trig);
+
+  scope.feed(makeSample(0, 0));
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(CaptureState::ARMED),
+                          static_cast<uint8_t>(scope.state()));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_rising_level_pre_and_post_counts);
+  RUN_TEST(test_pre_samples_limited_by_fill);
+  RUN_TEST(test_post_samples_clamped_to_capacity);
+  RUN_TEST(test_gaps_counted);
+  RUN_TEST(test_forced_trigger_cleared_by_arm);
+  RUN_TEST(test_forced_trigger_cleared_by_disarm);
+  return UNITY_END();
+}
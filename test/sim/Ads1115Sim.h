@@ -0,0 +1,551 @@
+/// @file Ads1115Sim.h
+/// @brief In-memory ADS1115 register model and I2C transport for native builds
+/// @note NOT part of the library - native tests and benchmarks only
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/CommandTable.h"
+#include "ADS1115/Config.h"
+#include "ADS1115/Status.h"
+
+namespace sim {
+
+using ADS1115::Err;
+using ADS1115::Status;
+
+/// One conversion window reported to a Device observer
+struct ConversionInfo {
+  uint8_t addr = 0;         ///< Device address
+  uint8_t mux = 0;          ///< MUX field of the config register
+  bool continuous = false;  ///< Part of a continuous-mode stream
+  uint64_t startUs = 0;     ///< Virtual time the conversion started
+  uint32_t durationUs = 0;  ///< Nominal conversion period
+};
+
+/// Called for every conversion window (single-shot: when started;
+/// continuous: as elapsed periods are observed on the next bus access)
+using ConversionFn = void (*)(const ConversionInfo& info, void* user);
+
+/// Simulated ADS1115 device (register file + conversion timing)
+class Device {
+public:
+  explicit Device(uint8_t address = 0x48) : _address(address) { reset(); }
+
+  /// Restore power-on register values
+  void reset() {
+    _regs[ADS1115::cmd::REG_CONVERSION] = ADS1115::cmd::CONVERSION_DEFAULT;
+    _regs[ADS1115::cmd::REG_CONFIG] = ADS1115::cmd::CONFIG_DEFAULT;
+    _regs[ADS1115::cmd::REG_LO_THRESH] = ADS1115::cmd::LO_THRESH_DEFAULT;
+    _regs[ADS1115::cmd::REG_HI_THRESH] = ADS1115::cmd::HI_THRESH_DEFAULT;
+    _pointer = ADS1115::cmd::REG_CONVERSION;
+    _busy = false;
+    _continuous = false;
+  }
+
+  uint8_t address() const { return _address; }
+
+  /// Report conversion windows to @p fn (nullptr to stop)
+  void setObserver(ConversionFn fn, void* user) {
+    _observer = fn;
+    _observerUser = user;
+  }
+
+  /// Set the voltage applied to AIN0..AIN3 (relative to GND)
+  void setInput(uint8_t pin, float volts) {
+    if (pin < 4) {
+      _ain[pin] = volts;
+    }
+  }
+
+  /// Internal oscillator error in ppm (datasheet: up to +/-10%); positive
+  /// values lengthen the conversion period
+  void setClockErrorPpm(int32_t ppm) { _clockErrorPpm = ppm; }
+
+  uint16_t reg(uint8_t index) const { return _regs[index & 0x03]; }
+
+  /// Virtual time the conversion register was last updated
+  uint64_t resultUs() const { return _resultUs; }
+
+  /// True once a single-shot conversion has finished (ALERT/RDY in
+  /// conversion-ready mode asserts at this point)
+  bool conversionDone(uint64_t nowUs) {
+    _update(nowUs);
+    return !_busy;
+  }
+  uint8_t pointer() const { return _pointer; }
+
+  /// Handle an I2C write (pointer byte, optionally followed by 16-bit data)
+  bool write(const uint8_t* data, size_t len, uint64_t nowUs) {
+    if (len == 0) {
+      return true;
+    }
+    _update(nowUs);
+    _pointer = data[0] & 0x03;
+    if (len == 1) {
+      return true;
+    }
+    if (len != 3) {
+      return false;
+    }
+    uint16_t value = static_cast<uint16_t>((data[1] << 8) | data[2]);
+    if (_pointer == ADS1115::cmd::REG_CONVERSION) {
+      return true;
+    }
+    if (_pointer == ADS1115::cmd::REG_CONFIG) {
+      _writeConfig(value, nowUs);
+      return true;
+    }
+    _regs[_pointer] = value;
+    return true;
+  }
+
+  /// Handle an I2C read from the current pointer register
+  bool read(uint8_t* data, size_t len, uint64_t nowUs) {
+    _update(nowUs);
+    uint16_t value = _regs[_pointer];
+    if (_pointer == ADS1115::cmd::REG_CONFIG) {
+      value = static_cast<uint16_t>(value & ~ADS1115::cmd::MASK_OS);
+      if (!_busy) {
+        value |= ADS1115::cmd::OS_IDLE;
+      }
+    }
+    for (size_t i = 0; i < len; ++i) {
+      data[i] = (i & 1U) ? static_cast<uint8_t>(value & 0xFF)
+                         : static_cast<uint8_t>(value >> 8);
+    }
+    return true;
+  }
+
+private:
+  void _writeConfig(uint16_t value, uint64_t nowUs) {
+    _regs[ADS1115::cmd::REG_CONFIG] = static_cast<uint16_t>(value & ~ADS1115::cmd::MASK_OS);
+    bool singleShot = (value & ADS1115::cmd::MASK_MODE) == ADS1115::cmd::MODE_SINGLE_SHOT;
+    if (!singleShot) {
+      if (!_continuous) {
+        _continuous = true;
+        _periodStartUs = nowUs;
+      }
+      _busy = true;
+      return;
+    }
+    _continuous = false;
+    if (!_busy && (value & ADS1115::cmd::MASK_OS) == ADS1115::cmd::OS_START) {
+      _busy = true;
+      _periodStartUs = nowUs;
+      _report(nowUs, false);
+    }
+  }
+
+  void _report(uint64_t startUs, bool continuous) {
+    if (_observer == nullptr) {
+      return;
+    }
+    ConversionInfo info;
+    info.addr = _address;
+    info.mux = static_cast<uint8_t>(
+        (_regs[ADS1115::cmd::REG_CONFIG] & ADS1115::cmd::MASK_MUX) >> ADS1115::cmd::BIT_MUX);
+    info.continuous = continuous;
+    info.startUs = startUs;
+    info.durationUs = _periodUs();
+    _observer(info, _observerUser);
+  }
+
+  void _update(uint64_t nowUs) {
+    if (!_busy) {
+      return;
+    }
+    uint32_t periodUs = _periodUs();
+    if (nowUs - _periodStartUs < periodUs) {
+      return;
+    }
+    _regs[ADS1115::cmd::REG_CONVERSION] = static_cast<uint16_t>(_sample());
+    _resultUs = _periodStartUs +
+                (_continuous ? ((nowUs - _periodStartUs) / periodUs) * periodUs : periodUs);
+    if (_continuous) {
+      uint64_t periods = (nowUs - _periodStartUs) / periodUs;
+      if (_observer != nullptr) {
+        // Only the most recent windows; an idle gap can span millions
+        uint64_t first = periods > kMaxReportedPeriods ? periods - kMaxReportedPeriods : 0;
+        for (uint64_t i = first; i < periods; ++i) {
+          _report(_periodStartUs + i * periodUs, true);
+        }
+      }
+      _periodStartUs += periods * periodUs;
+    } else {
+      _busy = false;
+    }
+  }
+
+  uint32_t _periodUs() const {
+    uint16_t config = _regs[ADS1115::cmd::REG_CONFIG];
+    uint32_t nominalUs = ADS1115::cmd::conversionUs(
+        static_cast<uint8_t>((config & ADS1115::cmd::MASK_DR) >> ADS1115::cmd::BIT_DR));
+    return static_cast<uint32_t>(static_cast<int64_t>(nominalUs) * (1000000 + _clockErrorPpm) /
+                                 1000000);
+  }
+
+  int16_t _sample() const {
+    static constexpr uint8_t kPos[] = {0, 0, 1, 2, 0, 1, 2, 3};
+    static constexpr int8_t kNeg[] = {1, 3, 3, 3, -1, -1, -1, -1};
+    uint16_t config = _regs[ADS1115::cmd::REG_CONFIG];
+    uint8_t mux = static_cast<uint8_t>((config & ADS1115::cmd::MASK_MUX) >> ADS1115::cmd::BIT_MUX);
+    uint8_t pga = static_cast<uint8_t>((config & ADS1115::cmd::MASK_PGA) >> ADS1115::cmd::BIT_PGA);
+    float volts = _ain[kPos[mux]] - (kNeg[mux] >= 0 ? _ain[kNeg[mux]] : 0.0f);
+    float code = volts / ADS1115::cmd::lsbVolts(pga);
+    if (code >= 32767.0f) {
+      return 32767;
+    }
+    if (code <= -32768.0f) {
+      return -32768;
+    }
+    return static_cast<int16_t>(code < 0.0f ? code - 0.5f : code + 0.5f);
+  }
+
+  static constexpr uint64_t kMaxReportedPeriods = 64;
+
+  uint8_t _address;
+  uint16_t _regs[4] = {};
+  uint8_t _pointer = 0;
+  bool _busy = false;
+  bool _continuous = false;
+  uint64_t _periodStartUs = 0;
+  uint64_t _resultUs = 0;
+  float _ain[4] = {};
+  int32_t _clockErrorPpm = 0;
+  ConversionFn _observer = nullptr;
+  void* _observerUser = nullptr;
+};
+
+/// Transaction counters for a simulated bus
+struct BusCounters {
+  uint32_t writes = 0;      ///< Write-only transactions
+  uint32_t writeReads = 0;  ///< Write-then-read transactions
+  uint32_t reads = 0;       ///< Read-only transactions
+  uint32_t bytesTx = 0;     ///< Data bytes written (excluding address)
+  uint32_t bytesRx = 0;     ///< Data bytes read (excluding address)
+  uint32_t nacks = 0;       ///< Transactions to an absent address
+  uint32_t batches = 0;     ///< Batched operation lists (their ops are counted above)
+  uint64_t busyNs = 0;      ///< Accumulated wire time (bus occupancy)
+
+  uint32_t transactions() const { return writes + writeReads + reads; }
+};
+
+/// One bus transaction reported to a Bus observer
+struct TransactionInfo {
+  ADS1115::I2cOpType type = ADS1115::I2cOpType::WRITE;
+  uint8_t addr = 0;
+  const uint8_t* tx = nullptr;  ///< Write phase data (valid during the callback)
+  size_t txLen = 0;
+  const uint8_t* rx = nullptr;  ///< Read phase data (valid during the callback)
+  size_t rxLen = 0;
+  uint64_t startNs = 0;         ///< Virtual time the START went out
+  uint64_t durationNs = 0;      ///< Wire time including bus-free time
+  bool batched = false;         ///< Issued from Bus::batch()
+  Err err = Err::OK;
+};
+
+/// Called after every transaction on a Bus
+using TransactionFn = void (*)(const TransactionInfo& info, void* user);
+
+/// Electrical timing used to convert transactions into wire time
+struct WireTiming {
+  uint32_t sclHz = 400000;        ///< SCL frequency (100k, 400k, 1M or 3.4M)
+  uint32_t stretchNsPerByte = 0;  ///< Clock stretching added after each byte
+  bool advanceClock = true;       ///< Advance stub::nowUs by each transaction
+};
+
+/// Bus-free time (tBUF) after a STOP for the speed class of @p timing
+inline uint64_t busFreeNs(const WireTiming& timing) {
+  if (timing.sclHz > 400000) {
+    return 500;   // Fast mode plus / high speed
+  }
+  if (timing.sclHz > 100000) {
+    return 1300;  // Fast mode
+  }
+  return 4700;    // Standard mode
+}
+
+/// Wire time of one transaction in nanoseconds
+/// @param timing   Bus speed and clock stretching
+/// @param txLen    Data bytes in the write phase
+/// @param rxLen    Data bytes in the read phase
+/// @param hasWrite Transaction has a write phase (address + txLen bytes)
+/// @param hasRead  Transaction has a read phase (address + rxLen bytes)
+/// @note START, repeated START and STOP each cost one SCL period and every
+///       byte costs 9 clocks (8 data + ACK). The speed class bus-free time
+///       (tBUF) follows the STOP. High-speed mode (> 1 MHz) adds the master
+///       code at 400 kHz.
+inline uint64_t transactionWireNs(const WireTiming& timing, size_t txLen, size_t rxLen,
+                                  bool hasWrite, bool hasRead) {
+  const uint32_t sclHz = timing.sclHz > 0 ? timing.sclHz : 100000;
+  const uint64_t bitNs = 1000000000ULL / sclHz;
+
+  uint64_t ns = bitNs + busFreeNs(timing);  // START ... STOP + bus free
+  if (sclHz > 1000000) {
+    // Master code (8 bits + NACK) sent at fast-mode speed, then Sr
+    ns += bitNs + 9ULL * (1000000000ULL / 400000);
+  }
+  uint64_t bytes = 0;
+  if (hasWrite) {
+    bytes += 1 + txLen;
+  }
+  if (hasRead) {
+    if (hasWrite) {
+      ns += bitNs;  // Repeated START
+    }
+    bytes += 1 + rxLen;
+  }
+  ns += bitNs;  // STOP
+  ns += bytes * (9 * bitNs + timing.stretchNsPerByte);
+  return ns;
+}
+
+/// Simulated I2C bus with up to kMaxDevices ADS1115 devices attached
+class Bus {
+public:
+  static constexpr size_t kMaxDevices = 4;
+
+  /// Attach a device; returns false if the bus is full
+  bool attach(Device* device) {
+    if (_deviceCount >= kMaxDevices) {
+      return false;
+    }
+    _devices[_deviceCount++] = device;
+    return true;
+  }
+
+  size_t deviceCount() const { return _deviceCount; }
+  Device* device(size_t index) const { return index < _deviceCount ? _devices[index] : nullptr; }
+
+  /// Report every transaction to @p fn (nullptr to stop)
+  void setObserver(TransactionFn fn, void* user) {
+    _observer = fn;
+    _observerUser = user;
+  }
+
+  const BusCounters& counters() const { return _counters; }
+
+  /// Clear counters and restart the utilization window at the current time
+  void resetCounters() {
+    _counters = BusCounters{};
+    _windowStartUs = stub::nowUs;
+  }
+
+  void setTiming(const WireTiming& timing) { _timing = timing; }
+  const WireTiming& timing() const { return _timing; }
+
+  /// Bus occupancy since resetCounters() as a percentage of elapsed virtual time
+  float utilizationPct() const {
+    uint64_t elapsedUs = stub::nowUs - _windowStartUs;
+    if (elapsedUs == 0) {
+      return _counters.busyNs > 0 ? 100.0f : 0.0f;
+    }
+    return static_cast<float>(_counters.busyNs) / (static_cast<float>(elapsedUs) * 10.0f);
+  }
+
+  Status write(uint8_t addr, const uint8_t* data, size_t len) {
+    _counters.writes++;
+    _counters.bytesTx += static_cast<uint32_t>(len);
+    _occupy(len, 0, true, false);
+    Status st = _write(addr, data, len);
+    _notify(ADS1115::I2cOpType::WRITE, addr, data, len, nullptr, 0, st);
+    return st;
+  }
+
+  Status writeRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                   uint8_t* rxData, size_t rxLen) {
+    _counters.writeReads++;
+    _counters.bytesTx += static_cast<uint32_t>(txLen);
+    _counters.bytesRx += static_cast<uint32_t>(rxLen);
+    _occupy(txLen, rxLen, txLen > 0, true);
+    Status st = _writeRead(addr, txData, txLen, rxData, rxLen);
+    _notify(ADS1115::I2cOpType::WRITE_READ, addr, txData, txLen, rxData, rxLen, st);
+    return st;
+  }
+
+  Status read(uint8_t addr, uint8_t* rxData, size_t rxLen) {
+    _counters.reads++;
+    _counters.bytesRx += static_cast<uint32_t>(rxLen);
+    _occupy(0, rxLen, false, true);
+    Status st = _read(addr, rxData, rxLen);
+    _notify(ADS1115::I2cOpType::READ, addr, nullptr, 0, rxData, rxLen, st);
+    return st;
+  }
+
+  /// Run @p ops as one controller command sequence
+  /// @note Operations are joined by repeated STARTs, so every STOP but the
+  ///       last and its bus-free time disappear from the wire time (the
+  ///       repeated START costs the same clock as the STOP it replaces).
+  Status batch(const ADS1115::I2cOp* ops, size_t count) {
+    _counters.batches++;
+    _inBatch = true;
+    Status st = Status::Ok();
+    for (size_t i = 0; i < count && st.ok(); ++i) {
+      const ADS1115::I2cOp& op = ops[i];
+      _joined = (i + 1 < count);
+      switch (op.type) {
+        case ADS1115::I2cOpType::WRITE:
+          st = write(op.addr, op.tx, op.txLen);
+          break;
+        case ADS1115::I2cOpType::WRITE_READ:
+          st = writeRead(op.addr, op.tx, op.txLen, op.rx, op.rxLen);
+          break;
+        case ADS1115::I2cOpType::READ:
+          st = read(op.addr, op.rx, op.rxLen);
+          break;
+        default:
+          st = Status::Error(Err::INVALID_PARAM, "Invalid I2C operation");
+          break;
+      }
+    }
+    _joined = false;
+    _inBatch = false;
+    return st;
+  }
+
+private:
+  Status _write(uint8_t addr, const uint8_t* data, size_t len) {
+    if (addr == ADS1115::cmd::GENERAL_CALL_ADDR) {
+      if (len == 1 && data[0] == ADS1115::cmd::GENERAL_CALL_RESET) {
+        for (size_t i = 0; i < _deviceCount; ++i) {
+          _devices[i]->reset();
+        }
+      }
+      return Status::Ok();
+    }
+    Device* device = _find(addr);
+    if (device == nullptr) {
+      _counters.nacks++;
+      return Status::Error(Err::I2C_ERROR, "NACK addr", 2);
+    }
+    if (!device->write(data, len, stub::nowUs)) {
+      return Status::Error(Err::I2C_ERROR, "NACK data", 3);
+    }
+    return Status::Ok();
+  }
+
+  Status _writeRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                    uint8_t* rxData, size_t rxLen) {
+    Device* device = _find(addr);
+    if (device == nullptr) {
+      _counters.nacks++;
+      return Status::Error(Err::I2C_ERROR, "NACK addr", 2);
+    }
+    if (!device->write(txData, txLen, stub::nowUs)) {
+      return Status::Error(Err::I2C_ERROR, "NACK data", 3);
+    }
+    device->read(rxData, rxLen, stub::nowUs);
+    return Status::Ok();
+  }
+
+  Status _read(uint8_t addr, uint8_t* rxData, size_t rxLen) {
+    Device* device = _find(addr);
+    if (device == nullptr) {
+      _counters.nacks++;
+      return Status::Error(Err::I2C_ERROR, "NACK addr", 2);
+    }
+    device->read(rxData, rxLen, stub::nowUs);
+    return Status::Ok();
+  }
+
+  void _notify(ADS1115::I2cOpType type, uint8_t addr, const uint8_t* tx, size_t txLen,
+               const uint8_t* rx, size_t rxLen, const Status& st) {
+    if (_observer == nullptr) {
+      return;
+    }
+    TransactionInfo info;
+    info.type = type;
+    info.addr = addr;
+    info.tx = tx;
+    info.txLen = txLen;
+    info.rx = rx;
+    info.rxLen = rxLen;
+    info.startNs = _lastStartNs;
+    info.durationNs = _lastDurationNs;
+    info.batched = _inBatch;
+    info.err = st.code;
+    _observer(info, _observerUser);
+  }
+
+  // A NACKed address still occupies the bus for the full transaction; close
+  // enough for throughput estimates.
+  void _occupy(size_t txLen, size_t rxLen, bool hasWrite, bool hasRead) {
+    uint64_t ns = transactionWireNs(_timing, txLen, rxLen, hasWrite, hasRead);
+    if (_joined) {
+      ns -= busFreeNs(_timing);
+    }
+    _lastStartNs = stub::nowUs * 1000 + _pendingNs;
+    _lastDurationNs = ns;
+    _counters.busyNs += ns;
+    if (_timing.advanceClock) {
+      _pendingNs += ns;
+      stub::nowUs += _pendingNs / 1000;
+      _pendingNs %= 1000;
+    }
+  }
+
+  Device* _find(uint8_t addr) {
+    for (size_t i = 0; i < _deviceCount; ++i) {
+      if (_devices[i]->address() == addr) {
+        return _devices[i];
+      }
+    }
+    return nullptr;
+  }
+
+  Device* _devices[kMaxDevices] = {};
+  size_t _deviceCount = 0;
+  BusCounters _counters;
+  WireTiming _timing;
+  uint64_t _windowStartUs = 0;
+  uint64_t _pendingNs = 0;
+  bool _joined = false;  ///< Current op is followed by another in the same batch
+  bool _inBatch = false;
+  uint64_t _lastStartNs = 0;
+  uint64_t _lastDurationNs = 0;
+  TransactionFn _observer = nullptr;
+  void* _observerUser = nullptr;
+};
+
+/// Config::i2cWrite adapter; user must point to a sim::Bus
+inline Status i2cWrite(uint8_t addr, const uint8_t* data, size_t len,
+                       uint32_t timeoutMs, void* user) {
+  (void)timeoutMs;
+  return static_cast<Bus*>(user)->write(addr, data, len);
+}
+
+/// Config::i2cWriteRead adapter; user must point to a sim::Bus
+inline Status i2cWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                           uint8_t* rxData, size_t rxLen, uint32_t timeoutMs,
+                           void* user) {
+  (void)timeoutMs;
+  return static_cast<Bus*>(user)->writeRead(addr, txData, txLen, rxData, rxLen);
+}
+
+/// Config::i2cRead adapter; user must point to a sim::Bus
+inline Status i2cRead(uint8_t addr, uint8_t* rxData, size_t rxLen, uint32_t timeoutMs,
+                      void* user) {
+  (void)timeoutMs;
+  return static_cast<Bus*>(user)->read(addr, rxData, rxLen);
+}
+
+/// Config::i2cBatch adapter; user must point to a sim::Bus
+inline Status i2cBatch(const ADS1115::I2cOp* ops, size_t count, uint32_t timeoutMs,
+                       void* user) {
+  (void)timeoutMs;
+  return static_cast<Bus*>(user)->batch(ops, count);
+}
+
+/// Fill transport fields of a driver Config (or shared BusConfig) for the given bus
+inline void attachTransport(ADS1115::BusConfig& cfg, Bus& bus) {
+  cfg.i2cWrite = i2cWrite;
+  cfg.i2cWriteRead = i2cWriteRead;
+  cfg.i2cRead = i2cRead;
+  cfg.i2cUser = &bus;
+}
+
+} // namespace sim
@@ -0,0 +1,254 @@
+/// @file ChromeTrace.h
+/// @brief Chrome trace-event JSON export of simulated buses, devices and driver
+/// @note NOT part of the library - native tests and benchmarks only
+///
+/// Open the file in https://ui.perfetto.dev or chrome://tracing. Each bus is a
+/// process with one track for its transactions, and each device on it gets a
+/// conversion-window track and a driver track (tick, polls, conversion start /
+/// ready, samples; needs a build with ADS1115_TRACE=1 and a traceSink that
+/// forwards to record()).
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "ADS1115/Trace.h"
+#include "sim/Ads1115Sim.h"
+
+namespace sim {
+
+/// Streams Chrome trace events to a file as the simulation runs
+class ChromeTrace {
+public:
+  static constexpr size_t kMaxBuses = 8;
+
+  ChromeTrace() = default;
+  ~ChromeTrace() { close(); }
+
+  ChromeTrace(const ChromeTrace&) = delete;
+  ChromeTrace& operator=(const ChromeTrace&) = delete;
+
+  /// Create @p path and write the JSON header
+  bool open(const char* path) {
+    close();
+    _file = fopen(path, "w");
+    if (_file == nullptr) {
+      return false;
+    }
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", _file);
+    _first = true;
+    return true;
+  }
+
+  /// Finish the JSON document; detaches from all buses
+  void close() {
+    if (_file == nullptr) {
+      return;
+    }
+    for (size_t i = 0; i < _busCount; ++i) {
+      _detach(i);
+    }
+    _busCount = 0;
+    fputs("\n]}\n", _file);
+    fclose(_file);
+    _file = nullptr;
+  }
+
+  bool isOpen() const { return _file != nullptr; }
+
+  /// Observe @p bus and the devices currently attached to it
+  /// @return false when the trace is closed or kMaxBuses are already traced
+  bool addBus(Bus& bus, const char* name) {
+    if (_file == nullptr || _busCount >= kMaxBuses) {
+      return false;
+    }
+    size_t index = _busCount++;
+    _buses[index].bus = &bus;
+    _buses[index].owner = this;
+    _buses[index].pid = static_cast<uint32_t>(index + 1);
+    bus.setObserver(onTransaction, &_buses[index]);
+
+    const uint32_t pid = _buses[index].pid;
+    _meta(pid, 0, "process_name", name);
+    _meta(pid, 0, "thread_name", "transactions");
+    if (index == 0) {
+      _meta(pid, kSectionTid, "thread_name", "sections");
+    }
+    for (size_t d = 0; d < bus.deviceCount(); ++d) {
+      Device* device = bus.device(d);
+      device->setObserver(onConversion, &_buses[index]);
+      char label[32];
+      snprintf(label, sizeof(label), "0x%02X conversions", device->address());
+      _meta(pid, _conversionTid(device->address()), "thread_name", label);
+      snprintf(label, sizeof(label), "0x%02X driver", device->address());
+      _meta(pid, _driverTid(device->address()), "thread_name", label);
+    }
+    return true;
+  }
+
+  /// Shift later events by @p offsetUs (e.g. when a scenario rewinds stub::nowUs)
+  void setTimeOffsetUs(uint64_t offsetUs) { _offsetUs = offsetUs; }
+  uint64_t timeOffsetUs() const { return _offsetUs; }
+
+  /// Latest event end time written so far, including the offset
+  uint64_t endUs() const { return _endUs; }
+
+  /// Span on the transactions track of the first bus, e.g. a benchmark case
+  void section(const char* name, uint64_t startUs, uint64_t endUs) {
+    if (_file == nullptr || _busCount == 0) {
+      return;
+    }
+    _begin();
+    fprintf(_file,
+            "{\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"name\":\"%s\",\"cat\":\"section\","
+            "\"ts\":%llu,\"dur\":%llu}",
+            _buses[0].pid, kSectionTid, name,
+            static_cast<unsigned long long>(startUs + _offsetUs),
+            static_cast<unsigned long long>(endUs > startUs ? endUs - startUs : 0));
+  }
+
+  /// Driver event from ADS1115::traceSink(); @p bus selects the process
+  /// @note Without @p bus the event lands on the bus that carried the most
+  ///       recent transaction, which is right for the driver's own accesses.
+  void record(const ADS1115::TraceRecord& rec, const Bus* bus = nullptr) {
+    if (_file == nullptr || _busCount == 0) {
+      return;
+    }
+    uint32_t pid = _lastPid;
+    for (size_t i = 0; bus != nullptr && i < _busCount; ++i) {
+      if (_buses[i].bus == bus) {
+        pid = _buses[i].pid;
+      }
+    }
+    const char* name = ADS1115::traceEventName(rec.event);
+    if (rec.event == ADS1115::TraceEvent::REG_READ &&
+        rec.reg == ADS1115::cmd::REG_CONFIG) {
+      name = "poll_config";
+    }
+    _begin();
+    fprintf(_file,
+            "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%u,\"tid\":%u,\"name\":\"%s\",\"cat\":\"driver\","
+            "\"ts\":%llu,\"args\":{\"reg\":%u,\"value\":\"0x%04X\",\"err\":%u,\"arg\":%u}}",
+            pid, _driverTid(rec.addr), name,
+            static_cast<unsigned long long>(rec.timestampUs + _offsetUs), rec.reg, rec.value,
+            static_cast<unsigned>(rec.err), rec.arg);
+    _extend(rec.timestampUs + _offsetUs);
+  }
+
+  /// Bus::setObserver adapter; user is the per-bus slot set up by addBus()
+  static void onTransaction(const TransactionInfo& info, void* user) {
+    Slot* slot = static_cast<Slot*>(user);
+    slot->owner->_transaction(*slot, info);
+  }
+
+  /// Device::setObserver adapter; user is the per-bus slot set up by addBus()
+  static void onConversion(const ConversionInfo& info, void* user) {
+    Slot* slot = static_cast<Slot*>(user);
+    slot->owner->_conversion(*slot, info);
+  }
+
+private:
+  static constexpr uint32_t kSectionTid = 1;
+
+  struct Slot {
+    Bus* bus = nullptr;
+    ChromeTrace* owner = nullptr;
+    uint32_t pid = 0;
+  };
+
+  static uint32_t _conversionTid(uint8_t addr) { return 0x100U + addr; }
+  static uint32_t _driverTid(uint8_t addr) { return 0x200U + addr; }
+
+  static const char* _regName(uint8_t reg) {
+    static const char* const kNames[] = {"CONVERSION", "CONFIG", "LO_THRESH", "HI_THRESH"};
+    return kNames[reg & 0x03];
+  }
+
+  void _transaction(const Slot& slot, const TransactionInfo& info) {
+    _lastPid = slot.pid;
+    char name[40];
+    if (info.addr == ADS1115::cmd::GENERAL_CALL_ADDR) {
+      snprintf(name, sizeof(name), "general_call");
+    } else if (info.type == ADS1115::I2cOpType::READ) {
+      snprintf(name, sizeof(name), "read 0x%02X", info.addr);
+    } else {
+      const char* kind = info.type == ADS1115::I2cOpType::WRITE
+                           ? (info.txLen > 1 ? "write" : "pointer")
+                           : "read";
+      snprintf(name, sizeof(name), "%s 0x%02X %s", kind, info.addr,
+               info.txLen > 0 ? _regName(info.tx[0]) : "?");
+    }
+    uint16_t value = 0;
+    if (info.type == ADS1115::I2cOpType::WRITE && info.txLen >= 3) {
+      value = static_cast<uint16_t>((info.tx[1] << 8) | info.tx[2]);
+    } else if (info.type != ADS1115::I2cOpType::WRITE && info.rxLen >= 2) {
+      value = static_cast<uint16_t>((info.rx[0] << 8) | info.rx[1]);
+    }
+    uint64_t startNs = info.startNs + _offsetUs * 1000;
+    _begin();
+    fprintf(_file,
+            "{\"ph\":\"X\",\"pid\":%u,\"tid\":0,\"name\":\"%s\",\"cat\":\"bus\","
+            "\"ts\":%llu.%03u,\"dur\":%llu.%03u,\"args\":{\"value\":\"0x%04X\","
+            "\"batched\":%s,\"err\":%u}}",
+            slot.pid, name, static_cast<unsigned long long>(startNs / 1000),
+            static_cast<unsigned>(startNs % 1000),
+            static_cast<unsigned long long>(info.durationNs / 1000),
+            static_cast<unsigned>(info.durationNs % 1000), value,
+            info.batched ? "true" : "false", static_cast<unsigned>(info.err));
+    _extend((startNs + info.durationNs + 999) / 1000);
+  }
+
+  void _conversion(const Slot& slot, const ConversionInfo& info) {
+    static const char* const kMux[] = {"AIN0-AIN1", "AIN0-AIN3", "AIN1-AIN3", "AIN2-AIN3",
+                                       "AIN0", "AIN1", "AIN2", "AIN3"};
+    uint64_t startUs = info.startUs + _offsetUs;
+    _begin();
+    fprintf(_file,
+            "{\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"name\":\"%s\",\"cat\":\"conversion\","
+            "\"ts\":%llu,\"dur\":%u,\"args\":{\"continuous\":%s}}",
+            slot.pid, _conversionTid(info.addr), kMux[info.mux & 0x07],
+            static_cast<unsigned long long>(startUs), info.durationUs,
+            info.continuous ? "true" : "false");
+    _extend(startUs + info.durationUs);
+  }
+
+  void _meta(uint32_t pid, uint32_t tid, const char* kind, const char* name) {
+    _begin();
+    fprintf(_file, "{\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"name\":\"%s\",\"args\":{\"name\":\"%s\"}}",
+            pid, tid, kind, name);
+  }
+
+  void _detach(size_t index) {
+    Bus* bus = _buses[index].bus;
+    bus->setObserver(nullptr, nullptr);
+    for (size_t d = 0; d < bus->deviceCount(); ++d) {
+      bus->device(d)->setObserver(nullptr, nullptr);
+    }
+  }
+
+  void _begin() {
+    if (!_first) {
+      fputs(",\n", _file);
+    }
+    _first = false;
+  }
+
+  void _extend(uint64_t us) {
+    if (us > _endUs) {
+      _endUs = us;
+    }
+  }
+
+  FILE* _file = nullptr;
+  Slot _buses[kMaxBuses];
+  size_t _busCount = 0;
+  uint32_t _lastPid = 1;
+  uint64_t _offsetUs = 0;
+  uint64_t _endUs = 0;
+  bool _first = true;
+};
+
+} // namespace sim
@@ -0,0 +1,435 @@
+/// @file SystemSim.h
+/// @brief Discrete-event simulation of several ADS1115s on several I2C buses
+/// @note NOT part of the library - native capacity planning only
+///
+/// Every bus is an agent: one controller task that loops over the devices on
+/// its bus and runs the real driver (and EdfScheduler) against them. Agents
+/// wake in virtual-time order; each step advances stub::nowUs by the wire time
+/// of its transactions, so buses run in parallel while transactions on one bus
+/// serialize. CPU time of the driver itself is not modelled.
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ADS1115/ADS1115.h"
+#include "ADS1115/Scheduler.h"
+#include "sim/Ads1115Sim.h"
+#include "sim/ChromeTrace.h"
+
+namespace sim {
+
+/// How each bus task drives its devices
+enum class ScanPolicy : uint8_t {
+  SCAN = 0,    ///< Single-shot round robin: start, poll until ready, read, next channel
+  EDF,         ///< EdfScheduler per device, every channel released each periodUs
+  CONTINUOUS   ///< Continuous mode on the first channel, read once per data-rate period
+};
+
+/// Simulated system layout and scan strategy
+struct SystemConfig {
+  uint8_t buses = 1;                ///< I2C controllers (1..kMaxBuses)
+  uint8_t devicesPerBus = 1;        ///< ADS1115s per bus at 0x48.. (1..4)
+  uint8_t channelsPerDevice = 4;    ///< Single-ended inputs AIN0.. (1..4)
+  uint32_t sclHz = 400000;
+  ADS1115::DataRate dataRate = ADS1115::DataRate::SPS_860;
+  ScanPolicy policy = ScanPolicy::SCAN;
+  uint32_t periodUs = 10000;        ///< EDF release period per channel
+  uint32_t pollUs = 100;            ///< Bus task loop period
+  bool alertPin = false;            ///< Readiness from ALERT/RDY instead of config polls
+  bool batch = false;               ///< Install sim::i2cBatch on every driver
+  uint32_t durationMs = 1000;       ///< Simulated run time
+};
+
+/// Log-linear latency histogram (16 sub-buckets per power of two, <= 6% error)
+class LatencyHistogram {
+public:
+  void clear() {
+    for (uint32_t& b : _buckets) {
+      b = 0;
+    }
+    _count = 0;
+    _maxUs = 0;
+  }
+
+  void add(uint32_t us) {
+    _buckets[_index(us)]++;
+    _count++;
+    if (us > _maxUs) {
+      _maxUs = us;
+    }
+  }
+
+  uint32_t count() const { return _count; }
+  uint32_t maxUs() const { return _maxUs; }
+
+  /// Value at percentile @p pct (0..100), bucket midpoint
+  uint32_t percentile(float pct) const {
+    if (_count == 0) {
+      return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(pct / 100.0f * static_cast<float>(_count) + 0.5f);
+    if (target == 0) {
+      target = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+      seen += _buckets[i];
+      if (seen >= target) {
+        uint32_t mid = _lower(i) + _width(i) / 2;
+        return mid < _maxUs ? mid : _maxUs;
+      }
+    }
+    return _maxUs;
+  }
+
+private:
+  static constexpr size_t kSub = 16;
+  static constexpr size_t kBuckets = kSub * 29;
+
+  static size_t _index(uint32_t v) {
+    if (v < kSub) {
+      return v;
+    }
+    uint32_t msb = 31U - static_cast<uint32_t>(__builtin_clz(v));
+    return kSub * (msb - 3) + ((v >> (msb - 4)) & (kSub - 1));
+  }
+
+  static uint32_t _lower(size_t index) {
+    if (index < kSub) {
+      return static_cast<uint32_t>(index);
+    }
+    uint32_t msb = static_cast<uint32_t>(index / kSub) + 3;
+    return static_cast<uint32_t>(kSub + index % kSub) << (msb - 4);
+  }
+
+  static uint32_t _width(size_t index) {
+    return index < kSub ? 1U : 1U << (static_cast<uint32_t>(index / kSub) - 1);
+  }
+
+  uint32_t _buckets[kBuckets] = {};
+  uint32_t _count = 0;
+  uint32_t _maxUs = 0;
+};
+
+/// Result for one input channel
+struct ChannelReport {
+  uint8_t bus = 0;
+  uint8_t addr = 0;
+  uint8_t channel = 0;     ///< AINx
+  uint32_t samples = 0;    ///< Fresh conversions delivered
+  uint32_t stale = 0;      ///< Reads that returned an already delivered result
+  uint32_t released = 0;   ///< EDF jobs released
+  uint32_t overruns = 0;   ///< EDF jobs replaced or skipped before they started
+  uint32_t misses = 0;     ///< EDF deadline misses
+  float sps = 0.0f;
+  uint32_t p50Us = 0;      ///< Data age at delivery (read done - conversion end)
+  uint32_t p90Us = 0;
+  uint32_t p99Us = 0;
+  uint32_t maxUs = 0;
+};
+
+/// Result for one bus
+struct BusReport {
+  uint32_t transactions = 0;
+  uint32_t bytes = 0;
+  uint64_t busyNs = 0;
+  float utilizationPct = 0.0f;
+};
+
+/// N devices on M buses driven by the real driver against virtual time
+class System {
+public:
+  static constexpr size_t kMaxBuses = 8;
+  static constexpr size_t kDevicesPerBus = Bus::kMaxDevices;
+  static constexpr size_t kChannelsPerDevice = 4;
+
+  /// Build buses, devices and drivers; INVALID_CONFIG when out of range
+  Status configure(const SystemConfig& config) {
+    if (config.buses == 0 || config.buses > kMaxBuses || config.devicesPerBus == 0 ||
+        config.devicesPerBus > kDevicesPerBus || config.channelsPerDevice == 0 ||
+        config.channelsPerDevice > kChannelsPerDevice) {
+      return Status::Error(Err::INVALID_CONFIG, "System layout out of range");
+    }
+    _config = config;
+    if (_config.policy == ScanPolicy::CONTINUOUS) {
+      _config.channelsPerDevice = 1;
+    }
+    stub::nowUs = 0;
+    stub::autoAdvanceUs = 0;
+    WireTiming timing;
+    timing.sclHz = _config.sclHz;
+
+    for (size_t b = 0; b < _config.buses; ++b) {
+      Agent& agent = _agents[b];
+      agent.index = static_cast<uint8_t>(b);
+      agent.bus = Bus{};
+      agent.bus.setTiming(timing);
+      for (size_t d = 0; d < _config.devicesPerBus; ++d) {
+        Node& node = agent.nodes[d];
+        node = Node{};
+        node.agent = &agent;
+        node.device = Device(static_cast<uint8_t>(0x48 + d));
+        for (uint8_t pin = 0; pin < 4; ++pin) {
+          node.device.setInput(pin, 0.25f * (pin + 1));
+        }
+        agent.bus.attach(&node.device);
+        Status st = _beginNode(node, d);
+        if (!st.ok()) {
+          return st;
+        }
+      }
+    }
+    return Status::Ok();
+  }
+
+  /// Observe every bus in @p trace; call after configure(), before run()
+  void attachTrace(ChromeTrace& trace) {
+    for (size_t b = 0; b < _config.buses; ++b) {
+      char name[16];
+      snprintf(name, sizeof(name), "bus %u", static_cast<unsigned>(b));
+      trace.addBus(_agents[b].bus, name);
+    }
+  }
+
+  /// Run for SystemConfig::durationMs of virtual time
+  void run() {
+    // Configuration traffic already advanced the clock; devices must never
+    // see it go back
+    const uint64_t startUs = stub::nowUs;
+    const uint64_t endUs = startUs + static_cast<uint64_t>(_config.durationMs) * 1000;
+    for (size_t b = 0; b < _config.buses; ++b) {
+      Agent& agent = _agents[b];
+      agent.wakeUs = startUs;
+      agent.bus.resetCounters();
+      for (size_t d = 0; d < _config.devicesPerBus; ++d) {
+        agent.nodes[d].nextReadUs = startUs + _conversionUs();
+        agent.nodes[d].sched.start(static_cast<uint32_t>(startUs));
+      }
+    }
+    for (;;) {
+      Agent* agent = _earliest();
+      if (agent == nullptr || agent->wakeUs >= endUs) {
+        break;
+      }
+      stub::nowUs = agent->wakeUs;
+      _active = agent;
+      uint64_t stepUs = stub::nowUs;
+      for (size_t d = 0; d < _config.devicesPerBus; ++d) {
+        _step(agent->nodes[d]);
+      }
+      agent->lastUs = stub::nowUs;
+      agent->wakeUs = stub::nowUs > stepUs + _config.pollUs ? stub::nowUs
+                                                             : stepUs + _config.pollUs;
+    }
+    _active = nullptr;
+    _startUs = startUs;
+    _elapsedUs = endUs - startUs;
+    stub::nowUs = endUs;
+  }
+
+  /// Bus whose task is running (for routing trace records)
+  const Bus* activeBus() const { return _active != nullptr ? &_active->bus : nullptr; }
+
+  size_t busCount() const { return _config.buses; }
+  size_t channelCount() const {
+    return static_cast<size_t>(_config.buses) * _config.devicesPerBus * _config.channelsPerDevice;
+  }
+
+  BusReport busReport(size_t index) const {
+    BusReport out;
+    if (index >= _config.buses) {
+      return out;
+    }
+    const BusCounters& c = _agents[index].bus.counters();
+    out.transactions = c.transactions();
+    out.bytes = c.bytesTx + c.bytesRx;
+    out.busyNs = c.busyNs;
+    // A saturated bus finishes its last step past the end of the run
+    uint64_t elapsedUs = _agents[index].lastUs - _startUs;
+    if (elapsedUs < _elapsedUs) {
+      elapsedUs = _elapsedUs;
+    }
+    if (elapsedUs > 0) {
+      out.utilizationPct = static_cast<float>(c.busyNs) / (static_cast<float>(elapsedUs) * 10.0f);
+    }
+    return out;
+  }
+
+  /// Channels are numbered bus-major, then device, then AIN
+  ChannelReport channelReport(size_t index) const {
+    ChannelReport out;
+    if (index >= channelCount()) {
+      return out;
+    }
+    size_t perBus = static_cast<size_t>(_config.devicesPerBus) * _config.channelsPerDevice;
+    const Agent& agent = _agents[index / perBus];
+    const Node& node = agent.nodes[(index % perBus) / _config.channelsPerDevice];
+    size_t ch = index % _config.channelsPerDevice;
+    const ChannelData& data = node.channels[ch];
+    out.bus = agent.index;
+    out.addr = node.device.address();
+    out.channel = static_cast<uint8_t>(ch);
+    out.samples = data.latency.count();
+    out.stale = data.stale;
+    if (_config.policy == ScanPolicy::EDF) {
+      ADS1115::ChannelSchedStats sched = node.sched.channelStats(ch);
+      out.released = sched.released;
+      out.overruns = sched.overruns;
+      out.misses = sched.misses;
+    }
+    if (_elapsedUs > 0) {
+      out.sps = static_cast<float>(out.samples) * 1.0e6f / static_cast<float>(_elapsedUs);
+    }
+    out.p50Us = data.latency.percentile(50.0f);
+    out.p90Us = data.latency.percentile(90.0f);
+    out.p99Us = data.latency.percentile(99.0f);
+    out.maxUs = data.latency.maxUs();
+    return out;
+  }
+
+private:
+  struct Agent;
+
+  struct ChannelData {
+    LatencyHistogram latency;
+    uint64_t lastResultUs = 0;  ///< No conversion ends at t = 0
+    uint32_t stale = 0;
+  };
+
+  /// One device, its driver and its per-channel statistics
+  struct Node {
+    Agent* agent = nullptr;
+    Device device{0x48};
+    ADS1115::ADS1115 driver;
+    ADS1115::EdfScheduler<kChannelsPerDevice> sched;
+    ChannelData channels[kChannelsPerDevice];
+    uint64_t nextReadUs = 0;
+    uint8_t current = 0;   ///< SCAN: channel being converted
+    bool started = false;  ///< SCAN: conversion in flight
+  };
+
+  /// One bus and the task that owns it
+  struct Agent {
+    Bus bus;
+    Node nodes[kDevicesPerBus];
+    uint64_t wakeUs = 0;
+    uint64_t lastUs = 0;  ///< Clock at the end of the latest step
+    uint8_t index = 0;
+  };
+
+  uint32_t _conversionUs() const {
+    return ADS1115::conversionTimeUs(_config.dataRate);
+  }
+
+  ADS1115::ChannelConfig _channelConfig(size_t ch) const {
+    ADS1115::ChannelConfig cfg;
+    cfg.mux = static_cast<ADS1115::Mux>(static_cast<uint8_t>(ADS1115::Mux::AIN0_GND) + ch);
+    cfg.gain = ADS1115::Gain::FSR_4_096V;
+    cfg.dataRate = _config.dataRate;
+    return cfg;
+  }
+
+  Status _beginNode(Node& node, size_t index) {
+    ADS1115::Config cfg;
+    attachTransport(cfg, node.agent->bus);
+    if (_config.batch) {
+      cfg.i2cBatch = i2cBatch;
+    }
+    cfg.i2cAddress = node.device.address();
+    cfg.mode = (_config.policy == ScanPolicy::CONTINUOUS) ? ADS1115::Mode::CONTINUOUS
+                                                           : ADS1115::Mode::SINGLE_SHOT;
+    cfg.dataRate = _config.dataRate;
+    cfg.gain = ADS1115::Gain::FSR_4_096V;
+    cfg.onSample = onSample;
+    cfg.sampleUser = &node;
+    if (_config.alertPin && _config.policy != ScanPolicy::CONTINUOUS) {
+      cfg.alertRdyPin = static_cast<int>(index);
+      cfg.gpioRead = alertLevel;
+      cfg.gpioUser = node.agent;
+    }
+    Status st = node.driver.begin(cfg);
+    if (st.ok() && cfg.alertRdyPin >= 0) {
+      st = node.driver.enableConversionReadyPin();
+    }
+    if (!st.ok()) {
+      return st;
+    }
+    for (size_t ch = 0; ch < _config.channelsPerDevice; ++ch) {
+      node.sched.addChannel(_channelConfig(ch), _config.periodUs);
+    }
+    // The driver reports ready no earlier than its millisecond gate, well past
+    // the nominal conversion time at high rates
+    uint32_t gateUs = node.driver.getConversionTimeMs() * 1000;
+    node.sched.setOverheadUs(gateUs > _conversionUs() ? gateUs - _conversionUs() : 0);
+    return Status::Ok();
+  }
+
+  void _step(Node& node) {
+    int16_t raw = 0;
+    switch (_config.policy) {
+      case ScanPolicy::SCAN:
+        if (node.started) {
+          if (!node.driver.conversionReady()) {
+            return;
+          }
+          node.driver.readRaw(raw);
+          node.current = static_cast<uint8_t>((node.current + 1) % _config.channelsPerDevice);
+        }
+        node.started = node.driver.startConversion(_channelConfig(node.current)).inProgress();
+        break;
+      case ScanPolicy::EDF:
+        node.sched.poll(node.driver, micros());
+        break;
+      case ScanPolicy::CONTINUOUS:
+        if (stub::nowUs >= node.nextReadUs) {
+          node.driver.readRaw(raw);
+          node.nextReadUs += _conversionUs();
+        }
+        break;
+    }
+  }
+
+  Agent* _earliest() {
+    Agent* best = nullptr;
+    for (size_t b = 0; b < _config.buses; ++b) {
+      if (best == nullptr || _agents[b].wakeUs < best->wakeUs) {
+        best = &_agents[b];
+      }
+    }
+    return best;
+  }
+
+  /// Config::onSample hook; user is the Node
+  static void onSample(const ADS1115::Sample& sample, void* user) {
+    Node* node = static_cast<Node*>(user);
+    size_t ch = static_cast<uint8_t>(sample.mux) - static_cast<uint8_t>(ADS1115::Mux::AIN0_GND);
+    if (ch >= kChannelsPerDevice) {
+      return;
+    }
+    ChannelData& data = node->channels[ch];
+    uint64_t resultUs = node->device.resultUs();
+    if (resultUs == data.lastResultUs) {
+      data.stale++;
+      return;
+    }
+    data.lastResultUs = resultUs;
+    data.latency.add(static_cast<uint32_t>(stub::nowUs - resultUs));
+  }
+
+  /// BusConfig::gpioRead adapter: ALERT/RDY (active low) of device @p pin
+  static bool alertLevel(int pin, void* user) {
+    Agent* agent = static_cast<Agent*>(user);
+    return !agent->nodes[pin].device.conversionDone(stub::nowUs);
+  }
+
+  SystemConfig _config;
+  Agent _agents[kMaxBuses];
+  Agent* _active = nullptr;
+  uint64_t _startUs = 0;
+  uint64_t _elapsedUs = 0;
+};
+
+} // namespace sim
@@ -0,0 +1,115 @@
+/// @file test_main.cpp
+/// @brief Slim instance layout (ADS1115_SLIM_INSTANCE=1): drivers on one shared BusConfig
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "sim/Ads1115Sim.h"
+
+#if !ADS1115_SLIM_INSTANCE
+#error "Build this suite with -DADS1115_SLIM_INSTANCE=1 (pio test -e native_slim)"
+#endif
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice0(0x48);
+sim::Device simDevice1(0x49);
+sim::Bus simBus;
+BusConfig sharedBus;
+ADS1115::ADS1115 adc0;
+ADS1115::ADS1115 adc1;
+
+Config deviceConfig(uint8_t addr) {
+  Config cfg;
+  cfg.bus = &sharedBus;
+  cfg.i2cAddress = addr;
+  cfg.mux = Mux::AIN0_GND;
+  cfg.dataRate = DataRate::SPS_860;
+  return cfg;
+}
+
+/// Single-shot conversion through startConversion()/readRaw()
+Status convert(ADS1115::ADS1115& adc, int16_t& raw) {
+  Status st = adc.startConversion();
+  if (!st.inProgress()) {
+    return st;
+  }
+  stub::nowUs += 10000;  // Past the conversion time plus the driver margin
+  return adc.readRaw(raw);
+}
+
+} // namespace
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 10;
+  simDevice0.reset();
+  simDevice1.reset();
+  simDevice0.setInput(0, 0.5f);
+  simDevice1.setInput(0, 1.0f);
+  sharedBus = BusConfig{};
+  sim::attachTransport(sharedBus, simBus);
+}
+
+void tearDown() {}
+
+void test_instance_holds_no_transport_copy() {
+  TEST_ASSERT_TRUE(sizeof(ADS1115::ADS1115) < sizeof(BusConfig) + sizeof(DeviceConfig) + 64);
+}
+
+void test_begin_requires_shared_bus() {
+  Config cfg = deviceConfig(0x48);
+  cfg.bus = nullptr;
+  sim::attachTransport(cfg, simBus);  // Ignored: the slim layout has nowhere to copy it
+  Status st = adc0.begin(cfg);
+  TEST_ASSERT_EQUAL(Err::INVALID_CONFIG, st.code);
+  TEST_ASSERT_EQUAL_STRING("Shared bus required", st.msg);
+}
+
+void test_two_devices_read_through_shared_bus() {
+  TEST_ASSERT_TRUE(adc0.begin(deviceConfig(0x48)).ok());
+  TEST_ASSERT_TRUE(adc1.begin(deviceConfig(0x49)).ok());
+
+  int16_t raw0 = 0;
+  int16_t raw1 = 0;
+  TEST_ASSERT_TRUE(convert(adc0, raw0).ok());
+  TEST_ASSERT_TRUE(convert(adc1, raw1).ok());
+  TEST_ASSERT_TRUE(raw0 > 7990 && raw0 < 8010);    // 0.5 V on the 2.048 V range
+  TEST_ASSERT_TRUE(raw1 > 15990 && raw1 < 16010);  // 1.0 V
+  TEST_ASSERT_EQUAL(DriverState::READY, adc0.state());
+  TEST_ASSERT_EQUAL(DriverState::READY, adc1.state());
+}
+
+void test_bus_changes_are_seen_without_begin() {
+  TEST_ASSERT_TRUE(adc0.begin(deviceConfig(0x48)).ok());
+
+  // The driver reads the transport through the pointer, so swapping the
+  // callback takes effect immediately
+  sharedBus.i2cWriteRead = nullptr;
+  sharedBus.i2cWrite = [](uint8_t, const uint8_t*, size_t, uint32_t, void*) {
+    return Status::Error(Err::I2C_ERROR, "Bus detached");
+  };
+  Status st = adc0.startConversion();
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, st.code);
+  TEST_ASSERT_EQUAL_UINT32(1, adc0.totalFailures());
+}
+
+int main() {
+  simBus.attach(&simDevice0);
+  simBus.attach(&simDevice1);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_instance_holds_no_transport_copy);
+  RUN_TEST(test_begin_requires_shared_bus);
+  RUN_TEST(test_two_devices_read_through_shared_bus);
+  RUN_TEST(test_bus_changes_are_seen_without_begin);
+  return UNITY_END();
+}
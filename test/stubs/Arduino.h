@@ -5,15 +5,28 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <string>
 
 // Basic types
 using byte = uint8_t;
 
+// Virtual clock (stays at 0 unless a test or simulation drives it)
+namespace stub {
+inline uint64_t nowUs = 0;         ///< Current virtual time in microseconds
+inline uint32_t autoAdvanceUs = 0; ///< Added on every millis()/micros() call
+} // namespace stub
+
 // Timing stubs
-inline uint32_t millis() { return 0; }
-inline uint32_t micros() { return 0; }
-inline void delay(uint32_t ms) { (void)ms; }
-inline void delayMicroseconds(uint32_t us) { (void)us; }
+inline uint32_t micros() {
+  stub::nowUs += stub::autoAdvanceUs;
+  return static_cast<uint32_t>(stub::nowUs);
+}
+inline uint32_t millis() {
+  stub::nowUs += stub::autoAdvanceUs;
+  return static_cast<uint32_t>(stub::nowUs / 1000U);
+}
+inline void delay(uint32_t ms) { stub::nowUs += static_cast<uint64_t>(ms) * 1000U; }
+inline void delayMicroseconds(uint32_t us) { stub::nowUs += us; }
 
 // Serial stub
 class SerialClass {
@@ -0,0 +1,223 @@
+/// @file i2c_master.h
+/// @brief Host shim of the ESP-IDF 5.x i2c_master driver for native testing
+/// @note Transfers are forwarded to idf_shim::backend (e.g. the ADS1115
+///       simulator); without a backend every address NACKs. Queued (async)
+///       transfers complete synchronously and fire on_trans_done; as on the
+///       hardware, their NACK is reported only through that callback.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+using i2c_port_num_t = int;
+using gpio_num_t = int;
+
+enum i2c_clock_source_t { I2C_CLK_SRC_DEFAULT = 0 };
+enum i2c_addr_bit_len_t { I2C_ADDR_BIT_LEN_7 = 0, I2C_ADDR_BIT_LEN_10 = 1 };
+enum i2c_master_event_t {
+  I2C_EVENT_ALIVE = 0,
+  I2C_EVENT_DONE = 1,
+  I2C_EVENT_NACK = 2,
+  I2C_EVENT_TIMEOUT = 3
+};
+
+struct i2c_master_bus_config_t {
+  i2c_port_num_t i2c_port = -1;
+  gpio_num_t sda_io_num = -1;
+  gpio_num_t scl_io_num = -1;
+  i2c_clock_source_t clk_source = I2C_CLK_SRC_DEFAULT;
+  uint8_t glitch_ignore_cnt = 0;
+  int intr_priority = 0;
+  size_t trans_queue_depth = 0;
+  struct {
+    uint32_t enable_internal_pullup : 1;
+    uint32_t allow_pd : 1;
+  } flags = {0, 0};
+};
+
+struct i2c_device_config_t {
+  i2c_addr_bit_len_t dev_addr_length = I2C_ADDR_BIT_LEN_7;
+  uint16_t device_address = 0;
+  uint32_t scl_speed_hz = 0;
+  uint32_t scl_wait_us = 0;
+  struct {
+    uint32_t disable_ack_check : 1;
+  } flags = {0};
+};
+
+struct i2c_master_event_data_t {
+  i2c_master_event_t event;
+};
+
+struct i2c_master_bus_t;
+struct i2c_master_dev_t;
+using i2c_master_bus_handle_t = i2c_master_bus_t*;
+using i2c_master_dev_handle_t = i2c_master_dev_t*;
+
+using i2c_master_callback_t = bool (*)(i2c_master_dev_handle_t dev,
+                                       const i2c_master_event_data_t* evt, void* arg);
+
+struct i2c_master_event_callbacks_t {
+  i2c_master_callback_t on_trans_done = nullptr;
+};
+
+namespace idf_shim {
+
+/// Where shim transfers go
+struct Backend {
+  bool (*write)(uint16_t addr, const uint8_t* data, size_t len, void* user) = nullptr;
+  bool (*writeRead)(uint16_t addr, const uint8_t* tx, size_t txLen, uint8_t* rx,
+                    size_t rxLen, void* user) = nullptr;
+  bool (*read)(uint16_t addr, uint8_t* rx, size_t rxLen, void* user) = nullptr;
+  void* user = nullptr;
+};
+
+/// Driver calls made through the shim
+struct Counters {
+  uint32_t busCreates = 0;
+  uint32_t deviceAdds = 0;
+  uint32_t transmits = 0;
+  uint32_t transmitReceives = 0;
+  uint32_t receives = 0;
+  uint32_t waitAllDone = 0;
+  uint32_t callbacks = 0;
+};
+
+static constexpr size_t kMaxDevices = 8;
+
+inline Backend backend;
+inline Counters counters;
+
+} // namespace idf_shim
+
+struct i2c_master_dev_t {
+  i2c_master_bus_t* bus = nullptr;
+  uint16_t address = 0;
+  bool used = false;
+  i2c_master_event_callbacks_t cbs;
+  void* cbArg = nullptr;
+};
+
+struct i2c_master_bus_t {
+  i2c_master_bus_config_t config;
+  bool used = false;
+  i2c_master_dev_t devices[idf_shim::kMaxDevices];
+};
+
+namespace idf_shim {
+inline i2c_master_bus_t buses[2];
+
+inline esp_err_t complete(i2c_master_dev_handle_t dev, bool ok) {
+  if (dev->cbs.on_trans_done != nullptr) {
+    i2c_master_event_data_t evt{ok ? I2C_EVENT_DONE : I2C_EVENT_NACK};
+    counters.callbacks++;
+    dev->cbs.on_trans_done(dev, &evt, dev->cbArg);
+  }
+  if (ok || dev->bus->config.trans_queue_depth > 0) {
+    return ESP_OK;
+  }
+  return ESP_ERR_INVALID_STATE;
+}
+} // namespace idf_shim
+
+inline esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t* config,
+                                    i2c_master_bus_handle_t* ret) {
+  if (config == nullptr || ret == nullptr || config->i2c_port < 0 || config->i2c_port > 1) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  i2c_master_bus_t& bus = idf_shim::buses[config->i2c_port];
+  if (bus.used) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  bus = i2c_master_bus_t{};
+  bus.config = *config;
+  bus.used = true;
+  idf_shim::counters.busCreates++;
+  *ret = &bus;
+  return ESP_OK;
+}
+
+inline esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t bus) {
+  if (bus == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  bus->used = false;
+  return ESP_OK;
+}
+
+inline esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus,
+                                           const i2c_device_config_t* config,
+                                           i2c_master_dev_handle_t* ret) {
+  if (bus == nullptr || config == nullptr || ret == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  for (i2c_master_dev_t& dev : bus->devices) {
+    if (!dev.used) {
+      dev = i2c_master_dev_t{};
+      dev.bus = bus;
+      dev.address = config->device_address;
+      dev.used = true;
+      idf_shim::counters.deviceAdds++;
+      *ret = &dev;
+      return ESP_OK;
+    }
+  }
+  return ESP_ERR_NO_MEM;
+}
+
+inline esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t dev) {
+  if (dev == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  dev->used = false;
+  return ESP_OK;
+}
+
+inline esp_err_t i2c_master_register_event_callbacks(i2c_master_dev_handle_t dev,
+                                                     const i2c_master_event_callbacks_t* cbs,
+                                                     void* arg) {
+  if (dev == nullptr || cbs == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  dev->cbs = *cbs;
+  dev->cbArg = arg;
+  return ESP_OK;
+}
+
+inline esp_err_t i2c_master_transmit(i2c_master_dev_handle_t dev, const uint8_t* data,
+                                     size_t len, int timeoutMs) {
+  (void)timeoutMs;
+  idf_shim::counters.transmits++;
+  bool ok = idf_shim::backend.write != nullptr &&
+            idf_shim::backend.write(dev->address, data, len, idf_shim::backend.user);
+  return idf_shim::complete(dev, ok);
+}
+
+inline esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t dev, const uint8_t* tx,
+                                             size_t txLen, uint8_t* rx, size_t rxLen,
+                                             int timeoutMs) {
+  (void)timeoutMs;
+  idf_shim::counters.transmitReceives++;
+  bool ok = idf_shim::backend.writeRead != nullptr &&
+            idf_shim::backend.writeRead(dev->address, tx, txLen, rx, rxLen,
+                                        idf_shim::backend.user);
+  return idf_shim::complete(dev, ok);
+}
+
+inline esp_err_t i2c_master_receive(i2c_master_dev_handle_t dev, uint8_t* rx, size_t rxLen,
+                                    int timeoutMs) {
+  (void)timeoutMs;
+  idf_shim::counters.receives++;
+  bool ok = idf_shim::backend.read != nullptr &&
+            idf_shim::backend.read(dev->address, rx, rxLen, idf_shim::backend.user);
+  return idf_shim::complete(dev, ok);
+}
+
+inline esp_err_t i2c_master_bus_wait_all_done(i2c_master_bus_handle_t bus, int timeoutMs) {
+  (void)bus;
+  (void)timeoutMs;
+  idf_shim::counters.waitAllDone++;
+  return ESP_OK;
+}
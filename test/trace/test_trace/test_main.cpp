@@ -0,0 +1,195 @@
+/// @file test_main.cpp
+/// @brief Trace hooks (ADS1115_TRACE=1) recorded through an application traceSink
+
+#include <unity.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "ADS1115/ADS1115.h"
+#include "ADS1115/Trace.h"
+#include "sim/Ads1115Sim.h"
+
+#if !ADS1115_TRACE
+#error "Build this suite with -DADS1115_TRACE=1 (pio test -e native_trace)"
+#endif
+
+using namespace ADS1115;
+
+SerialClass Serial;
+TwoWire Wire;
+
+namespace {
+
+sim::Device simDevice(0x48);
+sim::Bus simBus;
+ADS1115::ADS1115 device;
+Config config;
+TraceBuffer<256> records;
+
+bool failWrites = false;  ///< Register writes NACK while set
+
+Status flakyWrite(uint8_t addr, const uint8_t* data, size_t len, uint32_t timeoutMs,
+                  void* user) {
+  if (failWrites) {
+    return Status::Error(Err::I2C_ERROR, "NACK");
+  }
+  return sim::i2cWrite(addr, data, len, timeoutMs, user);
+}
+
+/// Index of the first record of @p event at or after @p from, or records.size()
+size_t find(TraceEvent event, size_t from = 0) {
+  for (size_t i = from; i < records.size(); ++i) {
+    if (records[i].event == event) {
+      return i;
+    }
+  }
+  return records.size();
+}
+
+size_t count(TraceEvent event) {
+  size_t n = 0;
+  for (size_t i = 0; i < records.size(); ++i) {
+    n += records[i].event == event ? 1 : 0;
+  }
+  return n;
+}
+
+} // namespace
+
+namespace ADS1115 {
+void traceSink(const TraceRecord& rec) { records.record(rec); }
+} // namespace ADS1115
+
+void setUp() {
+  stub::nowUs = 0;
+  stub::autoAdvanceUs = 5;
+  simDevice.reset();
+  simDevice.setInput(0, 0.0f);
+  failWrites = false;
+  config = Config{};
+  sim::attachTransport(config, simBus);
+  config.i2cWrite = flakyWrite;
+  config.mode = Mode::SINGLE_SHOT;
+  config.dataRate = DataRate::SPS_860;
+  records.clear();
+}
+
+void tearDown() { device.end(); }
+
+void test_begin_traces_state_change_to_ready() {
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  size_t i = find(TraceEvent::STATE_CHANGE);
+  TEST_ASSERT_TRUE(i < records.size());
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(DriverState::READY), records[i].value);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(DriverState::UNINIT), records[i].arg);
+  TEST_ASSERT_EQUAL_UINT8(0x48, records[i].addr);
+}
+
+void test_register_writes_carry_pointer_and_value() {
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  records.clear();
+  TEST_ASSERT_TRUE(device.setThresholds(-1000, 2000).ok());
+
+  bool low = false;
+  bool high = false;
+  for (size_t i = 0; i < records.size(); ++i) {
+    const TraceRecord& rec = records[i];
+    if (rec.event != TraceEvent::REG_WRITE) {
+      continue;
+    }
+    TEST_ASSERT_EQUAL_UINT8(0x48, rec.addr);
+    TEST_ASSERT_EQUAL(Err::OK, rec.err);
+    if (rec.reg == 0x02) {
+      TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(-1000), rec.value);
+      low = true;
+    } else if (rec.reg == 0x03) {
+      TEST_ASSERT_EQUAL_UINT16(2000, rec.value);
+      high = true;
+    }
+  }
+  TEST_ASSERT_TRUE(low);
+  TEST_ASSERT_TRUE(high);
+}
+
+void test_register_read_carries_contents() {
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  records.clear();
+  uint16_t reg = 0;
+  TEST_ASSERT_TRUE(device.readConfig(reg).ok());
+  size_t i = find(TraceEvent::REG_READ);
+  TEST_ASSERT_TRUE(i < records.size());
+  TEST_ASSERT_EQUAL_UINT8(0x01, records[i].reg);
+  TEST_ASSERT_EQUAL_UINT16(reg, records[i].value);
+  TEST_ASSERT_EQUAL(Err::OK, records[i].err);
+}
+
+void test_failed_write_traces_error_and_degraded_state() {
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  records.clear();
+  failWrites = true;
+  TEST_ASSERT_FALSE(device.setThresholds(100, 200).ok());
+
+  size_t w = find(TraceEvent::REG_WRITE);
+  TEST_ASSERT_TRUE(w < records.size());
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, records[w].err);
+  size_t s = find(TraceEvent::STATE_CHANGE, w);
+  TEST_ASSERT_TRUE(s < records.size());
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(DriverState::DEGRADED), records[s].value);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(DriverState::READY), records[s].arg);
+  TEST_ASSERT_EQUAL(Err::I2C_ERROR, records[s].err);
+  TEST_ASSERT_EQUAL(1, count(TraceEvent::STATE_CHANGE));  // Only on transitions
+}
+
+void test_conversion_start_ready_and_sample_in_order() {
+  simDevice.setInput(0, 1.0f);
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  records.clear();
+  TEST_ASSERT_TRUE(device.startConversion().inProgress());
+
+  size_t start = find(TraceEvent::CONVERSION_START);
+  TEST_ASSERT_TRUE(start < records.size());
+  TEST_ASSERT_EQUAL_UINT8(0x01, records[start].reg);
+  TEST_ASSERT_EQUAL_UINT16(simDevice.reg(0x01) & 0x7FFF, records[start].value & 0x7FFF);
+  TEST_ASSERT_TRUE((records[start].value & 0x8000) != 0);  // OS bit starts the conversion
+
+  stub::nowUs += 10000;
+  int16_t raw = 0;
+  TEST_ASSERT_TRUE(device.readRaw(raw).ok());
+
+  size_t ready = find(TraceEvent::CONVERSION_READY, start);
+  TEST_ASSERT_TRUE(ready < records.size());
+  TEST_ASSERT_EQUAL_UINT8(TraceReadySource::OS_POLL, records[ready].arg);
+  size_t sample = find(TraceEvent::SAMPLE, ready);
+  TEST_ASSERT_TRUE(sample < records.size());
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(raw), records[sample].value);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(Mux::AIN0_GND), records[sample].arg);
+  TEST_ASSERT_TRUE(records[sample].timestampUs >= records[start].timestampUs);
+}
+
+void test_notify_traces_ready_source() {
+  // Conversion-ready comparator setup, no pin: the application signals readiness
+  config.compThresholdLow = 0x0000;
+  config.compThresholdHigh = static_cast<int16_t>(0x8000);
+  config.compQueue = ComparatorQueue::ASSERT_1;
+  TEST_ASSERT_TRUE(device.begin(config).ok());
+  TEST_ASSERT_TRUE(device.startConversion().inProgress());
+  records.clear();
+  TEST_ASSERT_TRUE(device.notifyConversionReady());
+  TEST_ASSERT_EQUAL(1, records.size());
+  TEST_ASSERT_EQUAL(TraceEvent::CONVERSION_READY, records[0].event);
+  TEST_ASSERT_EQUAL_UINT8(TraceReadySource::NOTIFY, records[0].arg);
+}
+
+int main() {
+  simBus.attach(&simDevice);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_begin_traces_state_change_to_ready);
+  RUN_TEST(test_register_writes_carry_pointer_and_value);
+  RUN_TEST(test_register_read_carries_contents);
+  RUN_TEST(test_failed_write_traces_error_and_degraded_state);
+  RUN_TEST(test_conversion_start_ready_and_sample_in_order);
+  RUN_TEST(test_notify_traces_ready_source);
+  return UNITY_END();
+}